@@ -49,8 +49,7 @@ CommandLineHandler::CommandLineHandler()
 
     parser().set_default_option_handler(
         &m_filename
-            .set_min_value_count(0)
-            .set_max_value_count(1));
+            .set_min_value_count(0));
 
     parser().add_option_handler(
         &m_configuration
@@ -176,6 +175,33 @@ CommandLineHandler::CommandLineHandler()
             .set_min_value_count(0)
             .set_max_value_count(1));
 
+    parser().add_option_handler(
+        &m_unit_benchmarks_threads
+            .add_name("--unit-benchmarks-threads")
+            .add_name("-ubt")
+            .set_description("also run unit benchmarks on 2, 4... up to this number of threads")
+            .set_exact_value_count(1));
+
+    parser().add_option_handler(
+        &m_unit_benchmarks_counters
+            .add_name("--unit-benchmarks-counters")
+            .add_name("-ubc")
+            .set_description("sample hardware performance counters while unit benchmarking (Linux only)"));
+
+    parser().add_option_handler(
+        &m_unit_benchmarks_baseline
+            .add_name("--unit-benchmarks-baseline")
+            .add_name("-ubb")
+            .set_description("fail unit benchmarks that are slower than in this benchmark results file")
+            .set_exact_value_count(1));
+
+    parser().add_option_handler(
+        &m_unit_benchmarks_threshold
+            .add_name("--unit-benchmarks-threshold")
+            .add_name("-ubth")
+            .set_description("set the allowed slowdown relative to the unit benchmarks baseline (default is 0.1, i.e. 10%)")
+            .set_exact_value_count(1));
+
     parser().add_option_handler(
         &m_verbose_unit_tests
             .add_name("--verbose-unit-tests")
@@ -196,7 +222,8 @@ void CommandLineHandler::print_program_usage(
     logger.set_verbosity_level(LogMessage::Info);
     logger.set_format(LogMessage::Info, "{message}");
 
-    LOG_INFO(logger, "usage: %s [options] project.appleseed", executable_name);
+    LOG_INFO(logger, "usage: %s [options] project.appleseed [project.appleseed ...]", executable_name);
+    LOG_INFO(logger, "multiple projects are rendered as a sequence of frames of the first project.");
     LOG_INFO(logger, "options:");
 
     parser().print_usage(logger);
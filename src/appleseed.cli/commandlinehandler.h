@@ -53,7 +53,7 @@ class CommandLineHandler
   : public shared::CommandLineHandlerBase
 {
   public:
-    // Input file.
+    // Input files. Multiple files are rendered as a sequence of frames.
     foundation::ValueOptionHandler<std::string>     m_filename;
 
     // General options.
@@ -82,6 +82,10 @@ class CommandLineHandler
     // Developer-oriented options.
     foundation::ValueOptionHandler<std::string>     m_run_unit_tests;
     foundation::ValueOptionHandler<std::string>     m_run_unit_benchmarks;
+    foundation::ValueOptionHandler<int>             m_unit_benchmarks_threads;
+    foundation::FlagOptionHandler                   m_unit_benchmarks_counters;
+    foundation::ValueOptionHandler<std::string>     m_unit_benchmarks_baseline;
+    foundation::ValueOptionHandler<double>          m_unit_benchmarks_threshold;
     foundation::FlagOptionHandler                   m_verbose_unit_tests;
     foundation::FlagOptionHandler                   m_benchmark_mode;
 
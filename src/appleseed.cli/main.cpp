@@ -32,6 +32,7 @@
 #include "continuoussavingtilecallback.h"
 #include "houdinitilecallbacks.h"
 #include "progresstilecallback.h"
+#include "projectupdater.h"
 
 // appleseed.renderer headers.
 #include "renderer/api/color.h"
@@ -68,10 +69,13 @@
 #include "boost/filesystem/path.hpp"
 
 // Standard headers.
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
 #include <cstdlib>
 #include <memory>
 #include <string>
+#include <vector>
 
 using namespace appleseed::cli;
 using namespace appleseed::shared;
@@ -180,7 +184,7 @@ namespace
         return result.get_assertion_failure_count() == 0;
     }
 
-    void run_unit_benchmarks()
+    bool run_unit_benchmarks()
     {
         // Configure our logger.
         SaveLogFormatterConfig save_g_logger_config(g_logger);
@@ -217,26 +221,51 @@ namespace
                 xmlfile_path.string().c_str());
         }
 
+        // Configure benchmarking.
+        BenchmarkSettings settings;
+        if (g_cl.m_unit_benchmarks_threads.is_set())
+            settings.m_max_thread_count = max(g_cl.m_unit_benchmarks_threads.value(), 1);
+        settings.m_collect_perf_counters = g_cl.m_unit_benchmarks_counters.is_set();
+        if (g_cl.m_unit_benchmarks_threshold.is_set())
+            settings.m_regression_threshold = g_cl.m_unit_benchmarks_threshold.value();
+
+        // Load the baseline, relatively to the current directory.
+        BenchmarkBaseline baseline;
+        if (g_cl.m_unit_benchmarks_baseline.is_set())
+        {
+            const char* baseline_path = g_cl.m_unit_benchmarks_baseline.value().c_str();
+
+            if (baseline.load(baseline_path))
+                settings.m_baseline = &baseline;
+            else
+            {
+                LOG_ERROR(
+                    g_logger,
+                    "failed to load benchmark baseline %s, disabling regression checks.",
+                    baseline_path);
+            }
+        }
+
         const bf::path old_current_path =
             Application::change_current_directory_to_tests_root_path();
 
         // Run benchmark suites.
         if (g_cl.m_run_unit_benchmarks.values().empty())
-            BenchmarkSuiteRepository::instance().run(result);
+            BenchmarkSuiteRepository::instance().run(result, settings);
         else
         {
             const char* regex = g_cl.m_run_unit_benchmarks.value().c_str();
             const RegExFilter filter(regex, RegExFilter::CaseInsensitive);
 
             if (filter.is_valid())
-                BenchmarkSuiteRepository::instance().run(filter, result);
+                BenchmarkSuiteRepository::instance().run(filter, result, settings);
             else
             {
                 LOG_ERROR(
                     g_logger,
                     "malformed regular expression '%s', disabling benchmark filtering.",
                     regex);
-                BenchmarkSuiteRepository::instance().run(result);
+                BenchmarkSuiteRepository::instance().run(result, settings);
             }
         }
 
@@ -245,6 +274,8 @@ namespace
 
         // Print results.
         print_unit_benchmark_result(result);
+
+        return result.get_case_failure_count() == 0;
     }
 
     void set_frame_parameter(Project& project, const string& key, const string& value)
@@ -454,7 +485,9 @@ namespace
 
 #endif
 
-    auto_release_ptr<Project> load_project(const string& project_filepath)
+    auto_release_ptr<Project> load_project(
+        const string&   project_filepath,
+        const int       options = ProjectFileReader::Defaults)
     {
         // Construct the schema file path.
         const bf::path schema_filepath =
@@ -467,7 +500,8 @@ namespace
         return
             reader.read(
                 project_filepath.c_str(),
-                schema_filepath.string().c_str());
+                schema_filepath.string().c_str(),
+                options);
     }
 
     bool configure_project(Project& project, ParamArray& params)
@@ -511,63 +545,47 @@ namespace
         return value == "progressive";
     }
 
-    bool render(const string& project_filename)
+    ITileCallbackFactory* create_tile_callback_factory(
+        const string&       project_filename,
+        const Project&      project,
+        const ParamArray&   params,
+        const bool          allow_continuous_saving = true)
     {
-        // Load the project.
-        auto_release_ptr<Project> project = load_project(project_filename);
-        if (project.get() == 0)
-            return false;
-
-        // Retrieve the rendering parameters.
-        ParamArray params;
-        if (!configure_project(project.ref(), params))
-            return false;
-
-        // Create the tile callback factory.
-        auto_ptr<ITileCallbackFactory> tile_callback_factory;
         if (g_cl.m_mplay_display.is_set())
         {
-            tile_callback_factory.reset(
+            return
                 new MPlayTileCallbackFactory(
                     project_filename.c_str(),
                     is_progressive_render(params),
-                    g_logger));
+                    g_logger);
         }
         else if (g_cl.m_hrmanpipe_display.is_set())
         {
-            tile_callback_factory.reset(
+            return
                 new HRmanPipeTileCallbackFactory(
                     g_cl.m_hrmanpipe_display.value(),
                     is_progressive_render(params),
-                    g_logger));
+                    g_logger);
         }
-        else if (g_cl.m_output.is_set() && g_cl.m_continuous_saving.is_set())
+        else if (g_cl.m_output.is_set() && g_cl.m_continuous_saving.is_set() && allow_continuous_saving)
         {
-            tile_callback_factory.reset(
+            return
                 new ContinuousSavingTileCallbackFactory(
                     g_cl.m_output.value().c_str(),
-                    g_logger));
+                    g_logger);
         }
-        else if (project->get_display() == 0)
+        else if (project.get_display() == 0)
         {
             // Create a default tile callback if needed.
             if (params.get_optional<string>("frame_renderer", "") != "progressive")
-            {
-                tile_callback_factory.reset(
-                    new ProgressTileCallbackFactory(g_logger));
-            }
+                return new ProgressTileCallbackFactory(g_logger);
         }
 
-        // Create the master renderer.
-        DefaultRendererController renderer_controller;
-        MasterRenderer renderer(
-            project.ref(),
-            params,
-            &renderer_controller,
-            tile_callback_factory.get());
+        return 0;
+    }
 
-        // Render the frame.
-        LOG_INFO(g_logger, "rendering frame...");
+    bool render_frame(MasterRenderer& renderer, const ParamArray& params)
+    {
         Stopwatch<DefaultWallclockTimer> stopwatch;
         if (params.get_optional<bool>("background_mode", true))
         {
@@ -592,6 +610,65 @@ namespace
             "rendering finished in %s.",
             pretty_time(seconds, 3).c_str());
 
+        return true;
+    }
+
+    // Write the frame to the given file, or to the output file of the frame if none is given.
+    void write_frame(const Project& project, const string& output_filename)
+    {
+        const Frame* frame = project.get_frame();
+
+        if (!output_filename.empty())
+        {
+            LOG_INFO(g_logger, "writing frame to disk...");
+            frame->write_main_image(output_filename.c_str());
+            frame->write_aov_images(output_filename.c_str());
+        }
+        else
+        {
+            const string frame_output_filename =
+                frame->get_parameters().get_optional<string>("output_filename");
+
+            if (!frame_output_filename.empty())
+            {
+                LOG_INFO(g_logger, "writing frame to disk...");
+                frame->write_main_image(frame_output_filename.c_str());
+
+                if (frame->get_parameters().get_optional<bool>("output_aovs", false))
+                    frame->write_aov_images(frame_output_filename.c_str());
+            }
+        }
+    }
+
+    bool render(const string& project_filename)
+    {
+        // Load the project.
+        auto_release_ptr<Project> project = load_project(project_filename);
+        if (project.get() == 0)
+            return false;
+
+        // Retrieve the rendering parameters.
+        ParamArray params;
+        if (!configure_project(project.ref(), params))
+            return false;
+
+        // Create the tile callback factory.
+        auto_ptr<ITileCallbackFactory> tile_callback_factory(
+            create_tile_callback_factory(project_filename, project.ref(), params));
+
+        // Create the master renderer.
+        DefaultRendererController renderer_controller;
+        MasterRenderer renderer(
+            project.ref(),
+            params,
+            &renderer_controller,
+            tile_callback_factory.get());
+
+        // Render the frame.
+        LOG_INFO(g_logger, "rendering frame...");
+        if (!render_frame(renderer, params))
+            return false;
+
         // Archive the frame to disk.
         char* archive_path = 0;
         if (params.get_optional<bool>("autosave", true))
@@ -609,27 +686,11 @@ namespace
         }
 
         // Write the frame to disk.
-        if (g_cl.m_output.is_set() && !g_cl.m_continuous_saving.is_set())
-        {
-            LOG_INFO(g_logger, "writing frame to disk...");
-            project->get_frame()->write_main_image(g_cl.m_output.value().c_str());
-            project->get_frame()->write_aov_images(g_cl.m_output.value().c_str());
-        }
-        else
-        {
-            const Frame* frame = project->get_frame();
-            const string output_filename =
-                frame->get_parameters().get_optional<string>("output_filename");
-
-            if (!output_filename.empty())
-            {
-                LOG_INFO(g_logger, "writing frame to disk...");
-                frame->write_main_image(output_filename.c_str());
-
-                if (frame->get_parameters().get_optional<bool>("output_aovs", false))
-                    frame->write_aov_images(output_filename.c_str());
-            }
-        }
+        write_frame(
+            project.ref(),
+            g_cl.m_output.is_set() && !g_cl.m_continuous_saving.is_set()
+                ? g_cl.m_output.value()
+                : string());
 
 #if defined __APPLE__ || defined _WIN32
 
@@ -651,6 +712,124 @@ namespace
         return true;
     }
 
+    // Return the output file name of a given frame of a sequence.
+    string make_sequence_output_filename(const string& output_filename, const size_t frame)
+    {
+        // Number the frames using the '#' characters of the output file name, or before its extension.
+        if (output_filename.find('#') != string::npos)
+            return get_numbered_string(output_filename, frame);
+
+        const bf::path path(output_filename);
+        const string pattern = (path.parent_path() / path.stem()).string() + ".####" + path.extension().string();
+
+        return get_numbered_string(pattern, frame);
+    }
+
+    // Write a given frame of a sequence to disk. Output file names are numbered so that
+    // frames don't overwrite each other.
+    void write_sequence_frame(const Project& project, const size_t frame_number)
+    {
+        if (g_cl.m_output.is_set())
+        {
+            write_frame(project, make_sequence_output_filename(g_cl.m_output.value(), frame_number));
+            return;
+        }
+
+        const Frame* frame = project.get_frame();
+        const string frame_output_filename =
+            frame->get_parameters().get_optional<string>("output_filename");
+
+        if (!frame_output_filename.empty())
+        {
+            const string numbered_output_filename =
+                make_sequence_output_filename(frame_output_filename, frame_number);
+
+            LOG_INFO(g_logger, "writing frame to disk...");
+            frame->write_main_image(numbered_output_filename.c_str());
+
+            if (frame->get_parameters().get_optional<bool>("output_aovs", false))
+                frame->write_aov_images(numbered_output_filename.c_str());
+        }
+    }
+
+    // Render a sequence of frames. The first project is fully loaded and then kept alive
+    // for the whole sequence, along with the master renderer and its OIIO texture system.
+    // Only the differences found in the projects of the next frames are applied to it, so
+    // that the acceleration structures of unchanged assemblies are not rebuilt. The texture
+    // store and the light samplers are still rebuilt for every frame; texture files read
+    // through the OIIO texture system (see the "unified_cache" texture store parameter)
+    // stay cached across frames.
+    bool render_sequence(const vector<string>& project_filenames)
+    {
+        assert(!project_filenames.empty());
+
+        // Load the project of the first frame.
+        auto_release_ptr<Project> project = load_project(project_filenames[0]);
+        if (project.get() == 0)
+            return false;
+
+        // Retrieve the rendering parameters. They are used for the whole sequence.
+        ParamArray params;
+        if (!configure_project(project.ref(), params))
+            return false;
+
+        if (g_cl.m_continuous_saving.is_set())
+            LOG_WARNING(g_logger, "continuous saving is not supported when rendering a sequence of frames.");
+
+        // Create the tile callback factory.
+        auto_ptr<ITileCallbackFactory> tile_callback_factory(
+            create_tile_callback_factory(project_filenames[0], project.ref(), params, false));
+
+        // Create the master renderer.
+        DefaultRendererController renderer_controller;
+        MasterRenderer renderer(
+            project.ref(),
+            params,
+            &renderer_controller,
+            tile_callback_factory.get());
+
+        ProjectUpdater project_updater(project.ref());
+
+        for (size_t i = 0; i < project_filenames.size(); ++i)
+        {
+            if (i > 0)
+            {
+                // Load the project of this frame, without its geometry.
+                auto_release_ptr<Project> frame_project =
+                    load_project(project_filenames[i], ProjectFileReader::OmitReadingMeshFiles);
+                if (frame_project.get() == 0)
+                    return false;
+
+                // Apply the differences with the previous frame.
+                project_updater.update(frame_project.ref());
+                apply_resolution_command_line_option(project.ref());
+                apply_crop_window_command_line_option(project.ref());
+
+                const size_t updated_entity_count = project_updater.get_updated_entity_count();
+                LOG_INFO(
+                    g_logger,
+                    "updated %s %s from %s.",
+                    pretty_uint(updated_entity_count).c_str(),
+                    plural(updated_entity_count, "entity", "entities").c_str(),
+                    project_filenames[i].c_str());
+            }
+
+            // Render the frame.
+            LOG_INFO(
+                g_logger,
+                "rendering frame %s of %s...",
+                pretty_uint(i + 1).c_str(),
+                pretty_uint(project_filenames.size()).c_str());
+            if (!render_frame(renderer, params))
+                return false;
+
+            // Write the frame to disk.
+            write_sequence_frame(project.ref(), i + 1);
+        }
+
+        return true;
+    }
+
     bool benchmark_render(const string& project_filename)
     {
         // Configure our logger.
@@ -756,7 +935,7 @@ int main(int argc, const char* argv[])
 
     // Run unit benchmarks.
     if (g_cl.m_run_unit_benchmarks.is_set())
-        run_unit_benchmarks();
+        success = run_unit_benchmarks() && success;
 
     // Render the specified project.
     if (!g_cl.m_filename.values().empty())
@@ -765,6 +944,8 @@ int main(int argc, const char* argv[])
 
         if (g_cl.m_benchmark_mode.is_set())
             success = success && benchmark_render(project_filename);
+        else if (g_cl.m_filename.values().size() > 1)
+            success = success && render_sequence(g_cl.m_filename.values());
         else success = success && render(project_filename);
     }
 
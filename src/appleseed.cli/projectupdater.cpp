@@ -0,0 +1,338 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "projectupdater.h"
+
+// appleseed.renderer headers.
+#include "renderer/api/camera.h"
+#include "renderer/api/frame.h"
+#include "renderer/api/log.h"
+#include "renderer/api/object.h"
+#include "renderer/api/project.h"
+#include "renderer/api/scene.h"
+#include "renderer/api/utility.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/transform.h"
+#include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/foreach.h"
+#include "foundation/utility/string.h"
+
+// Standard headers.
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+
+namespace appleseed {
+namespace cli {
+
+//
+// ProjectUpdater class implementation.
+//
+
+namespace
+{
+    bool are_equal(const TransformSequence& lhs, const TransformSequence& rhs)
+    {
+        if (lhs.size() != rhs.size())
+            return false;
+
+        for (size_t i = 0, e = lhs.size(); i < e; ++i)
+        {
+            float lhs_time, rhs_time;
+            Transformd lhs_transform, rhs_transform;
+            lhs.get_transform(i, lhs_time, lhs_transform);
+            rhs.get_transform(i, rhs_time, rhs_transform);
+
+            if (lhs_time != rhs_time || lhs_transform != rhs_transform)
+                return false;
+        }
+
+        return true;
+    }
+
+    // Return true if a given object was created from a given (base) object definition.
+    bool is_part_of(const Object& object, const string& base_object_name)
+    {
+        const string name = object.get_name();
+        return name == base_object_name || starts_with(name, base_object_name + ".");
+    }
+}
+
+ProjectUpdater::ProjectUpdater(Project& project)
+  : m_project(project)
+  , m_updated_entity_count(0)
+{
+}
+
+void ProjectUpdater::update(Project& frame_project)
+{
+    m_updated_entity_count = 0;
+
+    update_frame(frame_project);
+
+    Scene* scene = m_project.get_scene();
+    const Scene* frame_scene = frame_project.get_scene();
+
+    if (scene && frame_scene)
+    {
+        update_cameras(*scene, *frame_scene);
+        update_scene(*scene, *frame_scene);
+    }
+}
+
+size_t ProjectUpdater::get_updated_entity_count() const
+{
+    return m_updated_entity_count;
+}
+
+void ProjectUpdater::update_frame(Project& frame_project)
+{
+    const Frame* frame = m_project.get_frame();
+    const Frame* new_frame = frame_project.get_frame();
+
+    if (frame == 0 || new_frame == 0)
+        return;
+
+    if (frame->get_parameters() == new_frame->get_parameters())
+        return;
+
+    // The frame is recreated from its parameters only. This covers all the frame state read
+    // from project files, including the crop window. Other state of the previous frame is not
+    // carried over: its AOV images are recreated by the master renderer at the start of every
+    // render, and crop windows set programmatically must be applied again after the update.
+    m_project.set_frame(
+        FrameFactory::create(
+            new_frame->get_name(),
+            new_frame->get_parameters()));
+
+    ++m_updated_entity_count;
+}
+
+void ProjectUpdater::update_cameras(
+    Scene&                  scene,
+    const Scene&            frame_scene)
+{
+    for (const_each<CameraContainer> i = frame_scene.cameras(); i; ++i)
+    {
+        Camera* camera = scene.cameras().get_by_name(i->get_name());
+        if (camera == 0)
+            continue;
+
+        bool updated = false;
+
+        if (camera->get_parameters() != i->get_parameters())
+        {
+            camera->get_parameters() = i->get_parameters();
+            updated = true;
+        }
+
+        if (!are_equal(camera->transform_sequence(), i->transform_sequence()))
+        {
+            camera->transform_sequence() = i->transform_sequence();
+            updated = true;
+        }
+
+        if (updated)
+        {
+            camera->bump_version_id();
+            ++m_updated_entity_count;
+        }
+    }
+}
+
+void ProjectUpdater::update_scene(
+    Scene&                  scene,
+    const Scene&            frame_scene)
+{
+    for (const_each<AssemblyInstanceContainer> i = frame_scene.assembly_instances(); i; ++i)
+    {
+        AssemblyInstance* assembly_instance = scene.assembly_instances().get_by_name(i->get_name());
+
+        if (assembly_instance && !are_equal(assembly_instance->transform_sequence(), i->transform_sequence()))
+        {
+            assembly_instance->transform_sequence() = i->transform_sequence();
+            assembly_instance->bump_version_id();
+            ++m_updated_entity_count;
+        }
+    }
+
+    for (each<AssemblyContainer> i = frame_scene.assemblies(); i; ++i)
+    {
+        Assembly* assembly = scene.assemblies().get_by_name(i->get_name());
+
+        if (assembly && update_assembly(*assembly, *i))
+            assembly->bump_version_id();
+    }
+}
+
+bool ProjectUpdater::update_assembly(
+    Assembly&               assembly,
+    Assembly&               frame_assembly)
+{
+    bool updated = false;
+
+    for (const_each<AssemblyInstanceContainer> i = frame_assembly.assembly_instances(); i; ++i)
+    {
+        AssemblyInstance* assembly_instance = assembly.assembly_instances().get_by_name(i->get_name());
+
+        if (assembly_instance && !are_equal(assembly_instance->transform_sequence(), i->transform_sequence()))
+        {
+            assembly_instance->transform_sequence() = i->transform_sequence();
+            assembly_instance->bump_version_id();
+            ++m_updated_entity_count;
+            updated = true;
+        }
+    }
+
+    if (update_objects(assembly, frame_assembly))
+        updated = true;
+
+    if (update_object_instances(assembly, frame_assembly))
+        updated = true;
+
+    for (each<AssemblyContainer> i = frame_assembly.assemblies(); i; ++i)
+    {
+        Assembly* child_assembly = assembly.assemblies().get_by_name(i->get_name());
+
+        if (child_assembly && update_assembly(*child_assembly, *i))
+        {
+            child_assembly->bump_version_id();
+            updated = true;
+        }
+    }
+
+    return updated;
+}
+
+bool ProjectUpdater::update_objects(
+    Assembly&               assembly,
+    Assembly&               frame_assembly)
+{
+    // Objects may be moved out of the frame assembly below: collect them first.
+    vector<Object*> frame_objects;
+    for (each<ObjectContainer> i = frame_assembly.objects(); i; ++i)
+        frame_objects.push_back(&*i);
+
+    bool updated = false;
+
+    for (size_t i = 0; i < frame_objects.size(); ++i)
+    {
+        Object& frame_object = *frame_objects[i];
+        const string base_object_name = frame_object.get_name();
+
+        // Collect the objects that were created from this object definition.
+        vector<Object*> objects;
+        for (each<ObjectContainer> j = assembly.objects(); j; ++j)
+        {
+            if (is_part_of(*j, base_object_name))
+                objects.push_back(&*j);
+        }
+
+        // Skip objects that are new or unchanged.
+        if (objects.empty() || objects.front()->get_parameters() == frame_object.get_parameters())
+            continue;
+
+        RENDERER_LOG_DEBUG("reloading object \"%s\"...", base_object_name.c_str());
+
+        vector<Object*> new_objects;
+
+        if (strcmp(frame_object.get_model(), MeshObjectFactory::get_model()) == 0)
+        {
+            // Mesh files of the frame project were not loaded: read them now.
+            MeshObjectArray object_array;
+            if (!MeshObjectReader::read(
+                    m_project.search_paths(),
+                    base_object_name.c_str(),
+                    frame_object.get_parameters(),
+                    object_array))
+                continue;
+
+            for (size_t j = 0; j < object_array.size(); ++j)
+                new_objects.push_back(object_array[j]);
+        }
+        else
+        {
+            // Other objects are fully loaded: take them from the frame project.
+            new_objects.push_back(frame_assembly.objects().remove(&frame_object).release());
+        }
+
+        for (size_t j = 0; j < objects.size(); ++j)
+            assembly.objects().remove(objects[j]);
+
+        for (size_t j = 0; j < new_objects.size(); ++j)
+            assembly.objects().insert(auto_release_ptr<Object>(new_objects[j]));
+
+        m_updated_entity_count += new_objects.size();
+        updated = true;
+    }
+
+    return updated;
+}
+
+bool ProjectUpdater::update_object_instances(
+    Assembly&               assembly,
+    const Assembly&         frame_assembly)
+{
+    bool updated = false;
+
+    for (const_each<ObjectInstanceContainer> i = frame_assembly.object_instances(); i; ++i)
+    {
+        ObjectInstance* object_instance = assembly.object_instances().get_by_name(i->get_name());
+
+        if (object_instance == 0 || object_instance->get_transform() == i->get_transform())
+            continue;
+
+        // Object instances are immutable: replace the instance.
+        auto_release_ptr<ObjectInstance> new_object_instance(
+            ObjectInstanceFactory::create(
+                object_instance->get_name(),
+                object_instance->get_parameters(),
+                object_instance->get_object_name(),
+                i->get_transform(),
+                object_instance->get_front_material_mappings(),
+                object_instance->get_back_material_mappings()));
+
+        assembly.object_instances().remove(object_instance);
+        assembly.object_instances().insert(new_object_instance);
+
+        ++m_updated_entity_count;
+        updated = true;
+    }
+
+    return updated;
+}
+
+}   // namespace cli
+}   // namespace appleseed
@@ -0,0 +1,108 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_CLI_PROJECTUPDATER_H
+#define APPLESEED_CLI_PROJECTUPDATER_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+
+// Standard headers.
+#include <cstddef>
+
+// Forward declarations.
+namespace renderer      { class Assembly; }
+namespace renderer      { class Project; }
+namespace renderer      { class Scene; }
+
+namespace appleseed {
+namespace cli {
+
+//
+// Update a project with the per-frame differences found in another project.
+//
+// This is used to render a sequence of frames without reloading the whole project and
+// rebuilding all acceleration structures at every frame. The frame project is expected
+// to be loaded without its mesh files. Only the following differences are applied:
+//
+//   - frame parameters (the frame is then recreated from its parameters only)
+//   - camera parameters and transforms
+//   - assembly instance transforms
+//   - object instance transforms
+//   - object parameters (for instance the file of a deforming mesh), in which case
+//     the object is reloaded from disk
+//
+// Assemblies whose content changed get a new version ID so that only their trees
+// are rebuilt. Entities that only exist in one of the two projects are ignored.
+//
+
+class ProjectUpdater
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    explicit ProjectUpdater(renderer::Project& project);
+
+    // Apply the differences between the project and a given frame project.
+    void update(renderer::Project& frame_project);
+
+    // Return the number of entities that were updated by the last call to update().
+    size_t get_updated_entity_count() const;
+
+  private:
+    renderer::Project&  m_project;
+    size_t              m_updated_entity_count;
+
+    void update_frame(renderer::Project& frame_project);
+
+    void update_cameras(
+        renderer::Scene&        scene,
+        const renderer::Scene&  frame_scene);
+
+    void update_scene(
+        renderer::Scene&        scene,
+        const renderer::Scene&  frame_scene);
+
+    bool update_assembly(
+        renderer::Assembly&     assembly,
+        renderer::Assembly&     frame_assembly);
+
+    bool update_objects(
+        renderer::Assembly&     assembly,
+        renderer::Assembly&     frame_assembly);
+
+    bool update_object_instances(
+        renderer::Assembly&         assembly,
+        const renderer::Assembly&   frame_assembly);
+};
+
+}       // namespace cli
+}       // namespace appleseed
+
+#endif  // !APPLESEED_CLI_PROJECTUPDATER_H
@@ -156,7 +156,7 @@ void bind_mesh_object()
         .def("reserve_vertex_normals", &MeshObject::reserve_vertex_normals)
         .def("push_vertex_normal", &MeshObject::push_vertex_normal)
         .def("get_vertex_normal_count", &MeshObject::get_vertex_normal_count)
-        .def("get_vertex_normal", &MeshObject::get_vertex_normal, bpy::return_value_policy<bpy::reference_existing_object>())
+        .def("get_vertex_normal", &MeshObject::get_vertex_normal)
 
         .def("reserve_tex_coords", &MeshObject::reserve_tex_coords)
         .def("push_tex_coords", &MeshObject::push_tex_coords)
@@ -63,6 +63,7 @@
 #include "foundation/platform/types.h"
 #include "foundation/utility/containers/dictionary.h"
 #include "foundation/utility/foreach.h"
+#include "foundation/utility/iostreamop.h"
 #include "foundation/utility/log/logmessage.h"
 #include "foundation/utility/path.h"
 #include "foundation/utility/settings.h"
@@ -771,6 +772,12 @@ void MainWindow::add_render_widget(const QString& label)
     connect(
         render_tab, SIGNAL(signal_clear_render_region()),
         SLOT(slot_clear_render_region()));
+    connect(
+        render_tab, SIGNAL(signal_set_focus_region(const QRect&)),
+        SLOT(slot_set_focus_region(const QRect&)));
+    connect(
+        render_tab, SIGNAL(signal_clear_focus_region()),
+        SLOT(slot_clear_focus_region()));
     connect(
         render_tab, SIGNAL(signal_save_all_aovs()),
         SLOT(slot_save_all_aovs()));
@@ -1503,6 +1510,79 @@ void MainWindow::slot_set_render_region(const QRect& rect)
     else m_rendering_manager.reinitialize_rendering();
 }
 
+namespace
+{
+    class ClearFocusRegionAction
+      : public RenderingManager::IStickyAction
+    {
+      public:
+        virtual void operator()(
+            MasterRenderer& master_renderer,
+            Project&        project) APPLESEED_OVERRIDE
+        {
+            master_renderer.get_parameters()
+                .push("progressive_frame_renderer")
+                .strings().remove("focus_region");
+        }
+    };
+
+    class SetFocusRegionAction
+      : public RenderingManager::IStickyAction
+    {
+      public:
+        explicit SetFocusRegionAction(const QRect& rect)
+          : m_rect(rect)
+        {
+        }
+
+        virtual void operator()(
+            MasterRenderer& master_renderer,
+            Project&        project) APPLESEED_OVERRIDE
+        {
+            assert(m_rect.left() >= 0);
+            assert(m_rect.top() >= 0);
+            assert(m_rect.left() <= m_rect.right());
+            assert(m_rect.top() <= m_rect.bottom());
+
+            // The renderer clips the focus region to the crop window.
+            const AABB2u focus_region(
+                Vector2u(
+                    static_cast<size_t>(m_rect.left()),
+                    static_cast<size_t>(m_rect.top())),
+                Vector2u(
+                    static_cast<size_t>(m_rect.right()),
+                    static_cast<size_t>(m_rect.bottom())));
+
+            master_renderer.get_parameters()
+                .push("progressive_frame_renderer")
+                .insert("focus_region", focus_region);
+        }
+
+      private:
+        const QRect m_rect;
+    };
+}
+
+void MainWindow::slot_clear_focus_region()
+{
+    m_rendering_manager.set_sticky_action(
+        "focus_region",
+        auto_ptr<RenderingManager::IStickyAction>(
+            new ClearFocusRegionAction()));
+
+    m_rendering_manager.reinitialize_rendering();
+}
+
+void MainWindow::slot_set_focus_region(const QRect& rect)
+{
+    m_rendering_manager.set_sticky_action(
+        "focus_region",
+        auto_ptr<RenderingManager::IStickyAction>(
+            new SetFocusRegionAction(rect)));
+
+    m_rendering_manager.reinitialize_rendering();
+}
+
 void MainWindow::slot_render_widget_context_menu(const QPoint& point)
 {
     if (!(QApplication::keyboardModifiers() & Qt::ShiftModifier))
@@ -231,6 +231,10 @@ class MainWindow
     void slot_clear_render_region();
     void slot_set_render_region(const QRect& rect);
 
+    // Focus region.
+    void slot_clear_focus_region();
+    void slot_set_focus_region(const QRect& rect);
+
     // Render widget actions.
     void slot_render_widget_context_menu(const QPoint& point);
     void slot_save_frame();
@@ -406,6 +406,12 @@ void RenderTab::recreate_handlers()
     connect(
         m_picking_handler.get(), SIGNAL(signal_entity_picked(renderer::ScenePicker::PickingResult)),
         m_camera_controller.get(), SLOT(slot_entity_picked(renderer::ScenePicker::PickingResult)));
+    connect(
+        m_picking_handler.get(), SIGNAL(signal_focus_region(const QRect&)),
+        SIGNAL(signal_set_focus_region(const QRect&)));
+    connect(
+        m_picking_handler.get(), SIGNAL(signal_clear_focus_region()),
+        SIGNAL(signal_clear_focus_region()));
 
     // Handler for setting render regions with the mouse.
     m_render_region_handler.reset(
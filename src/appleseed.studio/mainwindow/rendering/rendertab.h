@@ -107,6 +107,8 @@ class RenderTab
     void signal_quicksave_all_aovs();
     void signal_set_render_region(const QRect& rect);
     void signal_clear_render_region();
+    void signal_set_focus_region(const QRect& rect);
+    void signal_clear_focus_region();
     void signal_render_widget_context_menu(const QPoint& point);
     void signal_reset_zoom();
     void signal_clear_frame();
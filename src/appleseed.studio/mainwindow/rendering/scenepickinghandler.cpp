@@ -57,11 +57,14 @@
 #include <QEvent>
 #include <QMenu>
 #include <QMouseEvent>
+#include <QPoint>
+#include <QRect>
 #include <QString>
 #include <Qt>
 #include <QWidget>
 
 // Standard headers.
+#include <algorithm>
 #include <cassert>
 #include <ostream>
 #include <sstream>
@@ -149,6 +152,9 @@ bool ScenePickingHandler::eventFilter(QObject* object, QEvent* event)
 
 namespace
 {
+    // Half the size, in pixels, of the focus region set around picked points.
+    const int FocusRegionRadius = 32;
+
     const char* get_primitive_type_name(const ShadingPoint::PrimitiveType primitive_type)
     {
         switch (primitive_type)
@@ -237,6 +243,17 @@ ItemBase* ScenePickingHandler::pick(const QPoint& point)
 
     emit signal_entity_picked(result);
 
+    // Concentrate samples around the picked point, or spread them over the whole frame
+    // again if nothing was picked.
+    if (result.m_hit)
+    {
+        emit signal_focus_region(
+            QRect(
+                QPoint(max(pix.x - FocusRegionRadius, 0), max(pix.y - FocusRegionRadius, 0)),
+                QPoint(pix.x + FocusRegionRadius, pix.y + FocusRegionRadius)));
+    }
+    else emit signal_clear_focus_region();
+
     const QString picking_mode =
         m_picking_mode_combo->itemData(m_picking_mode_combo->currentIndex()).value<QString>();
     const Entity* picked_entity = get_picked_entity(result, picking_mode);
@@ -48,6 +48,7 @@ namespace renderer  { class Project; }
 class QComboBox;
 class QEvent;
 class QPoint;
+class QRect;
 class QWidget;
 
 Q_DECLARE_METATYPE(renderer::ScenePicker::PickingResult);
@@ -74,6 +75,8 @@ class ScenePickingHandler
 
   signals:
     void signal_entity_picked(renderer::ScenePicker::PickingResult result);
+    void signal_focus_region(const QRect& rect);
+    void signal_clear_focus_region();
 
   private:
     QWidget*                                m_widget;
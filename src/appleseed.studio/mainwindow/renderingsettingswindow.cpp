@@ -1113,6 +1113,7 @@ namespace
             tile_ordering->addItem("Spiral", "spiral");
             tile_ordering->addItem("Hilbert", "hilbert");
             tile_ordering->addItem("Random", "random");
+            tile_ordering->addItem("Cost", "cost");
             groupbox->setLayout(create_form_layout("Tile Ordering:", tile_ordering));
         }
     };
@@ -305,6 +305,48 @@ Color3f faster_linear_rgb_to_srgb(const Color3f& linear_rgb);
 Color3f faster_srgb_to_linear_rgb(const Color3f& srgb);
 
 
+//
+// Linear RGB <-> Rec. 709 transformations.
+//
+// Reference:
+//
+//   http://en.wikipedia.org/wiki/Rec._709#Transfer_characteristics
+//
+
+// Convert a color component from the linear RGB color space to the Rec. 709 color space.
+template <typename T>
+T linear_rgb_to_rec709(const T c);
+
+// Convert a color component from the Rec. 709 color space to the linear RGB color space.
+template <typename T>
+T rec709_to_linear_rgb(const T c);
+
+// Variants of the above functions using a fast approximation of the power function.
+float fast_linear_rgb_to_rec709(const float c);
+float fast_rec709_to_linear_rgb(const float c);
+#ifdef APPLESEED_USE_SSE
+inline __m128 fast_linear_rgb_to_rec709(const __m128 linear_rgb);
+#endif
+
+
+//
+// Batch transformations of arrays of RGBA pixels.
+//
+// These functions process the pixels in place and leave the alpha channel unchanged.
+// The pixels don't need to be aligned.
+//
+
+// Apply the sRGB or the Rec. 709 transfer function using a fast approximation of the power function.
+void fast_linear_rgb_to_srgb(Color4f pixels[], const size_t pixel_count);
+void fast_linear_rgb_to_rec709(Color4f pixels[], const size_t pixel_count);
+
+// Multiply the color channels by the alpha channel.
+void premultiply_alpha(Color4f pixels[], const size_t pixel_count);
+
+// Divide the color channels by the alpha channel. Pixels with zero alpha become black.
+void unpremultiply_alpha(Color4f pixels[], const size_t pixel_count);
+
+
 //
 // Compute the relative luminance of a linear RGB triplet as defined
 // in the ITU-R Recommendation BT.709 (Rec. 709):
@@ -797,6 +839,163 @@ inline Color3f faster_srgb_to_linear_rgb(const Color3f& srgb)
 }
 
 
+//
+// Linear RGB <-> Rec. 709 transformations implementation.
+//
+
+template <typename T>
+inline T linear_rgb_to_rec709(const T c)
+{
+    return c < T(0.018)
+        ? T(4.5) * c
+        : T(1.099) * std::pow(c, T(0.45)) - T(0.099);
+}
+
+template <typename T>
+inline T rec709_to_linear_rgb(const T c)
+{
+    return c < T(0.081)
+        ? T(1.0 / 4.5) * c
+        : std::pow((c + T(0.099)) * T(1.0 / 1.099), T(1.0 / 0.45));
+}
+
+inline float fast_linear_rgb_to_rec709(const float c)
+{
+    return c < 0.018f
+        ? 4.5f * c
+        : 1.099f * fast_pow(c, 0.45f) - 0.099f;
+}
+
+inline float fast_rec709_to_linear_rgb(const float c)
+{
+    return c < 0.081f
+        ? (1.0f / 4.5f) * c
+        : fast_pow((c + 0.099f) * (1.0f / 1.099f), 1.0f / 0.45f);
+}
+
+#ifdef APPLESEED_USE_SSE
+
+inline __m128 fast_linear_rgb_to_rec709(const __m128 linear_rgb)
+{
+    // Apply 0.45 gamma correction.
+    const __m128 y = fast_pow(linear_rgb, _mm_set1_ps(0.45f));
+
+    // Compute both outcomes of the branch.
+    const __m128 a = _mm_mul_ps(_mm_set1_ps(4.5f), linear_rgb);
+    const __m128 b = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(1.099f), y), _mm_set1_ps(0.099f));
+
+    // Interleave them based on the comparison result.
+    const __m128 mask = _mm_cmplt_ps(linear_rgb, _mm_set1_ps(0.018f));
+    return _mm_add_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+#endif  // APPLESEED_USE_SSE
+
+
+//
+// Batch transformations of arrays of RGBA pixels implementation.
+//
+
+#ifdef APPLESEED_USE_SSE
+
+namespace colorspace_impl
+{
+    // Return the color channels of a and the alpha channel of b.
+    inline __m128 merge_rgb_alpha(const __m128 a, const __m128 b)
+    {
+        return _mm_shuffle_ps(a, _mm_unpackhi_ps(a, b), _MM_SHUFFLE(3, 0, 1, 0));
+    }
+}
+
+inline void fast_linear_rgb_to_srgb(Color4f pixels[], const size_t pixel_count)
+{
+    float* ptr = reinterpret_cast<float*>(pixels);
+
+    for (size_t i = 0; i < pixel_count; ++i, ptr += 4)
+    {
+        const __m128 color = _mm_loadu_ps(ptr);
+        _mm_storeu_ps(ptr, colorspace_impl::merge_rgb_alpha(fast_linear_rgb_to_srgb(color), color));
+    }
+}
+
+inline void fast_linear_rgb_to_rec709(Color4f pixels[], const size_t pixel_count)
+{
+    float* ptr = reinterpret_cast<float*>(pixels);
+
+    for (size_t i = 0; i < pixel_count; ++i, ptr += 4)
+    {
+        const __m128 color = _mm_loadu_ps(ptr);
+        _mm_storeu_ps(ptr, colorspace_impl::merge_rgb_alpha(fast_linear_rgb_to_rec709(color), color));
+    }
+}
+
+inline void premultiply_alpha(Color4f pixels[], const size_t pixel_count)
+{
+    float* ptr = reinterpret_cast<float*>(pixels);
+
+    for (size_t i = 0; i < pixel_count; ++i, ptr += 4)
+    {
+        const __m128 color = _mm_loadu_ps(ptr);
+        const __m128 alpha = _mm_shuffle_ps(color, color, _MM_SHUFFLE(3, 3, 3, 3));
+        _mm_storeu_ps(ptr, colorspace_impl::merge_rgb_alpha(_mm_mul_ps(color, alpha), color));
+    }
+}
+
+inline void unpremultiply_alpha(Color4f pixels[], const size_t pixel_count)
+{
+    float* ptr = reinterpret_cast<float*>(pixels);
+
+    for (size_t i = 0; i < pixel_count; ++i, ptr += 4)
+    {
+        const __m128 color = _mm_loadu_ps(ptr);
+        const __m128 alpha = _mm_shuffle_ps(color, color, _MM_SHUFFLE(3, 3, 3, 3));
+
+        // Compute 1 / alpha, or 0 where alpha is 0.
+        const __m128 rcp_alpha =
+            _mm_and_ps(
+                _mm_cmpneq_ps(alpha, _mm_setzero_ps()),
+                _mm_div_ps(_mm_set1_ps(1.0f), alpha));
+
+        _mm_storeu_ps(ptr, colorspace_impl::merge_rgb_alpha(_mm_mul_ps(color, rcp_alpha), color));
+    }
+}
+
+#else
+
+inline void fast_linear_rgb_to_srgb(Color4f pixels[], const size_t pixel_count)
+{
+    for (size_t i = 0; i < pixel_count; ++i)
+        pixels[i].rgb() = fast_linear_rgb_to_srgb(pixels[i].rgb());
+}
+
+inline void fast_linear_rgb_to_rec709(Color4f pixels[], const size_t pixel_count)
+{
+    for (size_t i = 0; i < pixel_count; ++i)
+    {
+        pixels[i][0] = fast_linear_rgb_to_rec709(pixels[i][0]);
+        pixels[i][1] = fast_linear_rgb_to_rec709(pixels[i][1]);
+        pixels[i][2] = fast_linear_rgb_to_rec709(pixels[i][2]);
+    }
+}
+
+inline void premultiply_alpha(Color4f pixels[], const size_t pixel_count)
+{
+    for (size_t i = 0; i < pixel_count; ++i)
+        pixels[i].rgb() *= pixels[i].a;
+}
+
+inline void unpremultiply_alpha(Color4f pixels[], const size_t pixel_count)
+{
+    for (size_t i = 0; i < pixel_count; ++i)
+    {
+        const float rcp_alpha = pixels[i].a == 0.0f ? 0.0f : 1.0f / pixels[i].a;
+        pixels[i].rgb() *= rcp_alpha;
+    }
+}
+
+#endif  // APPLESEED_USE_SSE
+
+
 //
 // Relative luminance function implementation.
 //
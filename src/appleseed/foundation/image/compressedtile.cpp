@@ -0,0 +1,89 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "compressedtile.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/tile.h"
+#include "foundation/platform/compiler.h"
+
+// lz4 headers.
+#include "lz4.h"
+
+// Standard headers.
+#include <cassert>
+
+namespace foundation
+{
+
+//
+// CompressedTile class implementation.
+//
+
+CompressedTile::CompressedTile(const Tile& tile)
+  : m_width(tile.get_width())
+  , m_height(tile.get_height())
+  , m_channel_count(tile.get_channel_count())
+  , m_pixel_format(tile.get_pixel_format())
+  , m_size(tile.get_size())
+{
+    std::vector<uint8> buffer(static_cast<size_t>(LZ4_compressBound(static_cast<int>(m_size))));
+
+    const int compressed_size =
+        LZ4_compress(
+            reinterpret_cast<const char*>(tile.get_storage()),
+            reinterpret_cast<char*>(&buffer[0]),
+            static_cast<int>(m_size));
+    assert(compressed_size > 0);
+
+    // Only keep as much memory as the compressed pixels need.
+    m_data.assign(buffer.begin(), buffer.begin() + compressed_size);
+}
+
+Tile* CompressedTile::decompress() const
+{
+    Tile* tile =
+        new Tile(
+            m_width,
+            m_height,
+            m_channel_count,
+            m_pixel_format);
+
+    APPLESEED_UNUSED const int read_size =
+        LZ4_decompress_fast(
+            reinterpret_cast<const char*>(&m_data[0]),
+            reinterpret_cast<char*>(tile->get_storage()),
+            static_cast<int>(m_size));
+    assert(read_size == static_cast<int>(m_data.size()));
+
+    return tile;
+}
+
+}   // namespace foundation
@@ -0,0 +1,123 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_FOUNDATION_IMAGE_COMPRESSEDTILE_H
+#define APPLESEED_FOUNDATION_IMAGE_COMPRESSEDTILE_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/image/pixel.h"
+#include "foundation/platform/types.h"
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
+// Forward declarations.
+namespace foundation    { class Tile; }
+
+namespace foundation
+{
+
+//
+// A tile whose pixels are kept in memory in LZ4-compressed form.
+//
+
+class APPLESEED_DLLSYMBOL CompressedTile
+  : public NonCopyable
+{
+  public:
+    // Construct a compressed copy of a given tile.
+    explicit CompressedTile(const Tile& tile);
+
+    // Return the size (in bytes) of this object in memory.
+    size_t get_memory_size() const;
+
+    // Return the size (in bytes) of the compressed pixel array.
+    size_t get_compressed_size() const;
+
+    // Tile properties.
+    PixelFormat get_pixel_format() const;
+    size_t get_width() const;
+    size_t get_height() const;
+    size_t get_channel_count() const;
+
+    // Decompress the tile into a new tile. The caller takes ownership of the returned tile.
+    Tile* decompress() const;
+
+  private:
+    const size_t        m_width;
+    const size_t        m_height;
+    const size_t        m_channel_count;
+    const PixelFormat   m_pixel_format;
+    const size_t        m_size;
+    std::vector<uint8>  m_data;
+};
+
+
+//
+// CompressedTile class implementation.
+//
+
+inline size_t CompressedTile::get_memory_size() const
+{
+    return sizeof(*this) + m_data.capacity();
+}
+
+inline size_t CompressedTile::get_compressed_size() const
+{
+    return m_data.size();
+}
+
+inline PixelFormat CompressedTile::get_pixel_format() const
+{
+    return m_pixel_format;
+}
+
+inline size_t CompressedTile::get_width() const
+{
+    return m_width;
+}
+
+inline size_t CompressedTile::get_height() const
+{
+    return m_height;
+}
+
+inline size_t CompressedTile::get_channel_count() const
+{
+    return m_channel_count;
+}
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_IMAGE_COMPRESSEDTILE_H
@@ -60,6 +60,28 @@ void Pixel::convert_and_shuffle(
     void*               dest,
     const size_t*       shuffle_table)
 {
+    // Convert all channels at once when the channel shuffling table is the identity.
+    if (dest_channels == src_channels)
+    {
+        size_t i = 0;
+
+        while (i < src_channels && shuffle_table[i] == i)
+            ++i;
+
+        if (i == src_channels)
+        {
+            convert(
+                src_format,
+                src_begin,
+                src_end,
+                1,
+                dest_format,
+                dest,
+                1);
+            return;
+        }
+    }
+
     // Compute size in bytes of source and destination pixel formats.
     const size_t src_channel_size = size(src_format);
     const size_t dest_channel_size = size(dest_format);
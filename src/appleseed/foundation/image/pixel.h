@@ -33,6 +33,9 @@
 // appleseed.foundation headers.
 #include "foundation/math/scalar.h"
 #include "foundation/platform/types.h"
+#ifdef APPLESEED_USE_SSE
+#include "foundation/platform/sse.h"
+#endif
 #include "foundation/utility/otherwise.h"
 
 // appleseed.main headers.
@@ -47,6 +50,7 @@ END_EXR_INCLUDES
 // Standard headers.
 #include <cassert>
 #include <cstddef>
+#include <cstring>
 
 namespace foundation
 {
@@ -171,6 +175,188 @@ class Pixel
 };
 
 
+//
+// SIMD kernels converting contiguous arrays of values between the most common pixel formats.
+//
+// Each kernel converts the longest prefix of the input whose length is a multiple of the
+// SIMD width and returns the length of that prefix; the caller converts the remaining values.
+// The results are identical to those of the scalar conversions in the Pixel class. Kernels
+// return zero when the required instruction set is not available.
+//
+
+namespace pixel_impl
+{
+    size_t convert_float_to_uint8(const float* src, const size_t count, uint8* dest);
+    size_t convert_float_to_uint16(const float* src, const size_t count, uint16* dest);
+    size_t convert_float_to_half(const float* src, const size_t count, half* dest);
+    size_t convert_uint8_to_float(const uint8* src, const size_t count, float* dest);
+    size_t convert_uint16_to_float(const uint16* src, const size_t count, float* dest);
+    size_t convert_half_to_float(const half* src, const size_t count, float* dest);
+}
+
+
+//
+// SIMD kernels implementation.
+//
+
+namespace pixel_impl
+{
+
+#ifdef APPLESEED_USE_SSE
+
+inline size_t convert_float_to_uint8(const float* src, const size_t count, uint8* dest)
+{
+    const size_t n = count & ~size_t(3);
+
+    for (size_t i = 0; i < n; i += 4)
+    {
+        // Scale, clamp and truncate to 32-bit integers.
+        __m128 x = _mm_mul_ps(_mm_loadu_ps(src + i), _mm_set1_ps(256.0f));
+        x = _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+        __m128i v = _mm_cvttps_epi32(x);
+
+        // Narrow to 8-bit integers (values are already in [0, 255]).
+        v = _mm_packs_epi32(v, v);
+        v = _mm_packus_epi16(v, v);
+
+        const int32 packed = _mm_cvtsi128_si32(v);
+        std::memcpy(dest + i, &packed, sizeof(packed));
+    }
+
+    return n;
+}
+
+inline size_t convert_float_to_uint16(const float* src, const size_t count, uint16* dest)
+{
+    const size_t n = count & ~size_t(3);
+
+    for (size_t i = 0; i < n; i += 4)
+    {
+        // Scale, clamp and truncate to 32-bit integers.
+        __m128 x = _mm_mul_ps(_mm_loadu_ps(src + i), _mm_set1_ps(65536.0f));
+        x = _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set1_ps(65535.0f));
+        __m128i v = _mm_cvttps_epi32(x);
+
+        // Narrow to unsigned 16-bit integers. SSE2 only has a signed saturating pack,
+        // so bias the values into the signed range and flip the sign bit back.
+        v = _mm_sub_epi32(v, _mm_set1_epi32(32768));
+        v = _mm_packs_epi32(v, v);
+        v = _mm_xor_si128(v, _mm_set1_epi16(static_cast<int16>(0x8000)));
+
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dest + i), v);
+    }
+
+    return n;
+}
+
+inline size_t convert_uint8_to_float(const uint8* src, const size_t count, float* dest)
+{
+    const size_t n = count & ~size_t(3);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (size_t i = 0; i < n; i += 4)
+    {
+        int32 packed;
+        std::memcpy(&packed, src + i, sizeof(packed));
+
+        // Widen to 32-bit integers.
+        __m128i v = _mm_cvtsi32_si128(packed);
+        v = _mm_unpacklo_epi8(v, zero);
+        v = _mm_unpacklo_epi16(v, zero);
+
+        _mm_storeu_ps(dest + i, _mm_mul_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(1.0f / 255)));
+    }
+
+    return n;
+}
+
+inline size_t convert_uint16_to_float(const uint16* src, const size_t count, float* dest)
+{
+    const size_t n = count & ~size_t(3);
+
+    for (size_t i = 0; i < n; i += 4)
+    {
+        // Widen to 32-bit integers.
+        __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+        v = _mm_unpacklo_epi16(v, _mm_setzero_si128());
+
+        _mm_storeu_ps(dest + i, _mm_mul_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(1.0f / 65535)));
+    }
+
+    return n;
+}
+
+#else
+
+inline size_t convert_float_to_uint8(const float* src, const size_t count, uint8* dest)
+{
+    return 0;
+}
+
+inline size_t convert_float_to_uint16(const float* src, const size_t count, uint16* dest)
+{
+    return 0;
+}
+
+inline size_t convert_uint8_to_float(const uint8* src, const size_t count, float* dest)
+{
+    return 0;
+}
+
+inline size_t convert_uint16_to_float(const uint16* src, const size_t count, float* dest)
+{
+    return 0;
+}
+
+#endif  // APPLESEED_USE_SSE
+
+// F16C instructions are only enabled alongside AVX2.
+#ifdef APPLESEED_USE_AVX2
+
+inline size_t convert_float_to_half(const float* src, const size_t count, half* dest)
+{
+    const size_t n = count & ~size_t(3);
+
+    for (size_t i = 0; i < n; i += 4)
+    {
+        // Round to nearest even, like the half(float) constructor.
+        const __m128i v = _mm_cvtps_ph(_mm_loadu_ps(src + i), 0);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dest + i), v);
+    }
+
+    return n;
+}
+
+inline size_t convert_half_to_float(const half* src, const size_t count, float* dest)
+{
+    const size_t n = count & ~size_t(3);
+
+    for (size_t i = 0; i < n; i += 4)
+    {
+        const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_ps(dest + i, _mm_cvtph_ps(v));
+    }
+
+    return n;
+}
+
+#else
+
+inline size_t convert_float_to_half(const float* src, const size_t count, half* dest)
+{
+    return 0;
+}
+
+inline size_t convert_half_to_float(const half* src, const size_t count, float* dest)
+{
+    return 0;
+}
+
+#endif  // APPLESEED_USE_AVX2
+
+}   // namespace pixel_impl
+
+
 //
 // Pixel class implementation.
 //
@@ -253,7 +439,14 @@ inline void Pixel::convert_to_format<uint8>(
       case PixelFormatFloat:                // lossless uint8 -> float
         {
             float* typed_dest = reinterpret_cast<float*>(dest);
-            for (const uint8* it = src_begin; it < src_end; it += src_stride)
+            const uint8* it = src_begin;
+            if (src_stride == 1 && dest_stride == 1)
+            {
+                const size_t n = pixel_impl::convert_uint8_to_float(it, src_end - it, typed_dest);
+                it += n;
+                typed_dest += n;
+            }
+            for (; it < src_end; it += src_stride)
             {
                 *typed_dest = static_cast<float>(*it) * (1.0f / 255);
                 typed_dest += dest_stride;
@@ -338,7 +531,14 @@ inline void Pixel::convert_to_format<uint16>(
       case PixelFormatFloat:                // lossless uint16 -> float
         {
             float* typed_dest = reinterpret_cast<float*>(dest);
-            for (const uint16* it = src_begin; it < src_end; it += src_stride)
+            const uint16* it = src_begin;
+            if (src_stride == 1 && dest_stride == 1)
+            {
+                const size_t n = pixel_impl::convert_uint16_to_float(it, src_end - it, typed_dest);
+                it += n;
+                typed_dest += n;
+            }
+            for (; it < src_end; it += src_stride)
             {
                 *typed_dest = static_cast<float>(*it) * (1.0f / 65535);
                 typed_dest += dest_stride;
@@ -511,7 +711,14 @@ inline void Pixel::convert_to_format<half>(
       case PixelFormatFloat:                // lossless half -> float
         {
             float* typed_dest = reinterpret_cast<float*>(dest);
-            for (const half* it = src_begin; it < src_end; it += src_stride)
+            const half* it = src_begin;
+            if (src_stride == 1 && dest_stride == 1)
+            {
+                const size_t n = pixel_impl::convert_half_to_float(it, src_end - it, typed_dest);
+                it += n;
+                typed_dest += n;
+            }
+            for (; it < src_end; it += src_stride)
             {
                 *typed_dest = static_cast<float>(*it);
                 typed_dest += dest_stride;
@@ -551,9 +758,15 @@ inline void Pixel::convert_to_format<float>(
     {
       case PixelFormatUInt8:                // lossy float -> uint8
         {
-            // todo: optimize this case using SSE?
             uint8* typed_dest = reinterpret_cast<uint8*>(dest);
-            for (const float* it = src_begin; it < src_end; it += src_stride)
+            const float* it = src_begin;
+            if (src_stride == 1 && dest_stride == 1)
+            {
+                const size_t n = pixel_impl::convert_float_to_uint8(it, src_end - it, typed_dest);
+                it += n;
+                typed_dest += n;
+            }
+            for (; it < src_end; it += src_stride)
             {
                 const float val = clamp(*it * 256.0f, 0.0f, 255.0f);
                 *typed_dest = truncate<uint8>(val);
@@ -565,7 +778,14 @@ inline void Pixel::convert_to_format<float>(
       case PixelFormatUInt16:               // lossy float -> uint16
         {
             uint16* typed_dest = reinterpret_cast<uint16*>(dest);
-            for (const float* it = src_begin; it < src_end; it += src_stride)
+            const float* it = src_begin;
+            if (src_stride == 1 && dest_stride == 1)
+            {
+                const size_t n = pixel_impl::convert_float_to_uint16(it, src_end - it, typed_dest);
+                it += n;
+                typed_dest += n;
+            }
+            for (; it < src_end; it += src_stride)
             {
                 const float val = clamp(*it * 65536.0f, 0.0f, 65535.0f);
                 *typed_dest = truncate<uint16>(val);
@@ -589,7 +809,14 @@ inline void Pixel::convert_to_format<float>(
       case PixelFormatHalf:                 // lossy float -> half
         {
             half* typed_dest = reinterpret_cast<half*>(dest);
-            for (const float* it = src_begin; it < src_end; it += src_stride)
+            const float* it = src_begin;
+            if (src_stride == 1 && dest_stride == 1)
+            {
+                const size_t n = pixel_impl::convert_float_to_half(it, src_end - it, typed_dest);
+                it += n;
+                typed_dest += n;
+            }
+            for (; it < src_end; it += src_stride)
             {
                 *typed_dest = static_cast<half>(*it);
                 typed_dest += dest_stride;
@@ -774,6 +1001,12 @@ inline void Pixel::convert_from_format<uint8>(
       case PixelFormatFloat:                // lossy float -> uint8
         {
             const float* it = reinterpret_cast<const float*>(src_begin);
+            if (src_stride == 1 && dest_stride == 1)
+            {
+                const size_t n = pixel_impl::convert_float_to_uint8(it, reinterpret_cast<const float*>(src_end) - it, dest);
+                it += n;
+                dest += n;
+            }
             for (; it < reinterpret_cast<const float*>(src_end); it += src_stride)
             {
                 const float val = clamp(*it * 256.0f, 0.0f, 255.0f);
@@ -862,6 +1095,12 @@ inline void Pixel::convert_from_format<uint16>(
       case PixelFormatFloat:                // lossy float -> uint16
         {
             const float* it = reinterpret_cast<const float*>(src_begin);
+            if (src_stride == 1 && dest_stride == 1)
+            {
+                const size_t n = pixel_impl::convert_float_to_uint16(it, reinterpret_cast<const float*>(src_end) - it, dest);
+                it += n;
+                dest += n;
+            }
             for (; it < reinterpret_cast<const float*>(src_end); it += src_stride)
             {
                 const float val = clamp(*it * 65536.0f, 0.0f, 65535.0f);
@@ -993,6 +1232,12 @@ inline void Pixel::convert_from_format<float>(
       case PixelFormatUInt8:                // lossless uint8 -> float
         {
             const uint8* it = reinterpret_cast<const uint8*>(src_begin);
+            if (src_stride == 1 && dest_stride == 1)
+            {
+                const size_t n = pixel_impl::convert_uint8_to_float(it, reinterpret_cast<const uint8*>(src_end) - it, dest);
+                it += n;
+                dest += n;
+            }
             for (; it < reinterpret_cast<const uint8*>(src_end); it += src_stride)
             {
                 *dest = static_cast<float>(*it) * (1.0f / 255);
@@ -1004,6 +1249,12 @@ inline void Pixel::convert_from_format<float>(
       case PixelFormatUInt16:               // lossless uint16 -> float
         {
             const uint16* it = reinterpret_cast<const uint16*>(src_begin);
+            if (src_stride == 1 && dest_stride == 1)
+            {
+                const size_t n = pixel_impl::convert_uint16_to_float(it, reinterpret_cast<const uint16*>(src_end) - it, dest);
+                it += n;
+                dest += n;
+            }
             for (; it < reinterpret_cast<const uint16*>(src_end); it += src_stride)
             {
                 *dest = static_cast<float>(*it) * (1.0f / 65535);
@@ -1026,6 +1277,12 @@ inline void Pixel::convert_from_format<float>(
       case PixelFormatHalf:                 // lossless half -> float
         {
             const half* it = reinterpret_cast<const half*>(src_begin);
+            if (src_stride == 1 && dest_stride == 1)
+            {
+                const size_t n = pixel_impl::convert_half_to_float(it, reinterpret_cast<const half*>(src_end) - it, dest);
+                it += n;
+                dest += n;
+            }
             for (; it < reinterpret_cast<const half*>(src_end); it += src_stride)
             {
                 *dest = static_cast<float>(*it);
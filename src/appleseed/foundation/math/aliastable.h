@@ -0,0 +1,253 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_FOUNDATION_MATH_ALIASTABLE_H
+#define APPLESEED_FOUNDATION_MATH_ALIASTABLE_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/math/scalar.h"
+#include "foundation/platform/types.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace foundation
+{
+
+//
+// Alias table for sampling a discrete distribution in constant time.
+//
+// This class is a drop-in replacement for foundation::CDF: it offers the same
+// interface, but sample() does not perform any search. Sampling is no longer
+// monotonic in x though: consecutive values of x may map to distant items.
+//
+// Since x is used both to select a bucket and to choose between the bucket's
+// item and its alias, double precision samples should be used for very large
+// tables.
+//
+// Reference:
+//
+//   Darts, Dice, and Coins: Sampling from a Discrete Distribution
+//   http://www.keithschwarz.com/darts-dice-coins/
+//
+
+template <typename Item, typename Weight>
+class AliasTable
+  : public NonCopyable
+{
+  public:
+    typedef std::pair<Item, Weight> ItemWeightPair;
+
+    // Constructor.
+    AliasTable();
+
+    // Return true if the table is empty.
+    bool empty() const;
+
+    // Return true if the table has at least one item with a positive weight.
+    bool valid() const;
+
+    // Return the sum of the weight of all inserted items.
+    Weight weight() const;
+
+    // Remove all items from the table.
+    void clear();
+
+    // Allocate memory for a given number of items.
+    void reserve(const size_t count);
+
+    // Insert an item with a given non-negative weight.
+    void insert(const Item& item, const Weight weight);
+
+    // Access the i'th item.
+    const ItemWeightPair& operator[](const size_t i) const;
+
+    // Prepare the table for sampling.
+    // This method must be called once and only once before sample() is called.
+    void prepare();
+
+    // Sample the table. x is in [0,1).
+    const ItemWeightPair& sample(const Weight x) const;
+
+  private:
+    struct Bucket
+    {
+        Weight  m_threshold;                // probability of returning the bucket's own item
+        uint32  m_alias;                    // index of the item returned otherwise
+    };
+
+    typedef std::vector<ItemWeightPair> ItemVector;
+    typedef std::vector<Bucket> BucketVector;
+
+    ItemVector          m_items;
+    Weight              m_weight_sum;
+    BucketVector        m_buckets;
+};
+
+
+//
+// AliasTable class implementation.
+//
+
+template <typename Item, typename Weight>
+inline AliasTable<Item, Weight>::AliasTable()
+  : m_weight_sum(0.0)
+{
+}
+
+template <typename Item, typename Weight>
+inline bool AliasTable<Item, Weight>::empty() const
+{
+    return m_items.empty();
+}
+
+template <typename Item, typename Weight>
+inline bool AliasTable<Item, Weight>::valid() const
+{
+    return m_weight_sum > Weight(0.0);
+}
+
+template <typename Item, typename Weight>
+inline Weight AliasTable<Item, Weight>::weight() const
+{
+    return m_weight_sum;
+}
+
+template <typename Item, typename Weight>
+inline void AliasTable<Item, Weight>::clear()
+{
+    m_items.clear();
+    m_weight_sum = Weight(0.0);
+    m_buckets.clear();
+}
+
+template <typename Item, typename Weight>
+inline void AliasTable<Item, Weight>::reserve(const size_t count)
+{
+    m_items.reserve(count);
+}
+
+template <typename Item, typename Weight>
+inline void AliasTable<Item, Weight>::insert(const Item& item, const Weight weight)
+{
+    assert(weight >= Weight(0.0));
+    m_items.push_back(std::make_pair(item, weight));
+    m_weight_sum += weight;
+}
+
+template <typename Item, typename Weight>
+inline const std::pair<Item, Weight>& AliasTable<Item, Weight>::operator[](const size_t i) const
+{
+    assert(i < m_items.size());
+    return m_items[i];
+}
+
+template <typename Item, typename Weight>
+void AliasTable<Item, Weight>::prepare()
+{
+    assert(valid());
+
+    const size_t item_count = m_items.size();
+    assert(item_count <= ~uint32(0));
+
+    // Normalize weights so that they add up to 1.0.
+    const Weight rcp_weight_sum = Weight(1.0) / m_weight_sum;
+    for (size_t i = 0; i < item_count; ++i)
+        m_items[i].second *= rcp_weight_sum;
+
+    // Scale weights so that they average to 1.0 and split items into those
+    // that underfill their bucket and those that overfill it.
+    std::vector<Weight> scaled(item_count);
+    std::vector<uint32> small, large;
+    uint32 heaviest = 0;
+    for (size_t i = 0; i < item_count; ++i)
+    {
+        scaled[i] = m_items[i].second * static_cast<Weight>(item_count);
+        (scaled[i] < Weight(1.0) ? small : large).push_back(static_cast<uint32>(i));
+        if (m_items[i].second > m_items[heaviest].second)
+            heaviest = static_cast<uint32>(i);
+    }
+
+    // Fill each underfull bucket with the excess of an overfull one.
+    m_buckets.resize(item_count);
+    while (!small.empty() && !large.empty())
+    {
+        const uint32 s = small.back();
+        const uint32 l = large.back();
+        small.pop_back();
+
+        m_buckets[s].m_threshold = scaled[s];
+        m_buckets[s].m_alias = l;
+
+        scaled[l] = (scaled[l] + scaled[s]) - Weight(1.0);
+        if (scaled[l] < Weight(1.0))
+        {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+
+    // Remaining buckets are full, up to numerical errors. Make sure that
+    // items with a null weight are never returned.
+    for (size_t i = 0, e = large.size(); i < e; ++i)
+    {
+        m_buckets[large[i]].m_threshold = Weight(1.0);
+        m_buckets[large[i]].m_alias = large[i];
+    }
+    for (size_t i = 0, e = small.size(); i < e; ++i)
+    {
+        const bool positive = m_items[small[i]].second > Weight(0.0);
+        m_buckets[small[i]].m_threshold = positive ? Weight(1.0) : Weight(0.0);
+        m_buckets[small[i]].m_alias = positive ? small[i] : heaviest;
+    }
+}
+
+template <typename Item, typename Weight>
+inline const std::pair<Item, Weight>& AliasTable<Item, Weight>::sample(const Weight x) const
+{
+    assert(!m_buckets.empty());
+    assert(x >= Weight(0.0));
+    assert(x < Weight(1.0));
+
+    const size_t bucket_count = m_buckets.size();
+    const Weight scaled_x = x * static_cast<Weight>(bucket_count);
+    const size_t i = std::min(truncate<size_t>(scaled_x), bucket_count - 1);
+    const Bucket& bucket = m_buckets[i];
+
+    return m_items[scaled_x - static_cast<Weight>(i) < bucket.m_threshold ? i : bucket.m_alias];
+}
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_MATH_ALIASTABLE_H
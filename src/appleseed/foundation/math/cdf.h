@@ -38,6 +38,7 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -90,6 +91,10 @@ class CDF
     // Sample the CDF. x is in [0,1).
     const ItemWeightPair& sample(const Weight x) const;
 
+    // Sample the CDF and return in y the position of x inside the interval of the
+    // chosen item, rescaled to [0,1), so that y can be used as a fresh sample.
+    const ItemWeightPair& sample(const Weight x, Weight& y) const;
+
   private:
     typedef std::vector<ItemWeightPair> ItemVector;
     typedef std::vector<Weight> DensityVector;
@@ -228,6 +233,26 @@ inline const std::pair<Item, Weight>& CDF<Item, Weight>::sample(const Weight x)
     return m_items[i];
 }
 
+template <typename Item, typename Weight>
+inline const std::pair<Item, Weight>& CDF<Item, Weight>::sample(const Weight x, Weight& y) const
+{
+    const size_t i =
+        sample_cdf(
+            m_densities.begin(),
+            m_densities.end(),
+            x);
+
+    const Weight lo = i > 0 ? m_densities[i - 1] : Weight(0.0);
+    const Weight width = m_densities[i] - lo;
+
+    // Largest value below 1.0.
+    const Weight OneMinusEps = Weight(1.0) - std::numeric_limits<Weight>::epsilon() / 2;
+
+    y = width > Weight(0.0) ? std::min((x - lo) / width, OneMinusEps) : Weight(0.0);
+
+    return m_items[i];
+}
+
 
 //
 // Functions implementation.
@@ -0,0 +1,339 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#ifndef APPLESEED_FOUNDATION_MATH_INTERSECTION_RAYTRIANGLEMT4_H
+#define APPLESEED_FOUNDATION_MATH_INTERSECTION_RAYTRIANGLEMT4_H
+
+// appleseed.foundation headers.
+#include "foundation/math/intersection/raytrianglemt.h"
+#include "foundation/math/ray.h"
+#include "foundation/math/vector.h"
+#include "foundation/platform/compiler.h"
+#ifdef APPLESEED_USE_SSE
+#include "foundation/platform/sse.h"
+#endif
+
+// Standard headers.
+#include <cassert>
+#include <cstddef>
+
+namespace foundation
+{
+
+//
+// A group of four triangles stored in structure-of-arrays form, intersected
+// simultaneously with the Moeller-Trumbore ray-triangle intersection test.
+//
+// The intersection tests are performed in the precision of the ray, and make
+// exactly the same decisions as TriangleMT<>::intersect(). Unused slots must
+// be filled with degenerate triangles (see clear()); they are never hit.
+//
+
+template <typename T>
+struct TriangleMT4
+{
+    // Types.
+    typedef T ValueType;
+    typedef Vector<T, 3> VectorType;
+
+    // Number of triangles in a group.
+    static const size_t Size = 4;
+
+    // First vertices.
+    ValueType   m_v0[3][Size];
+
+    // Two edges.
+    ValueType   m_e0[3][Size];
+    ValueType   m_e1[3][Size];
+
+    // Make all the slots of the group empty.
+    void clear();
+
+    // Set or retrieve the triangle in a given slot.
+    template <typename U>
+    void set(const size_t index, const TriangleMT<U>& triangle);
+    TriangleMT<T> get(const size_t index) const;
+
+    // Intersect all the triangles of the group. Return a bit mask of the triangles
+    // that were hit; t, u and v are only defined for the bits that are set.
+    template <typename U>
+    int intersect(
+        const Ray<U, 3>&    ray,
+        U                   t[Size],
+        U                   u[Size],
+        U                   v[Size]) const;
+    template <typename U>
+    int intersect(const Ray<U, 3>& ray) const;
+};
+
+
+//
+// TriangleMT4 class implementation.
+//
+
+template <typename T>
+inline void TriangleMT4<T>::clear()
+{
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (size_t j = 0; j < Size; ++j)
+        {
+            m_v0[i][j] = T(0.0);
+            m_e0[i][j] = T(0.0);
+            m_e1[i][j] = T(0.0);
+        }
+    }
+}
+
+template <typename T>
+template <typename U>
+inline void TriangleMT4<T>::set(const size_t index, const TriangleMT<U>& triangle)
+{
+    assert(index < Size);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        m_v0[i][index] = static_cast<T>(triangle.m_v0[i]);
+        m_e0[i][index] = static_cast<T>(triangle.m_e0[i]);
+        m_e1[i][index] = static_cast<T>(triangle.m_e1[i]);
+    }
+}
+
+template <typename T>
+inline TriangleMT<T> TriangleMT4<T>::get(const size_t index) const
+{
+    assert(index < Size);
+
+    TriangleMT<T> triangle;
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        triangle.m_v0[i] = m_v0[i][index];
+        triangle.m_e0[i] = m_e0[i][index];
+        triangle.m_e1[i] = m_e1[i][index];
+    }
+
+    return triangle;
+}
+
+template <typename T>
+template <typename U>
+APPLESEED_FORCE_INLINE int TriangleMT4<T>::intersect(
+    const Ray<U, 3>&        ray,
+    U                       t[Size],
+    U                       u[Size],
+    U                       v[Size]) const
+{
+    int mask = 0;
+
+    for (size_t i = 0; i < Size; ++i)
+    {
+        const TriangleMT<U> triangle(get(i));
+
+        if (triangle.intersect(ray, t[i], u[i], v[i]))
+            mask |= 1 << i;
+    }
+
+    return mask;
+}
+
+template <typename T>
+template <typename U>
+APPLESEED_FORCE_INLINE int TriangleMT4<T>::intersect(const Ray<U, 3>& ray) const
+{
+    int mask = 0;
+
+    for (size_t i = 0; i < Size; ++i)
+    {
+        const TriangleMT<U> triangle(get(i));
+
+        if (triangle.intersect(ray))
+            mask |= 1 << i;
+    }
+
+    return mask;
+}
+
+#ifdef APPLESEED_USE_SSE
+
+namespace raytrianglemt4_impl
+{
+    // Ray stored in SSE registers.
+    struct RaySSE
+    {
+        __m128d m_org[3];
+        __m128d m_dir[3];
+        __m128d m_tmin;
+        __m128d m_tmax;
+
+        explicit RaySSE(const Ray3d& ray)
+        {
+            for (size_t i = 0; i < 3; ++i)
+            {
+                m_org[i] = _mm_set1_pd(ray.m_org[i]);
+                m_dir[i] = _mm_set1_pd(ray.m_dir[i]);
+            }
+
+            m_tmin = _mm_set1_pd(ray.m_tmin);
+            m_tmax = _mm_set1_pd(ray.m_tmax);
+        }
+    };
+
+    // Load two consecutive single precision values and convert them to double precision.
+    APPLESEED_FORCE_INLINE __m128d load2(const float* p)
+    {
+        return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))));
+    }
+
+    // Intersect two triangles of a group, starting at a given slot. Return a two-bit mask
+    // of the triangles that were hit, as well as the sign-corrected determinant and the
+    // unscaled t, u and v parameters. The tests mirror the ones in TriangleMT<>::intersect():
+    // flipping the signs of the parameters when the determinant is negative turns the two
+    // branches of the scalar code into a single set of comparisons.
+    APPLESEED_FORCE_INLINE int intersect2(
+        const TriangleMT4<float>&   group,
+        const size_t                offset,
+        const RaySSE&               ray,
+        __m128d&                    det,
+        __m128d&                    t,
+        __m128d&                    u,
+        __m128d&                    v)
+    {
+        const __m128d v0x = load2(&group.m_v0[0][offset]);
+        const __m128d v0y = load2(&group.m_v0[1][offset]);
+        const __m128d v0z = load2(&group.m_v0[2][offset]);
+        const __m128d e0x = load2(&group.m_e0[0][offset]);
+        const __m128d e0y = load2(&group.m_e0[1][offset]);
+        const __m128d e0z = load2(&group.m_e0[2][offset]);
+        const __m128d e1x = load2(&group.m_e1[0][offset]);
+        const __m128d e1y = load2(&group.m_e1[1][offset]);
+        const __m128d e1z = load2(&group.m_e1[2][offset]);
+
+        // Calculate determinant.
+        const __m128d px = _mm_sub_pd(_mm_mul_pd(ray.m_dir[1], e1z), _mm_mul_pd(e1y, ray.m_dir[2]));
+        const __m128d py = _mm_sub_pd(_mm_mul_pd(ray.m_dir[2], e1x), _mm_mul_pd(e1z, ray.m_dir[0]));
+        const __m128d pz = _mm_sub_pd(_mm_mul_pd(ray.m_dir[0], e1y), _mm_mul_pd(e1x, ray.m_dir[1]));
+        const __m128d signed_det =
+            _mm_add_pd(_mm_add_pd(_mm_mul_pd(e0x, px), _mm_mul_pd(e0y, py)), _mm_mul_pd(e0z, pz));
+
+        // Calculate distance from v0 to ray origin.
+        const __m128d tx = _mm_sub_pd(ray.m_org[0], v0x);
+        const __m128d ty = _mm_sub_pd(ray.m_org[1], v0y);
+        const __m128d tz = _mm_sub_pd(ray.m_org[2], v0z);
+
+        // Calculate u parameter.
+        const __m128d signed_u =
+            _mm_add_pd(_mm_add_pd(_mm_mul_pd(tx, px), _mm_mul_pd(ty, py)), _mm_mul_pd(tz, pz));
+
+        // Calculate v parameter.
+        const __m128d qx = _mm_sub_pd(_mm_mul_pd(ty, e0z), _mm_mul_pd(e0y, tz));
+        const __m128d qy = _mm_sub_pd(_mm_mul_pd(tz, e0x), _mm_mul_pd(e0z, tx));
+        const __m128d qz = _mm_sub_pd(_mm_mul_pd(tx, e0y), _mm_mul_pd(e0x, ty));
+        const __m128d signed_v =
+            _mm_add_pd(_mm_add_pd(_mm_mul_pd(ray.m_dir[0], qx), _mm_mul_pd(ray.m_dir[1], qy)), _mm_mul_pd(ray.m_dir[2], qz));
+
+        // Calculate t parameter.
+        const __m128d signed_t =
+            _mm_add_pd(_mm_add_pd(_mm_mul_pd(e1x, qx), _mm_mul_pd(e1y, qy)), _mm_mul_pd(e1z, qz));
+
+        // Make the determinant positive and flip the signs of the parameters accordingly.
+        const __m128d sign = _mm_and_pd(signed_det, _mm_set1_pd(-0.0));
+        det = _mm_xor_pd(signed_det, sign);
+        u = _mm_xor_pd(signed_u, sign);
+        v = _mm_xor_pd(signed_v, sign);
+        t = _mm_xor_pd(signed_t, sign);
+
+        // Test bounds.
+        const __m128d zero = _mm_setzero_pd();
+        const __m128d inside =
+            _mm_and_pd(
+                _mm_and_pd(
+                    _mm_cmpge_pd(u, zero),
+                    _mm_cmple_pd(u, det)),
+                _mm_and_pd(
+                    _mm_cmpge_pd(v, zero),
+                    _mm_cmple_pd(_mm_add_pd(u, v), det)));
+        const __m128d in_range =
+            _mm_and_pd(
+                _mm_cmpge_pd(t, _mm_mul_pd(ray.m_tmin, det)),
+                _mm_cmplt_pd(t, _mm_mul_pd(ray.m_tmax, det)));
+
+        return _mm_movemask_pd(_mm_and_pd(inside, in_range));
+    }
+}
+
+template <>
+template <>
+APPLESEED_FORCE_INLINE int TriangleMT4<float>::intersect(
+    const Ray3d&            ray,
+    double                  t[Size],
+    double                  u[Size],
+    double                  v[Size]) const
+{
+    const raytrianglemt4_impl::RaySSE ray_sse(ray);
+
+    __m128d det01, t01, u01, v01;
+    __m128d det23, t23, u23, v23;
+    const int mask =
+          raytrianglemt4_impl::intersect2(*this, 0, ray_sse, det01, t01, u01, v01)
+        | raytrianglemt4_impl::intersect2(*this, 2, ray_sse, det23, t23, u23, v23) << 2;
+
+    if (mask)
+    {
+        // Scale parameters.
+        const __m128d one = _mm_set1_pd(1.0);
+        const __m128d rcp_det01 = _mm_div_pd(one, det01);
+        const __m128d rcp_det23 = _mm_div_pd(one, det23);
+        _mm_storeu_pd(t + 0, _mm_mul_pd(t01, rcp_det01));
+        _mm_storeu_pd(t + 2, _mm_mul_pd(t23, rcp_det23));
+        _mm_storeu_pd(u + 0, _mm_mul_pd(u01, rcp_det01));
+        _mm_storeu_pd(u + 2, _mm_mul_pd(u23, rcp_det23));
+        _mm_storeu_pd(v + 0, _mm_mul_pd(v01, rcp_det01));
+        _mm_storeu_pd(v + 2, _mm_mul_pd(v23, rcp_det23));
+    }
+
+    return mask;
+}
+
+template <>
+template <>
+APPLESEED_FORCE_INLINE int TriangleMT4<float>::intersect(const Ray3d& ray) const
+{
+    const raytrianglemt4_impl::RaySSE ray_sse(ray);
+
+    __m128d det, t, u, v;
+    return
+          raytrianglemt4_impl::intersect2(*this, 0, ray_sse, det, t, u, v)
+        | raytrianglemt4_impl::intersect2(*this, 2, ray_sse, det, t, u, v) << 2;
+}
+
+#endif  // APPLESEED_USE_SSE
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_MATH_INTERSECTION_RAYTRIANGLEMT4_H
@@ -0,0 +1,115 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "microfacetalbedo.h"
+
+// appleseed.foundation headers.
+#include "foundation/platform/thread.h"
+#include "foundation/utility/foreach.h"
+
+// Standard headers.
+#include <cstring>
+#include <map>
+
+using namespace std;
+
+namespace foundation
+{
+
+//
+// MicrofacetAlbedoTableCache class implementation.
+//
+
+namespace
+{
+    struct TableMap
+      : public NonCopyable
+    {
+        typedef MicrofacetAlbedoTableCache::Key Key;
+        typedef MicrofacetAlbedoTableCache::TableType TableType;
+        typedef map<Key, const TableType*> Tables;
+
+        boost::mutex    m_mutex;
+        Tables          m_tables;
+
+        ~TableMap()
+        {
+            for (const_each<Tables> i = m_tables; i; ++i)
+                delete i->second;
+        }
+    };
+
+    // Constructed during static initialization, before any thread can use the cache.
+    TableMap g_table_map;
+}
+
+bool MicrofacetAlbedoTableCache::Key::operator<(const Key& rhs) const
+{
+    const int mdf_name_cmp = strcmp(m_mdf_name, rhs.m_mdf_name);
+    if (mdf_name_cmp != 0)
+        return mdf_name_cmp < 0;
+
+    if (m_roughness != rhs.m_roughness)
+        return m_roughness < rhs.m_roughness;
+
+    if (m_size != rhs.m_size)
+        return m_size < rhs.m_size;
+
+    return m_sample_count < rhs.m_sample_count;
+}
+
+size_t MicrofacetAlbedoTableCache::size()
+{
+    boost::mutex::scoped_lock lock(g_table_map.m_mutex);
+    return g_table_map.m_tables.size();
+}
+
+const MicrofacetAlbedoTableCache::TableType* MicrofacetAlbedoTableCache::find(const Key& key)
+{
+    boost::mutex::scoped_lock lock(g_table_map.m_mutex);
+
+    const TableMap::Tables::const_iterator i = g_table_map.m_tables.find(key);
+    return i != g_table_map.m_tables.end() ? i->second : 0;
+}
+
+const MicrofacetAlbedoTableCache::TableType& MicrofacetAlbedoTableCache::insert(
+    const Key&          key,
+    auto_ptr<TableType> table)
+{
+    boost::mutex::scoped_lock lock(g_table_map.m_mutex);
+
+    const TableType*& entry = g_table_map.m_tables[key];
+    if (entry == 0)
+        entry = table.release();
+
+    return *entry;
+}
+
+}   // namespace foundation
@@ -0,0 +1,268 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_FOUNDATION_MATH_MICROFACETALBEDO_H
+#define APPLESEED_FOUNDATION_MATH_MICROFACETALBEDO_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/math/qmc.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+// Standard headers.
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <typeinfo>
+#include <vector>
+
+namespace foundation
+{
+
+//
+// Directional albedo of a microfacet specular lobe with a Schlick Fresnel term,
+// tabulated as a function of the cosine of the angle between the outgoing
+// direction and the normal.
+//
+// Schlick's approximation is linear in the reflectance at normal incidence F0,
+// so the albedo is F0 * a + b where a and b only depend on the microfacet
+// distribution. A single table can then be shared by all materials using the
+// same distribution, whatever their reflectance.
+//
+// The microfacet distribution must provide the following methods:
+//
+//   Vector<T, 3> sample(const Vector<T, 2>& s) const;
+//   T evaluate(const T cos_alpha) const;
+//   T evaluate_pdf(const T cos_alpha) const;
+//
+
+template <typename T>
+class MicrofacetAlbedoTable
+  : public NonCopyable
+{
+  public:
+    // Constructor, tabulates the albedo of a given microfacet distribution.
+    template <typename MDF>
+    MicrofacetAlbedoTable(
+        const MDF&      mdf,
+        const size_t    size,
+        const size_t    sample_count);
+
+    // Return the number of entries in the table.
+    size_t size() const;
+
+    // Return the cosine of the outgoing angle of a given entry.
+    T get_cos_theta(const size_t i) const;
+
+    // Return the albedo of a given entry for a given reflectance at normal incidence.
+    template <typename Spectrum>
+    void get_albedo(
+        const size_t    i,
+        const Spectrum& f0,
+        Spectrum&       albedo) const;
+
+  private:
+    std::vector<T>  m_a;    // albedo per unit of reflectance at normal incidence
+    std::vector<T>  m_b;    // albedo for a reflectance at normal incidence of 0
+};
+
+
+//
+// A process-wide cache of microfacet albedo tables.
+//
+// Tables are keyed by the type of the microfacet distribution, its roughness
+// and the resolution of the table. They are computed on first use and kept
+// until the end of the process. All methods of this class are thread-safe.
+//
+
+class APPLESEED_DLLSYMBOL MicrofacetAlbedoTableCache
+  : public NonCopyable
+{
+  public:
+    typedef MicrofacetAlbedoTable<float> TableType;
+
+    // Return the table of a given microfacet distribution, computing it if needed.
+    template <typename MDF>
+    static const TableType& get(
+        const MDF&      mdf,
+        const float     roughness,
+        const size_t    size,
+        const size_t    sample_count);
+
+    // Return the number of tables in the cache.
+    static size_t size();
+
+    struct Key
+    {
+        const char*     m_mdf_name;
+        float           m_roughness;
+        size_t          m_size;
+        size_t          m_sample_count;
+
+        bool operator<(const Key& rhs) const;
+    };
+
+  private:
+    // Return the table with a given key, or 0 if it isn't in the cache.
+    static const TableType* find(const Key& key);
+
+    // Insert a table into the cache, and return the table with this key that ends up in
+    // the cache. If another thread inserted one in the meantime, the new table is deleted.
+    static const TableType& insert(const Key& key, std::auto_ptr<TableType> table);
+};
+
+
+//
+// MicrofacetAlbedoTable class implementation.
+//
+
+template <typename T>
+template <typename MDF>
+MicrofacetAlbedoTable<T>::MicrofacetAlbedoTable(
+    const MDF&          mdf,
+    const size_t        size,
+    const size_t        sample_count)
+  : m_a(size, T(0.0))
+  , m_b(size, T(0.0))
+{
+    assert(size > 1);
+    assert(sample_count > 0);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        // Compute an outgoing direction V in the XY plane.
+        const T cos_theta = get_cos_theta(i);
+        const T sin_theta = std::sqrt(T(1.0) - cos_theta * cos_theta);
+        const Vector<T, 3> V(sin_theta, cos_theta, T(0.0));
+
+        // See Physically Based Rendering, first edition, pp. 689-690.
+        T a = T(0.0), b = T(0.0);
+
+        for (size_t j = 0; j < sample_count; ++j)
+        {
+            // Generate a uniform sample in [0,1)^2.
+            static const size_t Bases[] = { 2 };
+            const Vector<T, 2> s = hammersley_sequence<T, 2>(Bases, sample_count, j);
+
+            // Sample the microfacet distribution to get an halfway vector H.
+            const Vector<T, 3> H = mdf.sample(s);
+            const T dot_HV = dot(H, V);
+            if (dot_HV <= T(0.0))
+                continue;
+
+            // L is the reflection of V around H.
+            const Vector<T, 3> L = (dot_HV + dot_HV) * H - V;
+
+            // Reject L if it lies in or below the surface.
+            if (L.y <= T(0.0))
+                continue;
+
+            // Evaluate the PDF of L.
+            const T dot_HN = H.y;
+            const T pdf_H = mdf.evaluate_pdf(dot_HN);
+            const T pdf_L = pdf_H / (T(4.0) * dot_HV);
+            assert(pdf_L >= T(0.0));
+            if (pdf_L == T(0.0))
+                continue;
+
+            // Split the Schlick Fresnel term into its F0 and constant parts.
+            const T k1 = T(1.0) - dot_HV;
+            const T k2 = k1 * k1;
+            const T k5 = k2 * k2 * k1;
+            const T weight = (L.y * mdf.evaluate(dot_HN)) / (T(4.0) * pdf_L * dot_HV * dot_HV);
+            a += weight * (T(1.0) - k5);
+            b += weight * k5;
+        }
+
+        m_a[i] = a / sample_count;
+        m_b[i] = b / sample_count;
+    }
+}
+
+template <typename T>
+inline size_t MicrofacetAlbedoTable<T>::size() const
+{
+    return m_a.size();
+}
+
+template <typename T>
+inline T MicrofacetAlbedoTable<T>::get_cos_theta(const size_t i) const
+{
+    assert(i < m_a.size());
+    return static_cast<T>(i) / (m_a.size() - 1);
+}
+
+template <typename T>
+template <typename Spectrum>
+inline void MicrofacetAlbedoTable<T>::get_albedo(
+    const size_t        i,
+    const Spectrum&     f0,
+    Spectrum&           albedo) const
+{
+    assert(i < m_a.size());
+
+    albedo = f0;
+    albedo *= m_a[i];
+    albedo += Spectrum(m_b[i]);
+}
+
+
+//
+// MicrofacetAlbedoTableCache class implementation.
+//
+
+template <typename MDF>
+const MicrofacetAlbedoTableCache::TableType& MicrofacetAlbedoTableCache::get(
+    const MDF&          mdf,
+    const float         roughness,
+    const size_t        size,
+    const size_t        sample_count)
+{
+    Key key;
+    key.m_mdf_name = typeid(MDF).name();
+    key.m_roughness = roughness;
+    key.m_size = size;
+    key.m_sample_count = sample_count;
+
+    const TableType* table = find(key);
+    if (table)
+        return *table;
+
+    // Compute the table outside of the lock, other threads may keep looking up tables.
+    return insert(key, std::auto_ptr<TableType>(new TableType(mdf, size, sample_count)));
+}
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_MATH_MICROFACETALBEDO_H
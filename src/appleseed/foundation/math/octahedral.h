@@ -0,0 +1,139 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_FOUNDATION_MATH_OCTAHEDRAL_H
+#define APPLESEED_FOUNDATION_MATH_OCTAHEDRAL_H
+
+// appleseed.foundation headers.
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+#include "foundation/platform/types.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cmath>
+
+namespace foundation
+{
+
+//
+// Octahedral encoding of unit vectors into 32 bits (two 16-bit signed normalized integers).
+// The maximum angular error is about 0.003 degrees.
+//
+// Reference:
+//
+//   A Survey of Efficient Representations for Independent Unit Vectors
+//   http://jcgt.org/published/0003/02/01/paper.pdf
+//
+
+// Encode a unit vector. A zero vector is encoded as the +Z axis.
+template <typename T>
+uint32 encode_octahedral(const Vector<T, 3>& v);
+
+// Decode a unit vector. The returned vector is unit-length.
+template <typename T>
+Vector<T, 3> decode_octahedral(const uint32 code);
+
+
+//
+// Implementation.
+//
+
+namespace octahedral_impl
+{
+    template <typename T>
+    inline T sign_not_zero(const T x)
+    {
+        return x >= T(0.0) ? T(1.0) : T(-1.0);
+    }
+
+    template <typename T>
+    inline uint32 quantize(const T x)
+    {
+        const int32 q = static_cast<int32>(std::floor(clamp(x, T(-1.0), T(1.0)) * T(32767.0) + T(0.5)));
+        return static_cast<uint32>(static_cast<uint16>(static_cast<int16>(q)));
+    }
+
+    template <typename T>
+    inline T dequantize(const uint32 q)
+    {
+        const int16 x = static_cast<int16>(static_cast<uint16>(q));
+        return std::max(static_cast<T>(x) * (T(1.0) / T(32767.0)), T(-1.0));
+    }
+}
+
+template <typename T>
+inline uint32 encode_octahedral(const Vector<T, 3>& v)
+{
+    // Guard against a division by zero.
+    const T l1_norm = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+    if (l1_norm == T(0.0))
+        return 0;
+
+    // Project the vector onto the octahedron, then onto the z = 0 plane.
+    const T rcp_l1_norm = T(1.0) / l1_norm;
+    T px = v.x * rcp_l1_norm;
+    T py = v.y * rcp_l1_norm;
+
+    // Fold the lower hemisphere over the diagonals.
+    if (v.z < T(0.0))
+    {
+        const T fx = (T(1.0) - std::abs(py)) * octahedral_impl::sign_not_zero(px);
+        const T fy = (T(1.0) - std::abs(px)) * octahedral_impl::sign_not_zero(py);
+        px = fx;
+        py = fy;
+    }
+
+    return
+          octahedral_impl::quantize(px)
+        | (octahedral_impl::quantize(py) << 16);
+}
+
+template <typename T>
+inline Vector<T, 3> decode_octahedral(const uint32 code)
+{
+    Vector<T, 3> v;
+    v.x = octahedral_impl::dequantize<T>(code & 0xFFFF);
+    v.y = octahedral_impl::dequantize<T>(code >> 16);
+    v.z = T(1.0) - std::abs(v.x) - std::abs(v.y);
+
+    // Unfold the lower hemisphere.
+    if (v.z < T(0.0))
+    {
+        const T x = v.x;
+        v.x = (T(1.0) - std::abs(v.y)) * octahedral_impl::sign_not_zero(x);
+        v.y = (T(1.0) - std::abs(x)) * octahedral_impl::sign_not_zero(v.y);
+    }
+
+    return normalize(v);
+}
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_MATH_OCTAHEDRAL_H
@@ -99,12 +99,25 @@ class ImageImportanceSampler
         Payload&            payload,
         Importance&         probability) const;
 
+    // Sample the image and return the coordinates of the chosen pixel, its
+    // probability density and the position of the sample inside that pixel,
+    // in [0,1)^2. The position is what is left of s after the CDF inversions,
+    // hence it preserves the stratification of s.
+    void sample_with_offset(
+        const Vector2Type&  s,
+        size_t&             x,
+        size_t&             y,
+        Vector2Type&        offset,
+        Importance&         probability) const;
+
     // Return the probability density of a given pixel.
     Importance get_pdf(
         const size_t        x,
         const size_t        y) const;
 
   private:
+    // CDF inversion (rather than alias tables) maps neighboring samples to
+    // neighboring pixels, which preserves the stratification of the samples.
     typedef CDF<size_t, Importance> RowCDF;
     typedef CDF<Payload, Importance> ColCDF;
 
@@ -265,6 +278,44 @@ inline void ImageImportanceSampler<Payload, Importance>::sample(
     assert(probability > Importance(0.0));
 }
 
+template <typename Payload, typename Importance>
+inline void ImageImportanceSampler<Payload, Importance>::sample_with_offset(
+    const Vector2Type&      s,
+    size_t&                 x,
+    size_t&                 y,
+    Vector2Type&            offset,
+    Importance&             probability) const
+{
+    if (m_rows_cdf.valid())
+    {
+        // Select a row.
+        const typename RowCDF::ItemWeightPair& row = m_rows_cdf.sample(s[1], offset[1]);
+        assert(row.second != Importance(0.0));
+        y = row.first;
+
+        // Select a column within this row.
+        const typename ColCDF::ItemWeightPair& col = m_cols_cdf[y].sample(s[0], offset[0]);
+        assert(col.second != Importance(0.0));
+        x = &col - &m_cols_cdf[y][0];
+
+        probability = row.second * col.second;
+    }
+    else
+    {
+        // Uniform random sampling.
+        const Importance fx = s[0] * m_width;
+        const Importance fy = s[1] * m_height;
+        x = truncate<size_t>(fx);
+        y = truncate<size_t>(fy);
+        offset[0] = fx - x;
+        offset[1] = fy - y;
+
+        probability = m_rcp_pixel_count;
+    }
+
+    assert(probability > Importance(0.0));
+}
+
 template <typename Payload, typename Importance>
 inline Importance ImageImportanceSampler<Payload, Importance>::get_pdf(
     const size_t            x,
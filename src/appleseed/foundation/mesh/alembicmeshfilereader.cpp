@@ -32,6 +32,7 @@
 
 // appleseed.foundation headers.
 #include "foundation/core/concepts/noncopyable.h"
+#include "foundation/math/scalar.h"
 #include "foundation/math/vector.h"
 #include "foundation/mesh/imeshbuilder.h"
 #include "foundation/platform/types.h"
@@ -70,8 +71,13 @@ namespace
       : public NonCopyable
     {
       public:
-        explicit MeshObjectReader(IMeshBuilder& mesh_builder)
+        MeshObjectReader(
+            IMeshBuilder&   mesh_builder,
+            const bool      has_sample_time,
+            const double    sample_time)
           : m_mesh_builder(mesh_builder)
+          , m_has_sample_time(has_sample_time)
+          , m_sample_time(sample_time)
           , m_has_vertex_normals(false)
           , m_has_uv(false)
         {
@@ -81,58 +87,108 @@ namespace
         {
             IPolyMeshSchema& mesh_schema = mesh.getSchema();
 
-            // todo: pass as parameter.
-            const size_t sample_index = 0;
+            const index_t sample_count = static_cast<index_t>(mesh_schema.getNumSamples());
+            if (sample_count == 0)
+                return;
+
+            // Find the samples bracketing the sample time.
+            size_t floor_index = 0;
+            size_t ceil_index = 0;
+            double t = 0.0;
+            if (m_has_sample_time && sample_count > 1)
+            {
+                const TimeSamplingPtr time_sampling = mesh_schema.getTimeSampling();
+
+                vector<double> sample_times(static_cast<size_t>(sample_count));
+                for (index_t i = 0; i < sample_count; ++i)
+                    sample_times[static_cast<size_t>(i)] = time_sampling->getSampleTime(i);
+
+                find_bracketing_samples(
+                    &sample_times[0],
+                    sample_times.size(),
+                    m_sample_time,
+                    floor_index,
+                    ceil_index,
+                    t);
+            }
 
-            IPolyMeshSchema::Sample mesh_sample;
-            mesh_schema.get(mesh_sample, sample_index);
+            // Read the properties of the mesh individually rather than the full sample,
+            // and take the mesh topology from the same sample as the vertex positions.
+            const ISampleSelector floor_sample(static_cast<index_t>(floor_index));
 
-            if (!mesh_sample)
-                return;
+            const P3fArraySamplePtr positions = mesh_schema.getPositionsProperty().getValue(floor_sample);
 
             // Skip degenerate mesh objects.
-            if (mesh_sample.getPositions()->size() < 3)
+            if (!positions || positions->size() < 3)
                 return;
 
             m_mesh_builder.begin_mesh(mesh.getName().c_str());
 
-            read_vertices(mesh_sample);
-            read_vertex_normals(mesh_schema);
-            read_uv(mesh_schema);
-
-            // Use the mesh topology of the first sample.
-            mesh_sample.reset();
-            mesh_schema.get(mesh_sample, 0);
-
-            read_face_indices(mesh_sample);
+            read_vertices(mesh_schema, positions, static_cast<index_t>(ceil_index), t);
+            read_vertex_normals(mesh_schema, floor_sample);
+            read_uv(mesh_schema, floor_sample);
+            read_face_indices(mesh_schema, floor_sample);
 
             m_mesh_builder.end_mesh();
         }
 
       private:
         IMeshBuilder&   m_mesh_builder;
+        const bool      m_has_sample_time;
+        const double    m_sample_time;
         bool            m_has_vertex_normals;
         bool            m_has_uv;
 
-        void read_vertices(IPolyMeshSchema::Sample mesh_sample)
+        void read_vertices(
+            IPolyMeshSchema&                mesh_schema,
+            const P3fArraySamplePtr&        floor_positions,
+            const index_t                   ceil_index,
+            const double                    t)
         {
-            const Imath::V3f* vertices = mesh_sample.getPositions()->get();
-            const size_t vertex_count = mesh_sample.getPositions()->size();
+            const Imath::V3f* vertices = floor_positions->get();
+            const size_t vertex_count = floor_positions->size();
+
+            // Only fetch the positions of the second sample, and only if we need to interpolate.
+            P3fArraySamplePtr ceil_positions;
+            if (t > 0.0)
+            {
+                ceil_positions = mesh_schema.getPositionsProperty().getValue(ISampleSelector(ceil_index));
 
-            for (size_t i = 0; i < vertex_count; ++i)
+                // Interpolation requires matching vertex counts.
+                if (ceil_positions->size() != vertex_count)
+                    ceil_positions.reset();
+            }
+
+            if (ceil_positions)
+            {
+                const Imath::V3f* ceil_vertices = ceil_positions->get();
+
+                for (size_t i = 0; i < vertex_count; ++i)
+                {
+                    const Vector3d v0(vertices[i]);
+                    const Vector3d v1(ceil_vertices[i]);
+                    m_mesh_builder.push_vertex(lerp(v0, v1, t));    // todo: transform to world space using matrix stack
+                }
+            }
+            else
             {
-                const Vector3d v(vertices[i]);      // todo: transform to world space using matrix stack
-                m_mesh_builder.push_vertex(v);
+                for (size_t i = 0; i < vertex_count; ++i)
+                {
+                    const Vector3d v(vertices[i]);      // todo: transform to world space using matrix stack
+                    m_mesh_builder.push_vertex(v);
+                }
             }
         }
 
-        void read_vertex_normals(IPolyMeshSchema& mesh_schema)
+        void read_vertex_normals(
+            IPolyMeshSchema&                mesh_schema,
+            const ISampleSelector&          sample_selector)
         {
             IN3fGeomParam normal_param = mesh_schema.getNormalsParam();
             if (!normal_param.valid())
                 return;
 
-            IN3fGeomParam::Sample normal_sample(normal_param.getIndexedValue());
+            IN3fGeomParam::Sample normal_sample(normal_param.getIndexedValue(sample_selector));
             if (!normal_sample.valid())
                 return;
 
@@ -148,13 +204,15 @@ namespace
             m_has_vertex_normals = normal_count > 0;
         }
 
-        void read_uv(IPolyMeshSchema& mesh_schema)
+        void read_uv(
+            IPolyMeshSchema&                mesh_schema,
+            const ISampleSelector&          sample_selector)
         {
             IV2fGeomParam uv_param = mesh_schema.getUVsParam();
             if (!uv_param.valid())
                 return;
 
-            IV2fGeomParam::Sample uv_sample(uv_param.getIndexedValue());
+            IV2fGeomParam::Sample uv_sample(uv_param.getIndexedValue(sample_selector));
             if (!uv_sample.valid())
                 return;
 
@@ -170,11 +228,19 @@ namespace
             m_has_uv = uv_count > 0;
         }
 
-        void read_face_indices(IPolyMeshSchema::Sample mesh_sample)
+        void read_face_indices(
+            IPolyMeshSchema&                mesh_schema,
+            const ISampleSelector&          sample_selector)
         {
-            const int32* face_sizes = mesh_sample.getFaceCounts()->get();
-            const size_t face_count = mesh_sample.getFaceCounts()->size();
-            const int32* face_indices = mesh_sample.getFaceIndices()->get();
+            const Int32ArraySamplePtr face_counts = mesh_schema.getFaceCountsProperty().getValue(sample_selector);
+            const Int32ArraySamplePtr face_indices_sample = mesh_schema.getFaceIndicesProperty().getValue(sample_selector);
+
+            if (!face_counts || !face_indices_sample)
+                return;
+
+            const int32* face_sizes = face_counts->get();
+            const size_t face_count = face_counts->size();
+            const int32* face_indices = face_indices_sample->get();
 
             size_t current_vertex_index = 0;
             vector<size_t> indices;
@@ -213,7 +279,11 @@ namespace
         }
     };
 
-    void read_object(IObject object, IMeshBuilder& builder)
+    void read_object(
+        IObject             object,
+        IMeshBuilder&       builder,
+        const bool          has_sample_time,
+        const double        sample_time)
     {
         const size_t children_count = object.getNumChildren();
 
@@ -223,25 +293,48 @@ namespace
 
             if (IPolyMesh::matches(child_header))
             {
-                MeshObjectReader mesh_reader(builder);
+                MeshObjectReader mesh_reader(builder, has_sample_time, sample_time);
                 mesh_reader.read(IPolyMesh(object, child_header.getName()));
             }
 
-            read_object(object.getChild(i), builder);
+            read_object(object.getChild(i), builder, has_sample_time, sample_time);
         }
     }
 }
 
+struct AlembicMeshFileReader::Impl
+{
+    string      m_filename;
+    bool        m_has_sample_time;
+    double      m_sample_time;
+    IArchive    m_archive;
+};
+
 AlembicMeshFileReader::AlembicMeshFileReader(const string& filename)
-  : m_filename(filename)
+  : impl(new Impl())
+{
+    impl->m_filename = filename;
+    impl->m_has_sample_time = false;
+    impl->m_sample_time = 0.0;
+}
+
+AlembicMeshFileReader::~AlembicMeshFileReader()
+{
+    delete impl;
+}
+
+void AlembicMeshFileReader::set_sample_time(const double time)
 {
+    impl->m_has_sample_time = true;
+    impl->m_sample_time = time;
 }
 
 void AlembicMeshFileReader::read(IMeshBuilder& builder)
 {
-    const IArchive archive(AbcCoreHDF5::ReadArchive(), m_filename);
+    if (!impl->m_archive.valid())
+        impl->m_archive = IArchive(AbcCoreHDF5::ReadArchive(), impl->m_filename);
 
-    read_object(IObject(archive, kTop), builder);
+    read_object(IObject(impl->m_archive, kTop), builder, impl->m_has_sample_time, impl->m_sample_time);
 }
 
 }   // namespace foundation
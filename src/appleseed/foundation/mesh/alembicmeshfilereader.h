@@ -35,6 +35,9 @@
 #include "foundation/platform/compiler.h"
 
 // Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
 #include <string>
 
 // Forward declarations.
@@ -59,13 +62,74 @@ class AlembicMeshFileReader
     // Constructor.
     explicit AlembicMeshFileReader(const std::string& filename);
 
-    // Read a mesh.
+    // Destructor.
+    virtual ~AlembicMeshFileReader();
+
+    // Set the time, in seconds, at which animated meshes are sampled. Vertex positions
+    // are interpolated between the two samples bracketing this time. By default, the
+    // first sample of each mesh is read.
+    void set_sample_time(const double time);
+
+    // Read a mesh. The archive is opened on the first call and kept open
+    // so that reading the same file at several sample times is cheap.
     virtual void read(IMeshBuilder& builder) APPLESEED_OVERRIDE;
 
   private:
-    const std::string m_filename;
+    struct Impl;
+    Impl* impl;
 };
 
+
+//
+// Find the two samples bracketing a given time among samples taken at increasing times,
+// and the parameter t in [0, 1] to interpolate between them. Times outside of the range
+// of the samples are clamped to the first or the last sample.
+//
+
+void find_bracketing_samples(
+    const double*   sample_times,
+    const size_t    sample_count,
+    const double    time,
+    size_t&         floor_index,
+    size_t&         ceil_index,
+    double&         t);
+
+
+//
+// Implementation.
+//
+
+inline void find_bracketing_samples(
+    const double*   sample_times,
+    const size_t    sample_count,
+    const double    time,
+    size_t&         floor_index,
+    size_t&         ceil_index,
+    double&         t)
+{
+    assert(sample_count > 0);
+
+    const size_t upper =
+        static_cast<size_t>(std::upper_bound(sample_times, sample_times + sample_count, time) - sample_times);
+
+    if (upper == 0)
+    {
+        floor_index = ceil_index = 0;
+        t = 0.0;
+    }
+    else if (upper == sample_count)
+    {
+        floor_index = ceil_index = sample_count - 1;
+        t = 0.0;
+    }
+    else
+    {
+        floor_index = upper - 1;
+        ceil_index = upper;
+        t = (time - sample_times[floor_index]) / (sample_times[ceil_index] - sample_times[floor_index]);
+    }
+}
+
 }       // namespace foundation
 
 #endif  // !APPLESEED_FOUNDATION_MESH_ALEMBICMESHFILEREADER_H
@@ -43,6 +43,7 @@
 #include "boost/filesystem/path.hpp"
 
 // Standard headers.
+#include <memory>
 #include <string>
 
 using namespace std;
@@ -55,6 +56,12 @@ struct GenericMeshFileReader::Impl
 {
     string  m_filename;
     int     m_obj_options;
+    bool    m_has_sample_time;
+    double  m_sample_time;
+#ifdef APPLESEED_WITH_ALEMBIC
+    // Kept across reads so that the archive is only opened once.
+    auto_ptr<AlembicMeshFileReader> m_alembic_reader;
+#endif
 };
 
 GenericMeshFileReader::GenericMeshFileReader(const char* filename)
@@ -62,6 +69,8 @@ GenericMeshFileReader::GenericMeshFileReader(const char* filename)
 {
     impl->m_filename = filename;
     impl->m_obj_options = OBJMeshFileReader::Default;
+    impl->m_has_sample_time = false;
+    impl->m_sample_time = 0.0;
 }
 
 GenericMeshFileReader::~GenericMeshFileReader()
@@ -79,6 +88,12 @@ void GenericMeshFileReader::set_obj_options(const int obj_options)
     impl->m_obj_options = obj_options;
 }
 
+void GenericMeshFileReader::set_sample_time(const double time)
+{
+    impl->m_has_sample_time = true;
+    impl->m_sample_time = time;
+}
+
 void GenericMeshFileReader::read(IMeshBuilder& builder)
 {
     const bf::path filepath(impl->m_filename);
@@ -92,8 +107,11 @@ void GenericMeshFileReader::read(IMeshBuilder& builder)
 #ifdef APPLESEED_WITH_ALEMBIC
     else if (extension == ".abc")
     {
-        AlembicMeshFileReader reader(impl->m_filename);
-        reader.read(builder);
+        if (impl->m_alembic_reader.get() == 0)
+            impl->m_alembic_reader.reset(new AlembicMeshFileReader(impl->m_filename));
+        if (impl->m_has_sample_time)
+            impl->m_alembic_reader->set_sample_time(impl->m_sample_time);
+        impl->m_alembic_reader->read(builder);
     }
 #endif
     else if (extension == ".binarymesh")
@@ -60,7 +60,11 @@ class APPLESEED_DLLSYMBOL GenericMeshFileReader
     int get_obj_options() const;
     void set_obj_options(const int obj_options);
 
-    // Read a mesh.
+    // Set the time, in seconds, at which animated mesh files (currently Alembic files) are sampled.
+    void set_sample_time(const double time);
+
+    // Read a mesh. Calling this method several times (e.g. at different sample times)
+    // reuses the underlying reader when the file format allows it.
     virtual void read(IMeshBuilder& builder);
 
   private:
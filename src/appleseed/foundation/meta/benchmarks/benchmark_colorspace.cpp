@@ -30,12 +30,21 @@
 // appleseed.foundation headers.
 #include "foundation/image/color.h"
 #include "foundation/image/colorspace.h"
+#include "foundation/image/pixel.h"
 #include "foundation/image/regularspectrum.h"
 #include "foundation/math/rng/distribution.h"
 #include "foundation/math/rng/mersennetwister.h"
+#include "foundation/platform/types.h"
 #include "foundation/utility/benchmark.h"
 
+// OpenEXR headers.
+#include "foundation/platform/exrheaderguards.h"
+BEGIN_EXR_INCLUDES
+#include "OpenEXR/half.h"
+END_EXR_INCLUDES
+
 // Standard headers.
+#include <algorithm>
 #include <cstddef>
 
 using namespace foundation;
@@ -99,4 +108,129 @@ BENCHMARK_SUITE(Foundation_Image_ColorSpace)
     {
         linear_rgb_illuminance_to_spectrum(m_input, m_output);
     }
+
+    struct PixelArrayFixture
+    {
+        static const size_t PixelCount = 1024;
+        static const size_t ValueCount = PixelCount * 4;
+
+        Color4f     m_input[PixelCount];
+        Color4f     m_output[PixelCount];
+        uint8       m_uint8[ValueCount];
+        uint16      m_uint16[ValueCount];
+        half        m_half[ValueCount];
+
+        PixelArrayFixture()
+        {
+            MersenneTwister rng;
+
+            for (size_t i = 0; i < PixelCount; ++i)
+            {
+                m_input[i] =
+                    Color4f(
+                        rand_float1(rng),
+                        rand_float1(rng),
+                        rand_float1(rng),
+                        0.5f + 0.5f * rand_float1(rng));
+            }
+
+            std::copy(m_input, m_input + PixelCount, m_output);
+        }
+
+        const float* input_values() const
+        {
+            return &m_input[0][0];
+        }
+
+        // Convert each channel separately, which defeats the SIMD kernels.
+        template <typename T>
+        void convert_channels_separately(const PixelFormat dest_format, T* dest)
+        {
+            for (size_t c = 0; c < 4; ++c)
+            {
+                Pixel::convert_to_format(
+                    input_values() + c,
+                    input_values() + ValueCount + c,
+                    4,
+                    dest_format,
+                    dest + c,
+                    4);
+            }
+        }
+    };
+
+    BENCHMARK_CASE_F(LinearRGBTosRGBConversion_PixelByPixel, PixelArrayFixture)
+    {
+        std::copy(m_input, m_input + PixelCount, m_output);
+
+        for (size_t i = 0; i < PixelCount; ++i)
+            m_output[i].rgb() = fast_linear_rgb_to_srgb(m_output[i].rgb());
+    }
+
+    BENCHMARK_CASE_F(LinearRGBTosRGBConversion_Batch, PixelArrayFixture)
+    {
+        std::copy(m_input, m_input + PixelCount, m_output);
+        fast_linear_rgb_to_srgb(m_output, PixelCount);
+    }
+
+    BENCHMARK_CASE_F(LinearRGBToRec709Conversion_Batch, PixelArrayFixture)
+    {
+        std::copy(m_input, m_input + PixelCount, m_output);
+        fast_linear_rgb_to_rec709(m_output, PixelCount);
+    }
+
+    BENCHMARK_CASE_F(PremultiplyAndUnpremultiplyAlpha_PixelByPixel, PixelArrayFixture)
+    {
+        for (size_t i = 0; i < PixelCount; ++i)
+        {
+            m_output[i].rgb() *= m_output[i].a;
+            m_output[i].rgb() *= 1.0f / m_output[i].a;
+        }
+    }
+
+    BENCHMARK_CASE_F(PremultiplyAndUnpremultiplyAlpha_Batch, PixelArrayFixture)
+    {
+        premultiply_alpha(m_output, PixelCount);
+        unpremultiply_alpha(m_output, PixelCount);
+    }
+
+    BENCHMARK_CASE_F(FloatToUInt8Conversion_ChannelByChannel, PixelArrayFixture)
+    {
+        convert_channels_separately(PixelFormatUInt8, m_uint8);
+    }
+
+    BENCHMARK_CASE_F(FloatToUInt8Conversion_Contiguous, PixelArrayFixture)
+    {
+        Pixel::convert_to_format(input_values(), input_values() + ValueCount, 1, PixelFormatUInt8, m_uint8, 1);
+    }
+
+    BENCHMARK_CASE_F(FloatToUInt16Conversion_ChannelByChannel, PixelArrayFixture)
+    {
+        convert_channels_separately(PixelFormatUInt16, m_uint16);
+    }
+
+    BENCHMARK_CASE_F(FloatToUInt16Conversion_Contiguous, PixelArrayFixture)
+    {
+        Pixel::convert_to_format(input_values(), input_values() + ValueCount, 1, PixelFormatUInt16, m_uint16, 1);
+    }
+
+    BENCHMARK_CASE_F(FloatToHalfConversion_ChannelByChannel, PixelArrayFixture)
+    {
+        convert_channels_separately(PixelFormatHalf, m_half);
+    }
+
+    BENCHMARK_CASE_F(FloatToHalfConversion_Contiguous, PixelArrayFixture)
+    {
+        Pixel::convert_to_format(input_values(), input_values() + ValueCount, 1, PixelFormatHalf, m_half, 1);
+    }
+
+    BENCHMARK_CASE_F(UInt8ToFloatConversion_Contiguous, PixelArrayFixture)
+    {
+        Pixel::convert_from_format(PixelFormatUInt8, m_uint8, m_uint8 + ValueCount, 1, &m_output[0][0], 1);
+    }
+
+    BENCHMARK_CASE_F(HalfToFloatConversion_Contiguous, PixelArrayFixture)
+    {
+        Pixel::convert_from_format(PixelFormatHalf, m_half, m_half + ValueCount, 1, &m_output[0][0], 1);
+    }
 }
@@ -31,6 +31,7 @@
 #include "foundation/math/aabb.h"
 #include "foundation/math/intersection/rayaabb.h"
 #include "foundation/math/intersection/raytrianglemt.h"
+#include "foundation/math/intersection/raytrianglemt4.h"
 #include "foundation/math/intersection/raytrianglessk.h"
 #include "foundation/math/ray.h"
 #include "foundation/math/rng/distribution.h"
@@ -303,3 +304,107 @@ BENCHMARK_SUITE(Foundation_Math_Intersection_RayTriangleSSK)
     BENCHMARK_CASE_F(Intersect_DoublePrecision_HitRateIs66Percents, FixtureDouble66) { payload(); }
     BENCHMARK_CASE_F(Intersect_DoublePrecision_HitRateIs100Percents, FixtureDouble100) { payload(); }
 };
+
+BENCHMARK_SUITE(Foundation_Math_Intersection_RayTriangleLeaf)
+{
+    // Leaves of LeafSize single precision triangles (the storage format of triangle trees)
+    // intersected with double precision rays, either one triangle at a time or in groups.
+    template <size_t LeafSize>
+    struct Fixture
+      : public FixtureBase<double>
+    {
+        static const size_t RayCount = 1000;
+        static const size_t GroupCount = (LeafSize + 3) / 4;
+
+        TriangleMT<float>   m_triangles[LeafSize];
+        TriangleMT4<float>  m_groups[GroupCount];
+        Ray3d               m_ray[RayCount];
+
+        bool                m_hit;
+        double              m_t;
+        double              m_u;
+        double              m_v;
+
+        Fixture()
+          : m_hit(false)
+          , m_t(0.0)
+          , m_u(0.0)
+          , m_v(0.0)
+        {
+            MersenneTwister rng;
+
+            for (size_t i = 0; i < GroupCount; ++i)
+                m_groups[i].clear();
+
+            // Small triangles clustered in a unit box, as found in the leaves of a BVH.
+            for (size_t i = 0; i < LeafSize; ++i)
+            {
+                const Vector3d center = get_random_vector<3>(rng, -0.5, 0.5);
+                const Vector3d v0 = center + get_random_vector<3>(rng, -0.5, 0.5);
+                const Vector3d v1 = center + get_random_vector<3>(rng, -0.5, 0.5);
+                const Vector3d v2 = center + get_random_vector<3>(rng, -0.5, 0.5);
+
+                m_triangles[i] = TriangleMT<float>(Vector3f(v0), Vector3f(v1), Vector3f(v2));
+                m_groups[i / 4].set(i % 4, m_triangles[i]);
+            }
+
+            for (size_t i = 0; i < RayCount; ++i)
+                get_random_ray(rng, 10.0, m_ray[i]);
+        }
+
+        APPLESEED_FORCE_INLINE void sequential_payload()
+        {
+            for (size_t i = 0; i < RayCount; ++i)
+            {
+                Ray3d ray = m_ray[i];
+
+                for (size_t j = 0; j < LeafSize; ++j)
+                {
+                    const TriangleMT<double> triangle(m_triangles[j]);
+
+                    if (triangle.intersect(ray, m_t, m_u, m_v))
+                    {
+                        ray.m_tmax = m_t;
+                        m_hit = !m_hit;
+                    }
+                }
+            }
+        }
+
+        APPLESEED_FORCE_INLINE void grouped_payload()
+        {
+            for (size_t i = 0; i < RayCount; ++i)
+            {
+                Ray3d ray = m_ray[i];
+
+                for (size_t j = 0; j < GroupCount; ++j)
+                {
+                    double t[4], u[4], v[4];
+                    const int mask = m_groups[j].intersect(ray, t, u, v);
+
+                    for (size_t k = 0; k < 4; ++k)
+                    {
+                        if ((mask & (1 << k)) && t[k] < ray.m_tmax)
+                        {
+                            ray.m_tmax = m_t = t[k];
+                            m_u = u[k];
+                            m_v = v[k];
+                            m_hit = !m_hit;
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    BENCHMARK_CASE_F(Sequential_2Triangles, Fixture<2>) { sequential_payload(); }
+    BENCHMARK_CASE_F(Grouped_2Triangles, Fixture<2>) { grouped_payload(); }
+    BENCHMARK_CASE_F(Sequential_3Triangles, Fixture<3>) { sequential_payload(); }
+    BENCHMARK_CASE_F(Grouped_3Triangles, Fixture<3>) { grouped_payload(); }
+    BENCHMARK_CASE_F(Sequential_4Triangles, Fixture<4>) { sequential_payload(); }
+    BENCHMARK_CASE_F(Grouped_4Triangles, Fixture<4>) { grouped_payload(); }
+    BENCHMARK_CASE_F(Sequential_8Triangles, Fixture<8>) { sequential_payload(); }
+    BENCHMARK_CASE_F(Grouped_8Triangles, Fixture<8>) { grouped_payload(); }
+    BENCHMARK_CASE_F(Sequential_16Triangles, Fixture<16>) { sequential_payload(); }
+    BENCHMARK_CASE_F(Grouped_16Triangles, Fixture<16>) { grouped_payload(); }
+}
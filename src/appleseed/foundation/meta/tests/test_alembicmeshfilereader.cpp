@@ -0,0 +1,98 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.foundation headers.
+#include "foundation/mesh/alembicmeshfilereader.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+
+using namespace foundation;
+
+TEST_SUITE(Foundation_Mesh_AlembicMeshFileReader)
+{
+    const double SampleTimes[] = { 0.0, 1.0, 3.0 };
+    const size_t SampleCount = sizeof(SampleTimes) / sizeof(SampleTimes[0]);
+
+    TEST_CASE(FindBracketingSamples_GivenTimeBeforeFirstSample_ReturnsFirstSample)
+    {
+        size_t floor_index, ceil_index;
+        double t;
+        find_bracketing_samples(SampleTimes, SampleCount, -1.0, floor_index, ceil_index, t);
+
+        EXPECT_EQ(0, floor_index);
+        EXPECT_EQ(0, ceil_index);
+        EXPECT_EQ(0.0, t);
+    }
+
+    TEST_CASE(FindBracketingSamples_GivenTimeAfterLastSample_ReturnsLastSample)
+    {
+        size_t floor_index, ceil_index;
+        double t;
+        find_bracketing_samples(SampleTimes, SampleCount, 4.0, floor_index, ceil_index, t);
+
+        EXPECT_EQ(2, floor_index);
+        EXPECT_EQ(2, ceil_index);
+        EXPECT_EQ(0.0, t);
+    }
+
+    TEST_CASE(FindBracketingSamples_GivenTimeOfSample_ReturnsThisSampleAsFloorSample)
+    {
+        size_t floor_index, ceil_index;
+        double t;
+        find_bracketing_samples(SampleTimes, SampleCount, 1.0, floor_index, ceil_index, t);
+
+        EXPECT_EQ(1, floor_index);
+        EXPECT_EQ(2, ceil_index);
+        EXPECT_EQ(0.0, t);
+    }
+
+    TEST_CASE(FindBracketingSamples_GivenTimeBetweenSamples_ReturnsBracketingSamplesAndInterpolationParameter)
+    {
+        size_t floor_index, ceil_index;
+        double t;
+        find_bracketing_samples(SampleTimes, SampleCount, 1.5, floor_index, ceil_index, t);
+
+        EXPECT_EQ(1, floor_index);
+        EXPECT_EQ(2, ceil_index);
+        EXPECT_FEQ(0.25, t);
+    }
+
+    TEST_CASE(FindBracketingSamples_GivenSingleSample_ReturnsThisSample)
+    {
+        size_t floor_index, ceil_index;
+        double t;
+        find_bracketing_samples(SampleTimes, 1, 0.5, floor_index, ceil_index, t);
+
+        EXPECT_EQ(0, floor_index);
+        EXPECT_EQ(0, ceil_index);
+        EXPECT_EQ(0.0, t);
+    }
+}
@@ -0,0 +1,141 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.foundation headers.
+#include "foundation/math/aliastable.h"
+#include "foundation/math/fp.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
+using namespace foundation;
+using namespace std;
+
+TEST_SUITE(Foundation_Math_AliasTable)
+{
+    typedef AliasTable<int, double> AliasTableType;
+
+    TEST_CASE(Empty_GivenTableInInitialState_ReturnsTrue)
+    {
+        AliasTableType table;
+
+        EXPECT_TRUE(table.empty());
+    }
+
+    TEST_CASE(Valid_GivenTableWithOneItemWithZeroWeight_ReturnsFalse)
+    {
+        AliasTableType table;
+        table.insert(1, 0.0);
+
+        EXPECT_FALSE(table.valid());
+    }
+
+    TEST_CASE(Sample_GivenTableWithOneItemWithPositiveWeight_ReturnsItem)
+    {
+        AliasTableType table;
+        table.insert(1, 0.5);
+        table.prepare();
+
+        const AliasTableType::ItemWeightPair result = table.sample(0.5);
+
+        EXPECT_EQ(1, result.first);
+        EXPECT_FEQ(1.0, result.second);
+    }
+
+    TEST_CASE(Sample_GivenInputOneUlpBeforeOne_ReturnsValidItem)
+    {
+        AliasTableType table;
+        table.insert(1, 0.4);
+        table.insert(2, 1.6);
+        table.prepare();
+
+        const AliasTableType::ItemWeightPair result = table.sample(shift(1.0, -1));
+
+        EXPECT_EQ(2, result.first);
+        EXPECT_FEQ(0.8, result.second);
+    }
+
+    TEST_CASE(Sample_GivenItemsWithZeroWeight_NeverReturnsThem)
+    {
+        AliasTableType table;
+        table.insert(0, 0.0);
+        table.insert(1, 1.0);
+        table.insert(2, 0.0);
+        table.insert(3, 3.0);
+        table.insert(4, 0.0);
+        table.prepare();
+
+        const size_t SampleCount = 1000;
+
+        for (size_t i = 0; i < SampleCount; ++i)
+        {
+            const AliasTableType::ItemWeightPair& result =
+                table.sample(static_cast<double>(i) / SampleCount);
+
+            EXPECT_TRUE(result.first == 1 || result.first == 3);
+        }
+    }
+
+    TEST_CASE(Sample_GivenStratifiedInputs_ReturnsItemsProportionallyToTheirWeight)
+    {
+        static const double Weights[] = { 0.1, 2.0, 0.0, 0.7, 1.2, 0.5, 3.5, 2.0 };
+        const size_t ItemCount = sizeof(Weights) / sizeof(Weights[0]);
+
+        AliasTableType table;
+        double weight_sum = 0.0;
+        for (size_t i = 0; i < ItemCount; ++i)
+        {
+            table.insert(static_cast<int>(i), Weights[i]);
+            weight_sum += Weights[i];
+        }
+        table.prepare();
+
+        const size_t SampleCount = 100000;
+        vector<size_t> histogram(ItemCount, 0);
+
+        for (size_t i = 0; i < SampleCount; ++i)
+        {
+            const AliasTableType::ItemWeightPair& result =
+                table.sample((i + 0.5) / SampleCount);
+
+            EXPECT_FEQ(Weights[result.first] / weight_sum, result.second);
+
+            ++histogram[result.first];
+        }
+
+        for (size_t i = 0; i < ItemCount; ++i)
+        {
+            const double expected = Weights[i] / weight_sum;
+            const double actual = static_cast<double>(histogram[i]) / SampleCount;
+            EXPECT_FEQ_EPS(expected, actual, 1.0e-3);
+        }
+    }
+}
@@ -96,4 +96,64 @@ TEST_SUITE(Foundation_Utility_AttributeSet)
 
         EXPECT_EQ(RefUV, uv);
     }
+
+    TEST_CASE_F(DeleteChannel_PreservesIDsOfOtherChannels, FixtureTestAttributeSet)
+    {
+        const AttributeSet::ChannelID normal_id = attributes.create_channel("normal", NumericTypeFloat, 3);
+        const Vector3f RefNormal(0.0f, 1.0f, 0.0f);
+        attributes.push_attribute(normal_id, RefNormal);
+
+        attributes.delete_channel(uv_id);
+
+        EXPECT_TRUE(attributes.find_channel("uv") == AttributeSet::InvalidChannelID);
+        EXPECT_EQ(normal_id, attributes.find_channel("normal"));
+
+        Vector3f normal;
+        attributes.get_attribute<Vector3f>(normal_id, 0, &normal);
+
+        EXPECT_EQ(RefNormal, normal);
+    }
+
+    TEST_CASE_F(DeleteChannel_GivenMiddleChannel_RemainingChannelsReadBackTheirValues, FixtureTestAttributeSet)
+    {
+        const AttributeSet::ChannelID tangent_id = attributes.create_channel("tangent", NumericTypeFloat, 3);
+        const AttributeSet::ChannelID normal_id = attributes.create_channel("normal", NumericTypeFloat, 3);
+        const Vector2f RefUV(0.2f, 0.4f);
+        const Vector3f RefTangent(1.0f, 0.0f, 0.0f);
+        const Vector3f RefNormal(0.0f, 1.0f, 0.0f);
+        attributes.push_attribute(uv_id, RefUV);
+        attributes.push_attribute(tangent_id, RefTangent);
+        attributes.push_attribute(normal_id, RefNormal);
+
+        attributes.delete_channel(tangent_id);
+
+        Vector2f uv;
+        attributes.get_attribute<Vector2f>(uv_id, 0, &uv);
+        Vector3f normal;
+        attributes.get_attribute<Vector3f>(normal_id, 0, &normal);
+
+        EXPECT_EQ(RefUV, uv);
+        EXPECT_EQ(RefNormal, normal);
+        EXPECT_EQ(1, attributes.get_attribute_count(normal_id));
+    }
+
+    TEST_CASE_F(CreateChannel_AfterDeleteChannel_ReusesSlotWithoutAffectingOtherChannels, FixtureTestAttributeSet)
+    {
+        const AttributeSet::ChannelID normal_id = attributes.create_channel("normal", NumericTypeFloat, 3);
+        const Vector3f RefNormal(0.0f, 1.0f, 0.0f);
+        attributes.push_attribute(normal_id, RefNormal);
+
+        attributes.delete_channel(uv_id);
+        const AttributeSet::ChannelID color_id = attributes.create_channel("color", NumericTypeFloat, 3);
+        attributes.push_attribute(color_id, Vector3f(0.5f));
+
+        EXPECT_EQ(uv_id, color_id);
+        EXPECT_EQ(color_id, attributes.find_channel("color"));
+        EXPECT_EQ(1, attributes.get_attribute_count(normal_id));
+
+        Vector3f normal;
+        attributes.get_attribute<Vector3f>(normal_id, 0, &normal);
+
+        EXPECT_EQ(RefNormal, normal);
+    }
 }
@@ -0,0 +1,102 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.foundation headers.
+#include "foundation/utility/benchmark/benchmarkbaseline.h"
+#include "foundation/utility/test.h"
+
+using namespace foundation;
+
+TEST_SUITE(Foundation_Utility_Benchmark_BenchmarkBaseline)
+{
+    TEST_CASE(Load_GivenNonExistingFile_ReturnsFalse)
+    {
+        BenchmarkBaseline baseline;
+        const bool result = baseline.load("unit tests/inputs/test_benchmarkbaseline/non existing file.xml");
+
+        EXPECT_FALSE(result);
+        EXPECT_EQ(0, baseline.size());
+    }
+
+    TEST_CASE(Load_GivenBenchmarkFile_LoadsAllResults)
+    {
+        BenchmarkBaseline baseline;
+        const bool result = baseline.load("unit tests/inputs/test_benchmarkbaseline/baseline.xml");
+
+        EXPECT_TRUE(result);
+        EXPECT_EQ(3, baseline.size());
+    }
+
+    TEST_CASE(GetSeconds_GivenMedianTicks_ReturnsMedianRunningTime)
+    {
+        BenchmarkBaseline baseline;
+        baseline.load("unit tests/inputs/test_benchmarkbaseline/baseline.xml");
+
+        double seconds = 0.0;
+        const bool found = baseline.get_seconds("Suite", "Case1", 1, seconds);
+
+        EXPECT_TRUE(found);
+        EXPECT_FEQ(400.0e-9, seconds);
+    }
+
+    TEST_CASE(GetSeconds_GivenThreadCount_ReturnsRunningTimeForThisThreadCount)
+    {
+        BenchmarkBaseline baseline;
+        baseline.load("unit tests/inputs/test_benchmarkbaseline/baseline.xml");
+
+        double seconds = 0.0;
+        const bool found = baseline.get_seconds("Suite", "Case1", 4, seconds);
+
+        EXPECT_TRUE(found);
+        EXPECT_FEQ(500.0e-9, seconds);
+    }
+
+    TEST_CASE(GetSeconds_GivenResultsWithoutThreadCountNorMedian_ReturnsSingleThreadedAverageRunningTime)
+    {
+        BenchmarkBaseline baseline;
+        baseline.load("unit tests/inputs/test_benchmarkbaseline/baseline.xml");
+
+        double seconds = 0.0;
+        const bool found = baseline.get_seconds("Suite", "Case2", 1, seconds);
+
+        EXPECT_TRUE(found);
+        EXPECT_FEQ(500.0e-9, seconds);
+    }
+
+    TEST_CASE(GetSeconds_GivenUnknownThreadCount_ReturnsFalse)
+    {
+        BenchmarkBaseline baseline;
+        baseline.load("unit tests/inputs/test_benchmarkbaseline/baseline.xml");
+
+        double seconds = 0.0;
+        const bool found = baseline.get_seconds("Suite", "Case1", 2, seconds);
+
+        EXPECT_FALSE(found);
+    }
+}
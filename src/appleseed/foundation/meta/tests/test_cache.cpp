@@ -103,6 +103,22 @@ TEST_SUITE(Foundation_Utility_Cache_SACache)
         EXPECT_EQ(3, element_swapper.m_unload_count);
     }
 
+    TEST_CASE(Clear_UnloadsElementsStillInCache)
+    {
+        KeyHasher key_hasher;
+        ElementSwapperCountingUnloads element_swapper;
+        SACache<Key, KeyHasher, Element, ElementSwapperCountingUnloads, 4, 1> cache(
+            key_hasher,
+            element_swapper,
+            InvalidKey);
+
+        cache.get(1);
+        cache.get(2);
+        cache.clear();
+
+        EXPECT_EQ(2, element_swapper.m_unload_count);
+    }
+
     TEST_CASE(Get_DoesNotCallUnloadOnEmptyCacheLine)
     {
         KeyHasher key_hasher;
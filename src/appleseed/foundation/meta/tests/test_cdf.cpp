@@ -152,6 +152,25 @@ TEST_SUITE(Foundation_Math_CDF)
         EXPECT_FEQ(0.8, result.second);
     }
 
+    TEST_CASE_F(Sample_GivenInputInsideItem2_ReturnsRescaledResidual, Fixture)
+    {
+        double y;
+        const CDF::ItemWeightPair result = m_cdf.sample(0.6, y);
+
+        EXPECT_EQ(2, result.first);
+        EXPECT_FEQ(0.5, y);
+    }
+
+    TEST_CASE_F(Sample_GivenInputOneUlpBeforeOne_ReturnsResidualBelowOne, Fixture)
+    {
+        const double almost_one = shift(1.0, -1);
+
+        double y;
+        m_cdf.sample(almost_one, y);
+
+        EXPECT_LT(1.0, y);
+    }
+
     TEST_CASE(TwoDimensional_CDF_Exploration)
     {
         CDF child[2];
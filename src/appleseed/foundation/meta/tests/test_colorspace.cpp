@@ -178,6 +178,103 @@ TEST_SUITE(Foundation_Image_ColorSpace)
             1.0e-5f);
     }
 
+    TEST_CASE(TestLinearRGBToRec709Conversion)
+    {
+        EXPECT_FEQ(0.0045f, linear_rgb_to_rec709(0.001f));
+        EXPECT_FEQ_EPS(0.705515f, linear_rgb_to_rec709(0.5f), 1.0e-5f);
+        EXPECT_FEQ(1.0f, linear_rgb_to_rec709(1.0f));
+    }
+
+    TEST_CASE(TestRec709ToLinearRGBConversion)
+    {
+        EXPECT_FEQ(0.001f, rec709_to_linear_rgb(0.0045f));
+        EXPECT_FEQ_EPS(0.5f, rec709_to_linear_rgb(0.705515f), 1.0e-5f);
+        EXPECT_FEQ(1.0f, rec709_to_linear_rgb(1.0f));
+    }
+
+    TEST_CASE(TestFastLinearRGBToRec709Conversion)
+    {
+        EXPECT_FEQ_EPS(0.705515f, fast_linear_rgb_to_rec709(0.5f), 1.0e-4f);
+    }
+
+    // Batch transformations process 4 pixels at a time with SSE; use an odd number of pixels.
+    const size_t PixelCount = 5;
+
+    static void get_rgba_pixels(Color4f pixels[])
+    {
+        pixels[0] = Color4f(0.5f, 0.7f, 0.2f, 1.0f);
+        pixels[1] = Color4f(0.0f, 0.001f, 1.0f, 0.5f);
+        pixels[2] = Color4f(0.25f, 0.3f, 0.9f, 0.0f);
+        pixels[3] = Color4f(2.0f, 0.1f, 0.02f, 0.25f);
+        pixels[4] = Color4f(0.8f, 0.6f, 0.4f, 0.75f);
+    }
+
+    TEST_CASE(TestBatchFastLinearRGBTosRGBConversion)
+    {
+        Color4f pixels[PixelCount];
+        get_rgba_pixels(pixels);
+
+        fast_linear_rgb_to_srgb(pixels, PixelCount);
+
+        Color4f expected[PixelCount];
+        get_rgba_pixels(expected);
+
+        for (size_t i = 0; i < PixelCount; ++i)
+        {
+            expected[i].rgb() = linear_rgb_to_srgb(expected[i].rgb());
+            EXPECT_FEQ_EPS(expected[i], pixels[i], 1.0e-4f);
+        }
+    }
+
+    TEST_CASE(TestBatchFastLinearRGBToRec709Conversion)
+    {
+        Color4f pixels[PixelCount];
+        get_rgba_pixels(pixels);
+
+        fast_linear_rgb_to_rec709(pixels, PixelCount);
+
+        Color4f expected[PixelCount];
+        get_rgba_pixels(expected);
+
+        for (size_t i = 0; i < PixelCount; ++i)
+        {
+            expected[i][0] = linear_rgb_to_rec709(expected[i][0]);
+            expected[i][1] = linear_rgb_to_rec709(expected[i][1]);
+            expected[i][2] = linear_rgb_to_rec709(expected[i][2]);
+            EXPECT_FEQ_EPS(expected[i], pixels[i], 1.0e-4f);
+        }
+    }
+
+    TEST_CASE(TestBatchPremultiplyAlpha)
+    {
+        Color4f pixels[PixelCount];
+        get_rgba_pixels(pixels);
+
+        premultiply_alpha(pixels, PixelCount);
+
+        EXPECT_FEQ(Color4f(0.5f, 0.7f, 0.2f, 1.0f), pixels[0]);
+        EXPECT_FEQ(Color4f(0.0f, 0.0005f, 0.5f, 0.5f), pixels[1]);
+        EXPECT_FEQ(Color4f(0.0f, 0.0f, 0.0f, 0.0f), pixels[2]);
+        EXPECT_FEQ(Color4f(0.5f, 0.025f, 0.005f, 0.25f), pixels[3]);
+        EXPECT_FEQ(Color4f(0.6f, 0.45f, 0.3f, 0.75f), pixels[4]);
+    }
+
+    TEST_CASE(TestBatchUnpremultiplyAlpha)
+    {
+        Color4f pixels[PixelCount];
+        get_rgba_pixels(pixels);
+
+        premultiply_alpha(pixels, PixelCount);
+        unpremultiply_alpha(pixels, PixelCount);
+
+        Color4f expected[PixelCount];
+        get_rgba_pixels(expected);
+        expected[2] = Color4f(0.0f);
+
+        for (size_t i = 0; i < PixelCount; ++i)
+            EXPECT_FEQ(expected[i], pixels[i]);
+    }
+
     static RegularSpectrum31f get_white_spectrum()
     {
         // The white color from the Cornell Box scene.
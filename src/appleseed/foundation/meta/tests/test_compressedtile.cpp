@@ -0,0 +1,89 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.foundation headers.
+#include "foundation/image/color.h"
+#include "foundation/image/compressedtile.h"
+#include "foundation/image/pixel.h"
+#include "foundation/image/tile.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+using namespace foundation;
+using namespace std;
+
+TEST_SUITE(Foundation_Image_CompressedTile)
+{
+    const size_t TileWidth = 32;
+    const size_t TileHeight = 32;
+
+    TEST_CASE(Decompress_ReturnsIdenticalTile)
+    {
+        Tile tile(TileWidth, TileHeight, 4, PixelFormatFloat);
+
+        for (size_t y = 0; y < TileHeight; ++y)
+        {
+            for (size_t x = 0; x < TileWidth; ++x)
+            {
+                tile.set_pixel(
+                    x, y,
+                    Color4f(
+                        static_cast<float>(x) / TileWidth,
+                        static_cast<float>(y) / TileHeight,
+                        0.5f,
+                        1.0f));
+            }
+        }
+
+        const CompressedTile compressed_tile(tile);
+        const auto_ptr<Tile> result(compressed_tile.decompress());
+
+        EXPECT_EQ(TileWidth, result->get_width());
+        EXPECT_EQ(TileHeight, result->get_height());
+        EXPECT_EQ(4, result->get_channel_count());
+        EXPECT_EQ(PixelFormatFloat, result->get_pixel_format());
+        EXPECT_EQ(0, memcmp(tile.get_storage(), result->get_storage(), tile.get_size()));
+    }
+
+    TEST_CASE(Constructor_GivenUniformTile_CompressesPixels)
+    {
+        Tile tile(TileWidth, TileHeight, 3, PixelFormatUInt8);
+
+        for (size_t i = 0; i < TileWidth * TileHeight; ++i)
+            tile.set_pixel(i, Color3f(0.2f, 0.4f, 0.6f));
+
+        const CompressedTile compressed_tile(tile);
+
+        EXPECT_LT(tile.get_size() / 10, compressed_tile.get_compressed_size());
+    }
+}
@@ -29,6 +29,7 @@
 
 // appleseed.foundation headers.
 #include "foundation/math/intersection/raytrianglemt.h"
+#include "foundation/math/intersection/raytrianglemt4.h"
 #include "foundation/math/intersection/raytrianglessk.h"
 #include "foundation/math/ray.h"
 #include "foundation/math/vector.h"
@@ -166,3 +167,83 @@ TEST_SUITE(Foundation_Math_Intersection_RayTriangleSSK)
         EXPECT_FEQ(0.5, v);
     }
 }
+
+TEST_SUITE(Foundation_Math_Intersection_RayTriangleMT4)
+{
+    struct Fixture
+    {
+        TriangleMT4<float>  m_group;
+
+        Fixture()
+        {
+            m_group.clear();
+
+            // Two triangles forming a quad in the y = 0 plane.
+            m_group.set(
+                0,
+                TriangleMT<double>(
+                    Vector3d(0.5, 0.0, 0.5),
+                    Vector3d(-0.5, 0.0, 0.5),
+                    Vector3d(-0.5, 0.0, -0.5)));
+            m_group.set(
+                1,
+                TriangleMT<double>(
+                    Vector3d(0.5, 0.0, 0.5),
+                    Vector3d(-0.5, 0.0, -0.5),
+                    Vector3d(0.5, 0.0, -0.5)));
+
+            // The same first triangle, with opposite winding, in the y = -1 plane.
+            m_group.set(
+                2,
+                TriangleMT<double>(
+                    Vector3d(0.5, -1.0, 0.5),
+                    Vector3d(-0.5, -1.0, -0.5),
+                    Vector3d(-0.5, -1.0, 0.5)));
+        }
+    };
+
+    TEST_CASE_F(Intersect_GivenRayHittingTwoTriangles_ReturnsBothHits, Fixture)
+    {
+        const Ray3d ray(Vector3d(-0.2, 1.0, 0.2), Vector3d(0.0, -1.0, 0.0));
+
+        double t[4], u[4], v[4];
+        const int mask = m_group.intersect(ray, t, u, v);
+
+        ASSERT_EQ(1 | 4, mask);
+        EXPECT_FEQ(1.0, t[0]);
+        EXPECT_FEQ(2.0, t[2]);
+    }
+
+    TEST_CASE_F(Intersect_GivenRayWithTMinBeyondNearHit_ReturnsFarHitOnly, Fixture)
+    {
+        const Ray3d ray(Vector3d(-0.2, 1.0, 0.2), Vector3d(0.0, -1.0, 0.0), 1.5, 10.0);
+
+        const int mask = m_group.intersect(ray);
+
+        ASSERT_EQ(4, mask);
+    }
+
+    TEST_CASE_F(Intersect_GivenRay_MatchesTriangleMT, Fixture)
+    {
+        const Ray3d ray(Vector3d(0.3, 1.0, -0.1), Vector3d(0.0, -1.0, 0.0));
+
+        double t[4], u[4], v[4];
+        const int mask = m_group.intersect(ray, t, u, v);
+
+        for (size_t i = 0; i < 4; ++i)
+        {
+            double expected_t, expected_u, expected_v;
+            const TriangleMT<double> triangle(m_group.get(i));
+            const bool hit = triangle.intersect(ray, expected_t, expected_u, expected_v);
+
+            ASSERT_EQ(hit, (mask & (1 << i)) != 0);
+
+            if (hit)
+            {
+                EXPECT_EQ(expected_t, t[i]);
+                EXPECT_EQ(expected_u, u[i]);
+                EXPECT_EQ(expected_v, v[i]);
+            }
+        }
+    }
+}
@@ -30,8 +30,11 @@
 // appleseed.foundation headers.
 #include "foundation/utility/lazy.h"
 #include "foundation/utility/test.h"
+#include "foundation/utility/uid.h"
 
 // Standard headers.
+#include <cstddef>
+#include <map>
 #include <memory>
 
 using namespace foundation;
@@ -47,6 +50,11 @@ namespace
           : m_value(value)
         {
         }
+
+        size_t get_memory_size() const
+        {
+            return 100;
+        }
     };
 
     typedef ILazyFactory<Object> ObjectFactory;
@@ -130,3 +138,198 @@ TEST_SUITE(Foundation_Utility_Lazy_Update)
         EXPECT_EQ(0, access.get());
     }
 }
+
+TEST_SUITE(Foundation_Utility_Lazy_Evict)
+{
+    TEST_CASE(Evict_GivenUnreferencedObjectCreatedByFactory_DeletesObject)
+    {
+        auto_ptr<ObjectFactory> factory(new SimpleObjectFactory(42));
+        Lazy<Object> object(factory);
+
+        {
+            Access<Object> access(&object);
+        }
+
+        ASSERT_TRUE(object.evict());
+
+        Update<Object> update(&object);
+        EXPECT_EQ(0, update.get());
+    }
+
+    TEST_CASE(Evict_GivenReferencedObject_ReturnsFalse)
+    {
+        auto_ptr<ObjectFactory> factory(new SimpleObjectFactory(42));
+        Lazy<Object> object(factory);
+
+        Access<Object> access(&object);
+
+        EXPECT_FALSE(object.evict());
+        EXPECT_EQ(42, access->m_value);
+    }
+
+    TEST_CASE(Evict_GivenSourceObject_ReturnsFalse)
+    {
+        Object source(42);
+        Lazy<Object> object(&source);
+
+        {
+            Access<Object> access(&object);
+        }
+
+        EXPECT_FALSE(object.evict());
+    }
+
+    TEST_CASE(Access_GivenEvictedObject_RecreatesObject)
+    {
+        auto_ptr<ObjectFactory> factory(new SimpleObjectFactory(42));
+        Lazy<Object> object(factory);
+
+        {
+            Access<Object> access(&object);
+        }
+
+        object.evict();
+
+        Access<Object> access(&object);
+        EXPECT_EQ(42, access->m_value);
+    }
+}
+
+TEST_SUITE(Foundation_Utility_LazyPager)
+{
+    TEST_CASE(Access_GivenBudgetExceeded_EvictsLeastRecentlyAccessedUnreferencedObject)
+    {
+        LazyPager<Object> pager(250);
+
+        auto_ptr<ObjectFactory> factory1(new SimpleObjectFactory(1));
+        auto_ptr<ObjectFactory> factory2(new SimpleObjectFactory(2));
+        auto_ptr<ObjectFactory> factory3(new SimpleObjectFactory(3));
+        Lazy<Object> object1(factory1);
+        Lazy<Object> object2(factory2);
+        Lazy<Object> object3(factory3);
+        object1.set_pager(&pager);
+        object2.set_pager(&pager);
+        object3.set_pager(&pager);
+
+        {
+            Access<Object> access1(&object1);
+            Access<Object> access2(&object2);
+        }
+
+        Access<Object> access3(&object3);
+
+        EXPECT_EQ(200, pager.get_memory_size());
+        EXPECT_EQ(1, pager.get_eviction_count());
+        EXPECT_EQ(0, Update<Object>(&object1).get());
+        EXPECT_NEQ(0, Update<Object>(&object2).get());
+    }
+
+    TEST_CASE(Access_GivenBudgetExceededByReferencedObjects_KeepsObjects)
+    {
+        LazyPager<Object> pager(150);
+
+        auto_ptr<ObjectFactory> factory1(new SimpleObjectFactory(1));
+        auto_ptr<ObjectFactory> factory2(new SimpleObjectFactory(2));
+        Lazy<Object> object1(factory1);
+        Lazy<Object> object2(factory2);
+        object1.set_pager(&pager);
+        object2.set_pager(&pager);
+
+        Access<Object> access1(&object1);
+        Access<Object> access2(&object2);
+
+        EXPECT_EQ(200, pager.get_memory_size());
+        EXPECT_EQ(0, pager.get_eviction_count());
+        EXPECT_EQ(1, access1->m_value);
+        EXPECT_EQ(2, access2->m_value);
+    }
+
+    TEST_CASE(Destructor_GivenPagedObject_RemovesObjectFromPager)
+    {
+        LazyPager<Object> pager(0);
+
+        {
+            auto_ptr<ObjectFactory> factory(new SimpleObjectFactory(42));
+            Lazy<Object> object(factory);
+            object.set_pager(&pager);
+
+            Access<Object> access(&object);
+            EXPECT_EQ(100, pager.get_memory_size());
+        }
+
+        EXPECT_EQ(0, pager.get_memory_size());
+    }
+
+    TEST_CASE(Release_GivenBudgetExceeded_EvictsReleasedObject)
+    {
+        LazyPager<Object> pager(150);
+
+        auto_ptr<ObjectFactory> factory1(new SimpleObjectFactory(1));
+        auto_ptr<ObjectFactory> factory2(new SimpleObjectFactory(2));
+        Lazy<Object> object1(factory1);
+        Lazy<Object> object2(factory2);
+        object1.set_pager(&pager);
+        object2.set_pager(&pager);
+
+        Access<Object> access2;
+
+        {
+            Access<Object> access1(&object1);
+            access2.reset(&object2);
+            EXPECT_EQ(0, pager.get_eviction_count());
+        }
+
+        EXPECT_EQ(100, pager.get_memory_size());
+        EXPECT_EQ(1, pager.get_eviction_count());
+        EXPECT_EQ(2, access2->m_value);
+    }
+
+    TEST_CASE(Access_GivenBudgetExceededByReferencedObjects_IncrementsFlushEpoch)
+    {
+        LazyPager<Object> pager(150);
+
+        auto_ptr<ObjectFactory> factory1(new SimpleObjectFactory(1));
+        auto_ptr<ObjectFactory> factory2(new SimpleObjectFactory(2));
+        Lazy<Object> object1(factory1);
+        Lazy<Object> object2(factory2);
+        object1.set_pager(&pager);
+        object2.set_pager(&pager);
+
+        Access<Object> access1(&object1);
+        const uint32 flush_epoch = pager.get_flush_epoch();
+        Access<Object> access2(&object2);
+
+        EXPECT_NEQ(flush_epoch, pager.get_flush_epoch());
+    }
+
+    TEST_CASE(AccessCacheMapAccess_AfterFlushRequest_ReleasesCachedObjects)
+    {
+        typedef map<UniqueID, Lazy<Object>*> ObjectMap;
+
+        LazyPager<Object> pager(150);
+
+        auto_ptr<ObjectFactory> factory1(new SimpleObjectFactory(1));
+        auto_ptr<ObjectFactory> factory2(new SimpleObjectFactory(2));
+        Lazy<Object> object1(factory1);
+        Lazy<Object> object2(factory2);
+        object1.set_pager(&pager);
+        object2.set_pager(&pager);
+
+        ObjectMap objects;
+        objects[1] = &object1;
+        objects[2] = &object2;
+
+        AccessCacheMap<ObjectMap, 4> cache;
+        cache.set_pager(&pager);
+
+        // Both objects are kept alive by the cache, exceeding the budget.
+        EXPECT_EQ(1, cache.access(1, objects)->m_value);
+        EXPECT_EQ(2, cache.access(2, objects)->m_value);
+        EXPECT_EQ(200, pager.get_memory_size());
+
+        // The next access drops the cached accesses, letting the pager evict objects.
+        EXPECT_EQ(2, cache.access(2, objects)->m_value);
+        EXPECT_EQ(100, pager.get_memory_size());
+        EXPECT_EQ(0, Update<Object>(&object1).get());
+    }
+}
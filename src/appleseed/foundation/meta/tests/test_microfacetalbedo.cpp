@@ -0,0 +1,147 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.foundation headers.
+#include "foundation/math/microfacetalbedo.h"
+#include "foundation/math/qmc.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cmath>
+#include <cstddef>
+
+using namespace foundation;
+using namespace std;
+
+TEST_SUITE(Foundation_Math_MicrofacetAlbedo)
+{
+    // Isotropic Blinn distribution with normals sampled proportionally to D(h) * cos(h).
+    class BlinnMDFAdapter
+    {
+      public:
+        explicit BlinnMDFAdapter(const float e)
+          : m_e(e)
+        {
+        }
+
+        Vector3f sample(const Vector2f& s) const
+        {
+            const float cos_theta = pow(1.0f - s[0], 1.0f / (m_e + 2.0f));
+            const float sin_theta = sqrt(1.0f - cos_theta * cos_theta);
+            const float phi = TwoPi<float>() * s[1];
+            return Vector3f::make_unit_vector(cos_theta, sin_theta, cos(phi), sin(phi));
+        }
+
+        float evaluate(const float cos_alpha) const
+        {
+            return (m_e + 2.0f) * RcpTwoPi<float>() * pow(cos_alpha, m_e);
+        }
+
+        float evaluate_pdf(const float cos_alpha) const
+        {
+            return evaluate(cos_alpha) * cos_alpha;
+        }
+
+      private:
+        const float m_e;
+    };
+
+    // Estimate the albedo for a given outgoing direction by evaluating the Schlick Fresnel term directly.
+    float estimate_albedo(
+        const BlinnMDFAdapter&  mdf,
+        const float             f0,
+        const Vector3f&         V,
+        const size_t            sample_count)
+    {
+        float albedo = 0.0f;
+
+        for (size_t i = 0; i < sample_count; ++i)
+        {
+            static const size_t Bases[] = { 2 };
+            const Vector2f s = hammersley_sequence<float, 2>(Bases, sample_count, i);
+
+            const Vector3f H = mdf.sample(s);
+            const float dot_HV = dot(H, V);
+            if (dot_HV <= 0.0f)
+                continue;
+
+            const Vector3f L = (dot_HV + dot_HV) * H - V;
+            if (L.y <= 0.0f)
+                continue;
+
+            const float pdf_L = mdf.evaluate_pdf(H.y) / (4.0f * dot_HV);
+            if (pdf_L == 0.0f)
+                continue;
+
+            const float fresnel = f0 + (1.0f - f0) * pow(1.0f - dot_HV, 5.0f);
+            albedo += fresnel * (L.y * mdf.evaluate(H.y)) / (4.0f * pdf_L * dot_HV * dot_HV);
+        }
+
+        return albedo / sample_count;
+    }
+
+    TEST_CASE(GetAlbedo_MatchesDirectEstimate)
+    {
+        const BlinnMDFAdapter mdf(20.0f);
+        const MicrofacetAlbedoTable<float> table(mdf, 8, 256);
+
+        for (size_t i = 0; i < table.size(); ++i)
+        {
+            const float cos_theta = table.get_cos_theta(i);
+            const Vector3f V(sqrt(1.0f - cos_theta * cos_theta), cos_theta, 0.0f);
+
+            float albedo;
+            table.get_albedo(i, 0.3f, albedo);
+
+            EXPECT_FEQ_EPS(estimate_albedo(mdf, 0.3f, V, 256), albedo, 1.0e-4f);
+        }
+    }
+
+    TEST_CASE(Get_GivenSameRoughness_ReturnsSameTable)
+    {
+        const MicrofacetAlbedoTableCache::TableType& table1 =
+            MicrofacetAlbedoTableCache::get(BlinnMDFAdapter(10.0f), 10.0f, 8, 64);
+        const MicrofacetAlbedoTableCache::TableType& table2 =
+            MicrofacetAlbedoTableCache::get(BlinnMDFAdapter(10.0f), 10.0f, 8, 64);
+
+        EXPECT_EQ(&table1, &table2);
+    }
+
+    TEST_CASE(Get_GivenDifferentRoughnesses_ReturnsDifferentTables)
+    {
+        const MicrofacetAlbedoTableCache::TableType& table1 =
+            MicrofacetAlbedoTableCache::get(BlinnMDFAdapter(10.0f), 10.0f, 8, 64);
+        const MicrofacetAlbedoTableCache::TableType& table2 =
+            MicrofacetAlbedoTableCache::get(BlinnMDFAdapter(20.0f), 20.0f, 8, 64);
+
+        EXPECT_NEQ(&table1, &table2);
+    }
+}
@@ -0,0 +1,93 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.foundation headers.
+#include "foundation/math/octahedral.h"
+#include "foundation/math/rng/distribution.h"
+#include "foundation/math/rng/mersennetwister.h"
+#include "foundation/math/sampling/mappings.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+
+using namespace foundation;
+using namespace std;
+
+TEST_SUITE(Foundation_Math_Octahedral)
+{
+    bool round_trips(const Vector3d& v)
+    {
+        const Vector3d result = decode_octahedral<double>(encode_octahedral(v));
+        return norm(result - v) < 1.0e-4;
+    }
+
+    TEST_CASE(EncodeDecode_AxisAlignedVectors_ReturnsExactVectors)
+    {
+        EXPECT_EQ(Vector3d(1.0, 0.0, 0.0), decode_octahedral<double>(encode_octahedral(Vector3d(1.0, 0.0, 0.0))));
+        EXPECT_EQ(Vector3d(-1.0, 0.0, 0.0), decode_octahedral<double>(encode_octahedral(Vector3d(-1.0, 0.0, 0.0))));
+        EXPECT_EQ(Vector3d(0.0, 1.0, 0.0), decode_octahedral<double>(encode_octahedral(Vector3d(0.0, 1.0, 0.0))));
+        EXPECT_EQ(Vector3d(0.0, -1.0, 0.0), decode_octahedral<double>(encode_octahedral(Vector3d(0.0, -1.0, 0.0))));
+        EXPECT_EQ(Vector3d(0.0, 0.0, 1.0), decode_octahedral<double>(encode_octahedral(Vector3d(0.0, 0.0, 1.0))));
+        EXPECT_EQ(Vector3d(0.0, 0.0, -1.0), decode_octahedral<double>(encode_octahedral(Vector3d(0.0, 0.0, -1.0))));
+    }
+
+    TEST_CASE(EncodeDecode_RandomUnitVectors_ReturnsNearlyIdenticalVectors)
+    {
+        MersenneTwister rng;
+
+        for (size_t i = 0; i < 10000; ++i)
+        {
+            Vector2d s;
+            s[0] = rand_double2(rng);
+            s[1] = rand_double2(rng);
+
+            const Vector3d v = sample_sphere_uniform(s);
+
+            EXPECT_TRUE(round_trips(v));
+        }
+    }
+
+    TEST_CASE(EncodeDecode_ZeroVector_ReturnsPositiveZAxis)
+    {
+        EXPECT_EQ(Vector3d(0.0, 0.0, 1.0), decode_octahedral<double>(encode_octahedral(Vector3d(0.0))));
+        EXPECT_EQ(Vector3f(0.0f, 0.0f, 1.0f), decode_octahedral<float>(encode_octahedral(Vector3f(0.0f))));
+    }
+
+    TEST_CASE(Decode_ReturnsUnitVector)
+    {
+        const Vector3f v = decode_octahedral<float>(encode_octahedral(normalize(Vector3f(0.3f, -0.5f, -0.8f))));
+
+        EXPECT_FEQ(1.0f, norm(v));
+    }
+}
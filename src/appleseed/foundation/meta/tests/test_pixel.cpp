@@ -38,6 +38,9 @@ BEGIN_EXR_INCLUDES
 #include "OpenEXR/half.h"
 END_EXR_INCLUDES
 
+// Standard headers.
+#include <cstddef>
+
 using namespace foundation;
 
 TEST_SUITE(Foundation_Image_Pixel)
@@ -101,4 +104,135 @@ TEST_SUITE(Foundation_Image_Pixel)
 
         EXPECT_EQ(4294967295UL, output);
     }
+
+    // Contiguous conversions go through the SIMD kernels, conversions of single values don't.
+    // Use a number of values that is not a multiple of the SIMD width.
+    const size_t ValueCount = 11;
+
+    const float FloatValues[ValueCount] =
+    {
+        -1.0f, 0.0f, 0.001f, 0.1f, 0.25f, 0.5f, 0.7f, 0.999f, 1.0f, 1.5f, 65504.0f
+    };
+
+    template <typename T>
+    void convert_float_values(const PixelFormat dest_format, T contiguous[], T one_by_one[])
+    {
+        Pixel::convert_to_format(
+            FloatValues, FloatValues + ValueCount,
+            1,
+            dest_format,
+            contiguous,
+            1);
+
+        for (size_t i = 0; i < ValueCount; ++i)
+        {
+            Pixel::convert_to_format(
+                FloatValues + i, FloatValues + i + 1,
+                1,
+                dest_format,
+                one_by_one + i,
+                1);
+        }
+    }
+
+    template <typename T>
+    void convert_to_float_values(const PixelFormat src_format, const T input[], float contiguous[], float one_by_one[])
+    {
+        Pixel::convert_from_format(
+            src_format,
+            input, input + ValueCount,
+            1,
+            contiguous,
+            1);
+
+        for (size_t i = 0; i < ValueCount; ++i)
+        {
+            Pixel::convert_from_format(
+                src_format,
+                input + i, input + i + 1,
+                1,
+                one_by_one + i,
+                1);
+        }
+    }
+
+    TEST_CASE(ConvertToFormat_FloatToUInt8_ContiguousValues_MatchesConversionOfSingleValues)
+    {
+        uint8 contiguous[ValueCount], one_by_one[ValueCount];
+        convert_float_values(PixelFormatUInt8, contiguous, one_by_one);
+
+        EXPECT_SEQUENCE_EQ(ValueCount, one_by_one, contiguous);
+    }
+
+    TEST_CASE(ConvertToFormat_FloatToUInt16_ContiguousValues_MatchesConversionOfSingleValues)
+    {
+        uint16 contiguous[ValueCount], one_by_one[ValueCount];
+        convert_float_values(PixelFormatUInt16, contiguous, one_by_one);
+
+        EXPECT_SEQUENCE_EQ(ValueCount, one_by_one, contiguous);
+    }
+
+    TEST_CASE(ConvertToFormat_FloatToHalf_ContiguousValues_MatchesConversionOfSingleValues)
+    {
+        half contiguous[ValueCount], one_by_one[ValueCount];
+        convert_float_values(PixelFormatHalf, contiguous, one_by_one);
+
+        for (size_t i = 0; i < ValueCount; ++i)
+            EXPECT_EQ(one_by_one[i].bits(), contiguous[i].bits());
+    }
+
+    TEST_CASE(ConvertFromFormat_UInt8ToFloat_ContiguousValues_MatchesConversionOfSingleValues)
+    {
+        uint8 input[ValueCount];
+        for (size_t i = 0; i < ValueCount; ++i)
+            input[i] = static_cast<uint8>(i * 25);
+
+        float contiguous[ValueCount], one_by_one[ValueCount];
+        convert_to_float_values(PixelFormatUInt8, input, contiguous, one_by_one);
+
+        EXPECT_SEQUENCE_EQ(ValueCount, one_by_one, contiguous);
+    }
+
+    TEST_CASE(ConvertFromFormat_UInt16ToFloat_ContiguousValues_MatchesConversionOfSingleValues)
+    {
+        uint16 input[ValueCount];
+        for (size_t i = 0; i < ValueCount; ++i)
+            input[i] = static_cast<uint16>(i * 6553);
+
+        float contiguous[ValueCount], one_by_one[ValueCount];
+        convert_to_float_values(PixelFormatUInt16, input, contiguous, one_by_one);
+
+        EXPECT_SEQUENCE_EQ(ValueCount, one_by_one, contiguous);
+    }
+
+    TEST_CASE(ConvertFromFormat_HalfToFloat_ContiguousValues_MatchesConversionOfSingleValues)
+    {
+        half input[ValueCount];
+        for (size_t i = 0; i < ValueCount; ++i)
+            input[i] = FloatValues[i];
+
+        float contiguous[ValueCount], one_by_one[ValueCount];
+        convert_to_float_values(PixelFormatHalf, input, contiguous, one_by_one);
+
+        EXPECT_SEQUENCE_EQ(ValueCount, one_by_one, contiguous);
+    }
+
+    TEST_CASE(ConvertAndShuffle_IdentityShuffle_ConvertsAllChannels)
+    {
+        const float input[8] = { 0.0f, 0.25f, 0.5f, 1.0f, 1.0f, 0.5f, 0.25f, 0.0f };
+        const size_t shuffle_table[4] = { 0, 1, 2, 3 };
+
+        uint8 output[8];
+        Pixel::convert_and_shuffle(
+            PixelFormatFloat,
+            4,
+            input, input + 8,
+            PixelFormatUInt8,
+            4,
+            output,
+            shuffle_table);
+
+        const uint8 expected[8] = { 0, 64, 128, 255, 255, 128, 64, 0 };
+        EXPECT_SEQUENCE_EQ(8, expected, output);
+    }
 }
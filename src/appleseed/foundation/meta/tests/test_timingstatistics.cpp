@@ -0,0 +1,88 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.foundation headers.
+#include "foundation/utility/benchmark/timingresult.h"
+#include "foundation/utility/benchmark/timingstatistics.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
+using namespace foundation;
+using namespace std;
+
+TEST_SUITE(Foundation_Utility_Benchmark_TimingStatistics)
+{
+    TEST_CASE(ComputeTimingStatistics_GivenSingleMeasurement_ReturnsThisMeasurement)
+    {
+        vector<double> ticks(1, 42.0);
+        TimingResult result;
+
+        compute_timing_statistics(ticks, result);
+
+        EXPECT_EQ(0, result.m_outlier_count);
+        EXPECT_EQ(42.0, result.m_ticks);
+        EXPECT_EQ(42.0, result.m_min_ticks);
+        EXPECT_EQ(42.0, result.m_median_ticks);
+        EXPECT_EQ(0.0, result.m_std_dev_ticks);
+    }
+
+    TEST_CASE(ComputeTimingStatistics_GivenMeasurementsWithoutOutliers_ComputesStatistics)
+    {
+        const double Values[] = { 5.0, 3.0, 4.0, 2.0, 6.0 };
+        vector<double> ticks(Values, Values + 5);
+        TimingResult result;
+
+        compute_timing_statistics(ticks, result);
+
+        EXPECT_EQ(0, result.m_outlier_count);
+        EXPECT_EQ(5, ticks.size());
+        EXPECT_FEQ(4.0, result.m_ticks);
+        EXPECT_EQ(2.0, result.m_min_ticks);
+        EXPECT_EQ(4.0, result.m_median_ticks);
+        EXPECT_FEQ(1.4142135623730951, result.m_std_dev_ticks);
+    }
+
+    TEST_CASE(ComputeTimingStatistics_GivenMeasurementsWithOutliers_RejectsOutliers)
+    {
+        const double Values[] = { 10.0, 11.0, 10.0, 1000.0, 12.0, 11.0, 0.5, 10.0 };
+        vector<double> ticks(Values, Values + 8);
+        TimingResult result;
+
+        compute_timing_statistics(ticks, result);
+
+        EXPECT_EQ(2, result.m_outlier_count);
+        EXPECT_EQ(6, ticks.size());
+        EXPECT_EQ(10.0, result.m_min_ticks);
+        EXPECT_EQ(10.5, result.m_median_ticks);
+        EXPECT_FEQ(64.0 / 6.0, result.m_ticks);
+    }
+}
@@ -65,7 +65,7 @@ class AttributeSet
         const NumericTypeID type,
         const size_t        dimension);
 
-    // Delete an existing channel.
+    // Delete an existing channel. The IDs of the other channels remain valid.
     void delete_channel(const ChannelID channel_id);
 
     // Find a given attribute channel. Return InvalidChannelID if
@@ -32,17 +32,21 @@
 
 // Interface headers.
 #include "foundation/utility/benchmark/benchmarkaggregator.h"
+#include "foundation/utility/benchmark/benchmarkbaseline.h"
 #include "foundation/utility/benchmark/benchmarkdatapoint.h"
 #include "foundation/utility/benchmark/benchmarklistenerbase.h"
 #include "foundation/utility/benchmark/benchmarkresult.h"
 #include "foundation/utility/benchmark/benchmarkserie.h"
+#include "foundation/utility/benchmark/benchmarksettings.h"
 #include "foundation/utility/benchmark/benchmarksuiterepository.h"
 #include "foundation/utility/benchmark/helpers.h"
 #include "foundation/utility/benchmark/ibenchmarkcase.h"
 #include "foundation/utility/benchmark/ibenchmarkcasefactory.h"
 #include "foundation/utility/benchmark/ibenchmarklistener.h"
 #include "foundation/utility/benchmark/loggerbenchmarklistener.h"
+#include "foundation/utility/benchmark/perfcounters.h"
 #include "foundation/utility/benchmark/timingresult.h"
+#include "foundation/utility/benchmark/timingstatistics.h"
 #include "foundation/utility/benchmark/xmlfilebenchmarklistener.h"
 
 #endif  // !APPLESEED_FOUNDATION_UTILITY_BENCHMARK_H
@@ -0,0 +1,227 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "benchmarkbaseline.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/string.h"
+#include "foundation/utility/xercesc.h"
+
+// Xerces-C++ headers.
+#include "xercesc/dom/DOM.hpp"
+#include "xercesc/parsers/XercesDOMParser.hpp"
+#include "xercesc/util/XMLException.hpp"
+
+// Standard headers.
+#include <cassert>
+#include <map>
+#include <string>
+#include <utility>
+
+using namespace std;
+using namespace xercesc;
+
+namespace foundation
+{
+
+//
+// BenchmarkBaseline class implementation.
+//
+
+namespace
+{
+    string get_attribute(const DOMNode* node, const char* name)
+    {
+        const DOMNode* attribute = node->getAttributes()->getNamedItem(transcode(name).c_str());
+        return attribute ? transcode(attribute->getNodeValue()) : string();
+    }
+
+    string make_key(const string& suite_name, const string& case_name)
+    {
+        return suite_name + "::" + case_name;
+    }
+}
+
+struct BenchmarkBaseline::Impl
+{
+    typedef map<pair<string, size_t>, double> SecondsMap;
+
+    XercesCContext      m_xerces_context;
+    SecondsMap          m_seconds;
+
+    void scan_execution(const DOMNode* node)
+    {
+        for (node = node->getFirstChild(); node; node = node->getNextSibling())
+        {
+            if (node->getNodeType() == DOMNode::ELEMENT_NODE &&
+                transcode(node->getNodeName()) == "benchmarksuite")
+                scan_suite(node, get_attribute(node, "name"));
+        }
+    }
+
+    void scan_suite(const DOMNode* node, const string& suite_name)
+    {
+        for (node = node->getFirstChild(); node; node = node->getNextSibling())
+        {
+            if (node->getNodeType() == DOMNode::ELEMENT_NODE &&
+                transcode(node->getNodeName()) == "benchmarkcase")
+                scan_case(node, make_key(suite_name, get_attribute(node, "name")));
+        }
+    }
+
+    void scan_case(const DOMNode* node, const string& key)
+    {
+        for (node = node->getFirstChild(); node; node = node->getNextSibling())
+        {
+            if (node->getNodeType() == DOMNode::ELEMENT_NODE &&
+                transcode(node->getNodeName()) == "results")
+            {
+                // Results written before scaling runs were introduced are single-threaded.
+                const string threads = get_attribute(node, "threads");
+                const size_t thread_count = threads.empty() ? 1 : from_string<size_t>(threads);
+
+                scan_results(node, make_pair(key, thread_count));
+            }
+        }
+    }
+
+    void scan_results(const DOMNode* node, const SecondsMap::key_type& key)
+    {
+        double frequency = 0.0;
+        double ticks = 0.0;
+        double median_ticks = 0.0;
+
+        for (node = node->getFirstChild(); node; node = node->getNextSibling())
+        {
+            if (node->getNodeType() != DOMNode::ELEMENT_NODE)
+                continue;
+
+            const string name = transcode(node->getNodeName());
+            const string text = transcode(node->getTextContent());
+
+            if (name == "frequency")
+                frequency = from_string<double>(text);
+            else if (name == "ticks")
+                ticks = from_string<double>(text);
+            else if (name == "medianticks")
+                median_ticks = from_string<double>(text);
+        }
+
+        if (median_ticks > 0.0)
+            ticks = median_ticks;
+
+        if (frequency > 0.0 && ticks > 0.0)
+            m_seconds[key] = ticks / frequency;
+    }
+};
+
+BenchmarkBaseline::BenchmarkBaseline()
+  : impl(new Impl())
+{
+}
+
+BenchmarkBaseline::~BenchmarkBaseline()
+{
+    delete impl;
+}
+
+bool BenchmarkBaseline::load(const char* path)
+{
+    assert(path);
+
+    impl->m_seconds.clear();
+
+    if (!impl->m_xerces_context.is_initialized())
+        return false;
+
+    XercesDOMParser parser;
+    parser.setCreateCommentNodes(false);
+
+    try
+    {
+        parser.parse(path);
+    }
+    catch (const XMLException&)
+    {
+        return false;
+    }
+    catch (const DOMException&)
+    {
+        return false;
+    }
+
+    const DOMDocument* document = parser.getDocument();
+
+    if (!document)
+        return false;
+
+    const DOMElement* root = document->getDocumentElement();
+
+    if (!root || transcode(root->getNodeName()) != "benchmarkexecution")
+        return false;
+
+    try
+    {
+        impl->scan_execution(root);
+    }
+    catch (const ExceptionStringConversionError&)
+    {
+        impl->m_seconds.clear();
+        return false;
+    }
+
+    return true;
+}
+
+size_t BenchmarkBaseline::size() const
+{
+    return impl->m_seconds.size();
+}
+
+bool BenchmarkBaseline::get_seconds(
+    const char*         suite_name,
+    const char*         case_name,
+    const size_t        thread_count,
+    double&             seconds) const
+{
+    assert(suite_name);
+    assert(case_name);
+
+    const Impl::SecondsMap::const_iterator i =
+        impl->m_seconds.find(make_pair(make_key(suite_name, case_name), thread_count));
+
+    if (i == impl->m_seconds.end())
+        return false;
+
+    seconds = i->second;
+    return true;
+}
+
+}   // namespace foundation
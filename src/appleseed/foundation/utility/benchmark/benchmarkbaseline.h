@@ -0,0 +1,82 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_FOUNDATION_UTILITY_BENCHMARK_BENCHMARKBASELINE_H
+#define APPLESEED_FOUNDATION_UTILITY_BENCHMARK_BENCHMARKBASELINE_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+// Standard headers.
+#include <cstddef>
+
+namespace foundation
+{
+
+//
+// Reference running times loaded from a benchmark results file,
+// used to detect performance regressions.
+//
+
+class APPLESEED_DLLSYMBOL BenchmarkBaseline
+  : public NonCopyable
+{
+  public:
+    // Constructor.
+    BenchmarkBaseline();
+
+    // Destructor.
+    ~BenchmarkBaseline();
+
+    // Load a file written by XMLFileBenchmarkListener. Return false on error.
+    bool load(const char* path);
+
+    // Return the number of benchmark results in the baseline.
+    size_t size() const;
+
+    // Retrieve the running time in seconds of a benchmark case for a given thread count.
+    // The median running time is used when available, the average otherwise.
+    // Return false if the baseline has no result for this case and thread count.
+    bool get_seconds(
+        const char*         suite_name,
+        const char*         case_name,
+        const size_t        thread_count,
+        double&             seconds) const;
+
+  private:
+    struct Impl;
+    Impl* impl;
+};
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_UTILITY_BENCHMARK_BENCHMARKBASELINE_H
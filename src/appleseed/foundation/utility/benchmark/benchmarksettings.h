@@ -0,0 +1,68 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_FOUNDATION_UTILITY_BENCHMARK_BENCHMARKSETTINGS_H
+#define APPLESEED_FOUNDATION_UTILITY_BENCHMARK_BENCHMARKSETTINGS_H
+
+// Standard headers.
+#include <cstddef>
+
+// Forward declarations.
+namespace foundation    { class BenchmarkBaseline; }
+
+namespace foundation
+{
+
+//
+// Settings controlling how benchmark cases are run.
+//
+
+class BenchmarkSettings
+{
+  public:
+    size_t                      m_max_thread_count;         // scaling runs use 1, 2, 4... up to this many threads
+    bool                        m_collect_perf_counters;    // sample hardware performance counters when available
+    const BenchmarkBaseline*    m_baseline;                 // reference running times, or 0
+    double                      m_regression_threshold;     // maximum allowed slowdown relative to the baseline
+
+    // Constructor, describes a single-threaded run without counters nor baseline.
+    BenchmarkSettings();
+};
+
+inline BenchmarkSettings::BenchmarkSettings()
+  : m_max_thread_count(1)
+  , m_collect_perf_counters(false)
+  , m_baseline(0)
+  , m_regression_threshold(0.1)
+{
+}
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_UTILITY_BENCHMARK_BENCHMARKSETTINGS_H
@@ -32,18 +32,26 @@
 
 // appleseed.foundation headers.
 #include "foundation/math/vector.h"
+#include "foundation/platform/atomic.h"
 #include "foundation/platform/compiler.h"
 #include "foundation/platform/thread.h"
 #include "foundation/platform/timers.h"
 #include "foundation/platform/types.h"
+#include "foundation/utility/benchmark/benchmarkbaseline.h"
 #include "foundation/utility/benchmark/benchmarkresult.h"
 #include "foundation/utility/benchmark/ibenchmarkcase.h"
 #include "foundation/utility/benchmark/ibenchmarkcasefactory.h"
+#include "foundation/utility/benchmark/perfcounters.h"
 #include "foundation/utility/benchmark/timingresult.h"
+#include "foundation/utility/benchmark/timingstatistics.h"
 #include "foundation/utility/filter.h"
 #include "foundation/utility/gnuplotfile.h"
 #include "foundation/utility/stopwatch.h"
 
+// Boost headers.
+#include "boost/thread/barrier.hpp"
+#include "boost/thread/thread.hpp"
+
 // Standard headers.
 #include <algorithm>
 #include <cassert>
@@ -53,6 +61,7 @@
 #include <limits>
 #include <memory>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -82,6 +91,43 @@ namespace
         {
         }
     };
+
+    // One of the threads of a scaling run. All threads run their own instance
+    // of the benchmark case, in lockstep with the measuring thread.
+    struct ScalingWorker
+    {
+        IBenchmarkCase*         m_benchmark;
+        boost::barrier*         m_start_barrier;
+        boost::barrier*         m_end_barrier;
+        size_t                  m_sample_count;
+        size_t                  m_batch_size;
+        boost::atomic<bool>*    m_failed;
+
+        void operator()()
+        {
+            for (size_t i = 0; i < m_sample_count; ++i)
+            {
+                m_start_barrier->wait();
+
+                // Exceptions can't cross thread boundaries, and we must keep
+                // meeting the barriers whatever happens.
+                if (!*m_failed)
+                {
+                    try
+                    {
+                        for (size_t j = 0; j < m_batch_size; ++j)
+                            m_benchmark->run();
+                    }
+                    catch (...)
+                    {
+                        *m_failed = true;
+                    }
+                }
+
+                m_end_barrier->wait();
+            }
+        }
+    };
 }
 
 struct BenchmarkSuite::Impl
@@ -162,12 +208,150 @@ struct BenchmarkSuite::Impl
         const size_t            measurement_count)
     {
         auto_ptr<IBenchmarkCase> empty_case(new EmptyBenchmarkCase());
-        return
-            measure_runtime(
-                empty_case.get(),
-                stopwatch,
-                BenchmarkSuite::Impl::measure_runtime_ticks,
-                measurement_count);
+
+        vector<double> ticks;
+        measure_samples(empty_case.get(), stopwatch, measurement_count, ticks);
+
+        TimingResult timing_result;
+        compute_timing_statistics(ticks, timing_result);
+
+        return timing_result.m_median_ticks;
+    }
+
+    // Measure the running time (in ticks) of measurement_count individual calls.
+    static void measure_samples(
+        IBenchmarkCase*         benchmark,
+        StopwatchType&          stopwatch,
+        const size_t            measurement_count,
+        vector<double>&         ticks)
+    {
+        ticks.clear();
+        ticks.reserve(measurement_count);
+
+        for (size_t i = 0; i < measurement_count; ++i)
+            ticks.push_back(measure_runtime_ticks(benchmark, stopwatch));
+    }
+
+    // Count hardware events over measurement_count calls, outside of any timing.
+    static void measure_counters(
+        IBenchmarkCase*         benchmark,
+        const size_t            measurement_count,
+        TimingResult&           timing_result)
+    {
+        PerfCounters counters;
+
+        if (!counters.is_available())
+            return;
+
+        counters.start();
+
+        for (size_t i = 0; i < measurement_count; ++i)
+            benchmark->run();
+
+        counters.stop();
+
+        const double rcp_count = 1.0 / measurement_count;
+        timing_result.m_has_counters = true;
+        timing_result.m_cycles = counters.get(PerfCounters::Cycles) * rcp_count;
+        timing_result.m_cache_misses = counters.get(PerfCounters::CacheMisses) * rcp_count;
+        timing_result.m_branch_misses = counters.get(PerfCounters::BranchMisses) * rcp_count;
+    }
+
+    // Measure the running time (in ticks) of one call while thread_count threads
+    // run the benchmark case concurrently. Each sample times a batch of calls on
+    // all threads, so that the cost of synchronizing the threads is amortized.
+    // Return the number of calls per sample.
+    static size_t measure_scaling_samples(
+        IBenchmarkCaseFactory*  factory,
+        StopwatchType&          stopwatch,
+        const size_t            thread_count,
+        const size_t            measurement_count,
+        vector<double>&         ticks)
+    {
+        const size_t SampleCount = 32;
+        const size_t batch_size = max<size_t>(1, measurement_count / SampleCount);
+
+        vector<IBenchmarkCase*> benchmarks;
+        for (size_t i = 0; i < thread_count; ++i)
+            benchmarks.push_back(factory->create());
+
+        boost::barrier start_barrier(static_cast<unsigned int>(thread_count + 1));
+        boost::barrier end_barrier(static_cast<unsigned int>(thread_count + 1));
+        boost::atomic<bool> failed(false);
+
+        boost::thread_group threads;
+
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            ScalingWorker worker;
+            worker.m_benchmark = benchmarks[i];
+            worker.m_start_barrier = &start_barrier;
+            worker.m_end_barrier = &end_barrier;
+            worker.m_sample_count = SampleCount;
+            worker.m_batch_size = batch_size;
+            worker.m_failed = &failed;
+            threads.create_thread(worker);
+        }
+
+        ticks.clear();
+        ticks.reserve(SampleCount);
+
+        for (size_t i = 0; i < SampleCount; ++i)
+        {
+            stopwatch.start();
+            start_barrier.wait();
+            end_barrier.wait();
+            stopwatch.measure();
+
+            ticks.push_back(static_cast<double>(stopwatch.get_ticks()) / batch_size);
+        }
+
+        threads.join_all();
+
+        for (size_t i = 0; i < thread_count; ++i)
+            delete benchmarks[i];
+
+        if (failed)
+            throw runtime_error("an exception was thrown by a benchmark case thread");
+
+        return batch_size;
+    }
+
+    // Report a failure if the benchmark case is slower than in the baseline.
+    static bool check_regression(
+        const BenchmarkSuite&       benchmark_suite,
+        const IBenchmarkCase&       benchmark_case,
+        const TimingResult&         timing_result,
+        const BenchmarkSettings&    settings,
+        BenchmarkResult&            suite_result)
+    {
+        double baseline_seconds;
+
+        if (settings.m_baseline == 0 ||
+            !settings.m_baseline->get_seconds(
+                benchmark_suite.get_name(),
+                benchmark_case.get_name(),
+                timing_result.m_thread_count,
+                baseline_seconds))
+            return true;
+
+        const double seconds = timing_result.m_median_ticks / timing_result.m_frequency;
+
+        if (seconds <= baseline_seconds * (1.0 + settings.m_regression_threshold))
+            return true;
+
+        suite_result.write(
+            benchmark_suite,
+            benchmark_case,
+            __FILE__,
+            __LINE__,
+            "performance regression with " FMT_SIZE_T " thread(s): %.3g ns per call instead of %.3g ns in the baseline (+%.1f%%).",
+            timing_result.m_thread_count,
+            seconds * 1.0e9,
+            baseline_seconds * 1.0e9,
+            (seconds / baseline_seconds - 1.0) * 100.0);
+
+        return false;
     }
 };
 
@@ -194,15 +378,18 @@ void BenchmarkSuite::register_case(IBenchmarkCaseFactory* factory)
     impl->m_factories.push_back(factory);
 }
 
-void BenchmarkSuite::run(BenchmarkResult& suite_result) const
+void BenchmarkSuite::run(
+    BenchmarkResult&            suite_result,
+    const BenchmarkSettings&    settings) const
 {
     PassThroughFilter filter;
-    run(filter, suite_result);
+    run(filter, suite_result, settings);
 }
 
 void BenchmarkSuite::run(
-    const IFilter&      filter,
-    BenchmarkResult&    suite_result) const
+    const IFilter&              filter,
+    BenchmarkResult&            suite_result,
+    const BenchmarkSettings&    settings) const
 {
     BenchmarkingThreadContext benchmarking_context;
     bool has_begun_suite = false;
@@ -250,12 +437,12 @@ void BenchmarkSuite::run(
                 Impl::measure_call_overhead_ticks(stopwatch, measurement_count);
 
             // Run the benchmark case.
-            const double runtime_ticks =
-                Impl::measure_runtime(
-                    benchmark.get(),
-                    stopwatch,
-                    BenchmarkSuite::Impl::measure_runtime_ticks,
-                    measurement_count);
+            vector<double> samples;
+            Impl::measure_samples(benchmark.get(), stopwatch, measurement_count, samples);
+
+            // Remove the call overhead from every measurement.
+            for (size_t j = 0; j < samples.size(); ++j)
+                samples[j] = samples[j] > overhead_ticks ? samples[j] - overhead_ticks : 0.0;
 
 #ifdef GENERATE_BENCHMARK_PLOTS
             vector<Vector2d> points;
@@ -289,7 +476,11 @@ void BenchmarkSuite::run(
             timing_result.m_iteration_count = 1;
             timing_result.m_measurement_count = measurement_count;
             timing_result.m_frequency = static_cast<double>(stopwatch.get_timer().frequency());
-            timing_result.m_ticks = runtime_ticks > overhead_ticks ? runtime_ticks - overhead_ticks : 0.0;
+            compute_timing_statistics(samples, timing_result);
+
+            // Count hardware events.
+            if (settings.m_collect_perf_counters)
+                Impl::measure_counters(benchmark.get(), measurement_count, timing_result);
 
             // Post the timing result.
             suite_result.write(
@@ -298,6 +489,44 @@ void BenchmarkSuite::run(
                 __FILE__,
                 __LINE__,
                 timing_result);
+
+            bool passed =
+                Impl::check_regression(*this, *benchmark.get(), timing_result, settings, suite_result);
+
+            // Run the benchmark case on 2, 4... threads, finishing with the maximum thread count.
+            for (size_t thread_count = 2; thread_count <= settings.m_max_thread_count; )
+            {
+                TimingResult scaling_result;
+                scaling_result.m_thread_count = thread_count;
+                scaling_result.m_iteration_count =
+                    Impl::measure_scaling_samples(
+                        factory,
+                        stopwatch,
+                        thread_count,
+                        measurement_count,
+                        samples);
+                scaling_result.m_measurement_count = samples.size();
+                scaling_result.m_frequency = timing_result.m_frequency;
+                compute_timing_statistics(samples, scaling_result);
+
+                suite_result.write(
+                    *this,
+                    *benchmark.get(),
+                    __FILE__,
+                    __LINE__,
+                    scaling_result);
+
+                if (!Impl::check_regression(*this, *benchmark.get(), scaling_result, settings, suite_result))
+                    passed = false;
+
+                thread_count =
+                    thread_count < settings.m_max_thread_count
+                        ? min(thread_count * 2, settings.m_max_thread_count)
+                        : thread_count + 1;
+            }
+
+            if (!passed)
+                suite_result.signal_case_failure();
         }
 #ifdef NDEBUG
         catch (const exception& e)
@@ -32,6 +32,7 @@
 
 // appleseed.foundation headers.
 #include "foundation/core/concepts/noncopyable.h"
+#include "foundation/utility/benchmark/benchmarksettings.h"
 
 // appleseed.main headers.
 #include "main/dllsymbol.h"
@@ -65,12 +66,15 @@ class APPLESEED_DLLSYMBOL BenchmarkSuite
     void register_case(IBenchmarkCaseFactory* factory);
 
     // Run all the registered benchmark cases.
-    void run(BenchmarkResult& suite_result) const;
+    void run(
+        BenchmarkResult&            suite_result,
+        const BenchmarkSettings&    settings = BenchmarkSettings()) const;
 
     // Run those benchmark cases whose name pass a given filter.
     void run(
-        const IFilter&      filter,
-        BenchmarkResult&    suite_result) const;
+        const IFilter&              filter,
+        BenchmarkResult&            suite_result,
+        const BenchmarkSettings&    settings = BenchmarkSettings()) const;
 
   private:
     struct Impl;
@@ -70,15 +70,18 @@ void BenchmarkSuiteRepository::register_suite(BenchmarkSuite* suite)
     impl->m_suites.push_back(suite);
 }
 
-void BenchmarkSuiteRepository::run(BenchmarkResult& result) const
+void BenchmarkSuiteRepository::run(
+    BenchmarkResult&            result,
+    const BenchmarkSettings&    settings) const
 {
     PassThroughFilter filter;
-    run(filter, result);
+    run(filter, result, settings);
 }
 
 void BenchmarkSuiteRepository::run(
-    const IFilter&      filter,
-    BenchmarkResult&    result) const
+    const IFilter&              filter,
+    BenchmarkResult&            result,
+    const BenchmarkSettings&    settings) const
 {
     for (size_t i = 0; i < impl->m_suites.size(); ++i)
     {
@@ -90,8 +93,8 @@ void BenchmarkSuiteRepository::run(
 
         // Run the benchmark suite.
         if (filter.accepts(suite.get_name()))
-            suite.run(suite_result);
-        else suite.run(filter, suite_result);
+            suite.run(suite_result, settings);
+        else suite.run(filter, suite_result, settings);
 
         // Merge the benchmark suite result into the final benchmark result.
         result.merge(suite_result);
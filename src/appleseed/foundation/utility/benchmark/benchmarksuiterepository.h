@@ -32,6 +32,7 @@
 
 // appleseed.foundation headers.
 #include "foundation/core/concepts/singleton.h"
+#include "foundation/utility/benchmark/benchmarksettings.h"
 
 // appleseed.main headers.
 #include "main/dllsymbol.h"
@@ -56,12 +57,15 @@ class APPLESEED_DLLSYMBOL BenchmarkSuiteRepository
     void register_suite(BenchmarkSuite* suite);
 
     // Run all the registered benchmark suites.
-    void run(BenchmarkResult& result) const;
+    void run(
+        BenchmarkResult&            result,
+        const BenchmarkSettings&    settings = BenchmarkSettings()) const;
 
     // Run those benchmark suites whose name pass a given filter.
     void run(
-        const IFilter&      filter,
-        BenchmarkResult&    result) const;
+        const IFilter&              filter,
+        BenchmarkResult&            result,
+        const BenchmarkSettings&    settings = BenchmarkSettings()) const;
 
   private:
     friend class Singleton<BenchmarkSuiteRepository>;
@@ -94,6 +94,14 @@ namespace
         }
     }
 
+    string pretty_ticks(const double ticks)
+    {
+        return
+            ticks >= 1000.0
+                ? pretty_uint(static_cast<uint64>(ticks))
+                : pretty_scalar(ticks);
+    }
+
     TEST_SUITE(Foundation_Utility_Benchmark)
     {
         string pretty_callrate_helper(const double rate)
@@ -187,17 +195,34 @@ namespace
                     " at " + pretty_scalar(freq_mhz, 3) + " MHz)";
             }
 
+            string case_name = benchmark_case.get_name();
+
+            if (timing_result.m_thread_count > 1)
+                case_name += " [" + pretty_uint(timing_result.m_thread_count) + " threads]";
+
             print_suite_name(benchmark_suite);
 
             LOG_INFO(
                 m_logger,
-                "  %s: %s %s %s",
-                benchmark_case.get_name(),
-                timing_result.m_ticks >= 1000.0
-                    ? pretty_uint(static_cast<uint64>(timing_result.m_ticks)).c_str()
-                    : pretty_scalar(timing_result.m_ticks).c_str(),
+                "  %s: %s %s (median %s, min %s, std dev %s, %s rejected) %s",
+                case_name.c_str(),
+                pretty_ticks(timing_result.m_ticks).c_str(),
                 plural(timing_result.m_ticks, "clock tick").c_str(),
+                pretty_ticks(timing_result.m_median_ticks).c_str(),
+                pretty_ticks(timing_result.m_min_ticks).c_str(),
+                pretty_ticks(timing_result.m_std_dev_ticks).c_str(),
+                pretty_uint(timing_result.m_outlier_count).c_str(),
                 callrate_string.c_str());
+
+            if (timing_result.m_has_counters)
+            {
+                LOG_INFO(
+                    m_logger,
+                    "    per call: %s cycles, %s cache misses, %s branch misses",
+                    pretty_scalar(timing_result.m_cycles).c_str(),
+                    pretty_scalar(timing_result.m_cache_misses).c_str(),
+                    pretty_scalar(timing_result.m_branch_misses).c_str());
+            }
         }
 
       private:
@@ -0,0 +1,199 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "perfcounters.h"
+
+// Platform headers.
+#if defined __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Standard headers.
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+
+namespace foundation
+{
+
+//
+// PerfCounters class implementation (Linux).
+//
+
+#if defined __linux__
+
+struct PerfCounters::Impl
+{
+    int     m_fds[EventCount];
+
+    Impl()
+    {
+        static const uint64 Configs[EventCount] =
+        {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES
+        };
+
+        for (size_t i = 0; i < EventCount; ++i)
+        {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = Configs[i];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+
+            // Count events of the calling thread, on any CPU.
+            m_fds[i] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+    }
+
+    ~Impl()
+    {
+        for (size_t i = 0; i < EventCount; ++i)
+        {
+            if (m_fds[i] != -1)
+                close(m_fds[i]);
+        }
+    }
+
+    bool is_available() const
+    {
+        for (size_t i = 0; i < EventCount; ++i)
+        {
+            if (m_fds[i] == -1)
+                return false;
+        }
+
+        return true;
+    }
+
+    void start()
+    {
+        for (size_t i = 0; i < EventCount; ++i)
+        {
+            if (m_fds[i] != -1)
+            {
+                ioctl(m_fds[i], PERF_EVENT_IOC_RESET, 0);
+                ioctl(m_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    void stop()
+    {
+        for (size_t i = 0; i < EventCount; ++i)
+        {
+            if (m_fds[i] != -1)
+                ioctl(m_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    uint64 get(const Event event) const
+    {
+        uint64 value = 0;
+
+        if (m_fds[event] != -1)
+        {
+            if (read(m_fds[event], &value, sizeof(value)) != sizeof(value))
+                value = 0;
+        }
+
+        return value;
+    }
+};
+
+#else
+
+//
+// PerfCounters class implementation (other platforms).
+//
+
+struct PerfCounters::Impl
+{
+    bool is_available() const
+    {
+        return false;
+    }
+
+    void start()
+    {
+    }
+
+    void stop()
+    {
+    }
+
+    uint64 get(const Event event) const
+    {
+        return 0;
+    }
+};
+
+#endif
+
+PerfCounters::PerfCounters()
+  : impl(new Impl())
+{
+}
+
+PerfCounters::~PerfCounters()
+{
+    delete impl;
+}
+
+bool PerfCounters::is_available() const
+{
+    return impl->is_available();
+}
+
+void PerfCounters::start()
+{
+    impl->start();
+}
+
+void PerfCounters::stop()
+{
+    impl->stop();
+}
+
+uint64 PerfCounters::get(const Event event) const
+{
+    assert(event < EventCount);
+    return impl->get(event);
+}
+
+}   // namespace foundation
@@ -0,0 +1,88 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_FOUNDATION_UTILITY_BENCHMARK_PERFCOUNTERS_H
+#define APPLESEED_FOUNDATION_UTILITY_BENCHMARK_PERFCOUNTERS_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/platform/types.h"
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+namespace foundation
+{
+
+//
+// Hardware performance counters of the calling thread.
+//
+// Only implemented on Linux, using perf_event_open(2). On other platforms,
+// or when the kernel denies access to the counters (see perf_event_paranoid),
+// the counters are unavailable and always read zero.
+//
+
+class APPLESEED_DLLSYMBOL PerfCounters
+  : public NonCopyable
+{
+  public:
+    enum Event
+    {
+        Cycles,
+        CacheMisses,
+        BranchMisses,
+        EventCount
+    };
+
+    // Constructor, opens the counters for the calling thread.
+    PerfCounters();
+
+    // Destructor.
+    ~PerfCounters();
+
+    // Return true if all counters could be opened.
+    bool is_available() const;
+
+    // Reset the counters and start counting.
+    void start();
+
+    // Stop counting.
+    void stop();
+
+    // Read the number of events counted between start() and stop().
+    uint64 get(const Event event) const;
+
+  private:
+    struct Impl;
+    Impl* impl;
+};
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_UTILITY_BENCHMARK_PERFCOUNTERS_H
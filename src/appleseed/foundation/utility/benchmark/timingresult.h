@@ -43,12 +43,43 @@ namespace foundation
 class TimingResult
 {
   public:
+    size_t  m_thread_count;         // number of threads running the benchmark case concurrently
     size_t  m_iteration_count;      // number of iterations per measurement
     size_t  m_measurement_count;    // number of measurements per benchmark case
+    size_t  m_outlier_count;        // number of measurements rejected as outliers
     double  m_frequency;            // frequency of the timer used for the measurement
     double  m_ticks;                // average running time, in timer ticks
+    double  m_min_ticks;            // lowest running time, in timer ticks
+    double  m_median_ticks;         // median running time, in timer ticks
+    double  m_std_dev_ticks;        // standard deviation of the running time, in timer ticks
+
+    // Hardware event counts per call, only valid if m_has_counters is true.
+    bool    m_has_counters;
+    double  m_cycles;
+    double  m_cache_misses;
+    double  m_branch_misses;
+
+    // Constructor, describes a single-threaded run with no measurement.
+    TimingResult();
 };
 
+inline TimingResult::TimingResult()
+  : m_thread_count(1)
+  , m_iteration_count(0)
+  , m_measurement_count(0)
+  , m_outlier_count(0)
+  , m_frequency(0.0)
+  , m_ticks(0.0)
+  , m_min_ticks(0.0)
+  , m_median_ticks(0.0)
+  , m_std_dev_ticks(0.0)
+  , m_has_counters(false)
+  , m_cycles(0.0)
+  , m_cache_misses(0.0)
+  , m_branch_misses(0.0)
+{
+}
+
 }       // namespace foundation
 
 #endif  // !APPLESEED_FOUNDATION_UTILITY_BENCHMARK_TIMINGRESULT_H
@@ -0,0 +1,105 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "timingstatistics.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/benchmark/timingresult.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+using namespace std;
+
+namespace foundation
+{
+
+namespace
+{
+    // Return the q-quantile of a sorted, non-empty set of values, with linear interpolation.
+    double quantile(const vector<double>& sorted, const double q)
+    {
+        assert(!sorted.empty());
+        assert(q >= 0.0 && q <= 1.0);
+
+        const double x = q * static_cast<double>(sorted.size() - 1);
+        const size_t i = static_cast<size_t>(x);
+
+        if (i + 1 >= sorted.size())
+            return sorted.back();
+
+        const double t = x - static_cast<double>(i);
+        return (1.0 - t) * sorted[i] + t * sorted[i + 1];
+    }
+}
+
+void compute_timing_statistics(
+    vector<double>&         ticks,
+    TimingResult&           timing_result)
+{
+    assert(!ticks.empty());
+
+    sort(ticks.begin(), ticks.end());
+
+    // Reject outliers.
+    const double q1 = quantile(ticks, 0.25);
+    const double q3 = quantile(ticks, 0.75);
+    const double iqr = q3 - q1;
+    const vector<double>::iterator begin =
+        lower_bound(ticks.begin(), ticks.end(), q1 - 1.5 * iqr);
+    const vector<double>::iterator end =
+        upper_bound(ticks.begin(), ticks.end(), q3 + 1.5 * iqr);
+    timing_result.m_outlier_count = ticks.size() - (end - begin);
+    ticks.erase(end, ticks.end());
+    ticks.erase(ticks.begin(), begin);
+
+    // The fences always enclose the quartiles, so at least one measurement remains.
+    assert(!ticks.empty());
+
+    double sum = 0.0;
+    for (size_t i = 0; i < ticks.size(); ++i)
+        sum += ticks[i];
+
+    const double mean = sum / ticks.size();
+
+    double sum_sq_dev = 0.0;
+    for (size_t i = 0; i < ticks.size(); ++i)
+        sum_sq_dev += (ticks[i] - mean) * (ticks[i] - mean);
+
+    timing_result.m_ticks = mean;
+    timing_result.m_min_ticks = ticks.front();
+    timing_result.m_median_ticks = quantile(ticks, 0.5);
+    timing_result.m_std_dev_ticks = sqrt(sum_sq_dev / ticks.size());
+}
+
+}   // namespace foundation
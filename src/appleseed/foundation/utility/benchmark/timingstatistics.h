@@ -0,0 +1,62 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_FOUNDATION_UTILITY_BENCHMARK_TIMINGSTATISTICS_H
+#define APPLESEED_FOUNDATION_UTILITY_BENCHMARK_TIMINGSTATISTICS_H
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+// Standard headers.
+#include <vector>
+
+// Forward declarations.
+namespace foundation    { class TimingResult; }
+
+namespace foundation
+{
+
+//
+// Robust statistics over a set of running time measurements.
+//
+// Measurements outside of Tukey's fences [Q1 - 1.5 IQR, Q3 + 1.5 IQR] are rejected
+// as outliers (interrupts, page faults, frequency transitions...), then the mean,
+// minimum, median and standard deviation of the remaining measurements are stored
+// into the timing result, along with the number of rejected measurements.
+//
+// On return, 'ticks' is sorted and only contains the retained measurements.
+//
+
+APPLESEED_DLLSYMBOL void compute_timing_statistics(
+    std::vector<double>&    ticks,
+    TimingResult&           timing_result);
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_UTILITY_BENCHMARK_TIMINGSTATISTICS_H
@@ -158,7 +158,11 @@ void XMLFileBenchmarkListener::write(
     const size_t            line,
     const TimingResult&     timing_result)
 {
-    fprintf(impl->m_file, "%s<results>\n", impl->m_indenter.c_str());
+    fprintf(
+        impl->m_file,
+        "%s<results threads=\"" FMT_SIZE_T "\">\n",
+        impl->m_indenter.c_str(),
+        timing_result.m_thread_count);
 
     ++impl->m_indenter;
 
@@ -172,6 +176,11 @@ void XMLFileBenchmarkListener::write(
         impl->m_indenter.c_str(),
         timing_result.m_measurement_count);
 
+    fprintf(impl->m_file,
+        "%s<outliers>" FMT_SIZE_T "</outliers>\n",
+        impl->m_indenter.c_str(),
+        timing_result.m_outlier_count);
+
     fprintf(impl->m_file,
         "%s<frequency>%f</frequency>\n",
         impl->m_indenter.c_str(),
@@ -182,6 +191,39 @@ void XMLFileBenchmarkListener::write(
         impl->m_indenter.c_str(),
         timing_result.m_ticks);
 
+    fprintf(impl->m_file,
+        "%s<minticks>%f</minticks>\n",
+        impl->m_indenter.c_str(),
+        timing_result.m_min_ticks);
+
+    fprintf(impl->m_file,
+        "%s<medianticks>%f</medianticks>\n",
+        impl->m_indenter.c_str(),
+        timing_result.m_median_ticks);
+
+    fprintf(impl->m_file,
+        "%s<stddevticks>%f</stddevticks>\n",
+        impl->m_indenter.c_str(),
+        timing_result.m_std_dev_ticks);
+
+    if (timing_result.m_has_counters)
+    {
+        fprintf(impl->m_file,
+            "%s<cycles>%f</cycles>\n",
+            impl->m_indenter.c_str(),
+            timing_result.m_cycles);
+
+        fprintf(impl->m_file,
+            "%s<cachemisses>%f</cachemisses>\n",
+            impl->m_indenter.c_str(),
+            timing_result.m_cache_misses);
+
+        fprintf(impl->m_file,
+            "%s<branchmisses>%f</branchmisses>\n",
+            impl->m_indenter.c_str(),
+            timing_result.m_branch_misses);
+    }
+
     --impl->m_indenter;
 
     fprintf(impl->m_file, "%s</results>\n", impl->m_indenter.c_str());
@@ -642,6 +642,8 @@ class DualStageCache
 
         void unload(const KeyType& key, ElementType& element)
         {
+            // Drop the copy of the stage-1 element.
+            element = ElementType();
         }
 
       private:
@@ -735,7 +737,8 @@ SACache(
   , m_invalid_key(invalid_key)
   , m_timestamp(0)
 {
-    clear();
+    for (size_t i = 0; i < Lines; ++i)
+        m_lines[i].invalidate(m_invalid_key);
 }
 
 FOUNDATION_SACACHE_TEMPLATE_DEF(APPLESEED_EMPTY)
@@ -756,7 +759,16 @@ FOUNDATION_SACACHE_TEMPLATE_DEF(void)
 clear()
 {
     for (size_t i = 0; i < Lines; ++i)
+    {
+        for (size_t j = 0; j < LineType::Ways; ++j)
+        {
+            EntryType& entry = m_lines[i].get_entry(j);
+            if (entry.m_key != m_invalid_key)
+                m_element_swapper.unload(entry.m_key, entry.m_element);
+        }
+
         m_lines[i].invalidate(m_invalid_key);
+    }
 }
 
 FOUNDATION_SACACHE_TEMPLATE_DEF(inline Element&)
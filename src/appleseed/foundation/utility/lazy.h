@@ -33,6 +33,7 @@
 // appleseed.foundation headers.
 #include "foundation/core/concepts/noncopyable.h"
 #include "foundation/core/exceptions/exception.h"
+#include "foundation/platform/atomic.h"
 #include "foundation/platform/thread.h"
 #include "foundation/platform/types.h"
 #include "foundation/utility/cache.h"
@@ -40,13 +41,19 @@
 #include "foundation/utility/uid.h"
 
 // Standard headers.
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 namespace foundation
 {
 
+// Forward declarations.
+template <typename Object> class LazyPager;
+
+
 //
 // A factory interface for lazy object construction.
 //
@@ -99,17 +106,115 @@ class Lazy
     // Return the source object associated with that lazy object, if any.
     ObjectType* get_source_object() const;
 
+    // Attach this lazy object to a pager. The pager must outlive the lazy object.
+    void set_pager(LazyPager<Object>* pager);
+
+    // Delete the object if it was created by the factory and is not currently
+    // accessed. It will be recreated by the factory the next time it is accessed.
+    // Return true if the object was deleted.
+    bool evict();
+
   private:
     template <typename> friend class Access;
     template <typename> friend class Update;
+    template <typename> friend class LazyPager;
+
+    // Set in the reference count while the object is being evicted.
+    static const uint32 EvictionFlag = 0x80000000UL;
+
+    boost::mutex            m_mutex;
+    volatile uint32         m_reference_count;
+    volatile uint32         m_access_stamp;
 
-    boost::mutex    m_mutex;
-    int             m_reference_count;
+    FactoryType*            m_factory;
+    ObjectType*             m_source_object;
+    ObjectType* volatile    m_object;
+    const bool              m_own_object;
+    LazyPager<Object>*      m_pager;
 
-    FactoryType*    m_factory;
-    ObjectType*     m_source_object;
-    ObjectType*     m_object;
-    const bool      m_own_object;
+    // Acquire a reference to the object, optionally creating it if it doesn't exist.
+    void acquire(const bool create);
+
+    // Release a reference to the object.
+    void release();
+};
+
+
+//
+// A pager keeps the memory used by a set of lazily constructed objects under
+// a given budget by deleting the least recently accessed objects that are not
+// currently accessed. The object type must have a get_memory_size() method.
+//
+
+template <typename Object>
+class LazyPager
+  : public NonCopyable
+{
+  public:
+    // Object and lazy object types.
+    typedef Object ObjectType;
+    typedef Lazy<Object> LazyType;
+
+    // Constructor. A budget of 0 disables eviction.
+    explicit LazyPager(const size_t memory_budget);
+
+    // Return the memory budget, in bytes.
+    size_t get_memory_budget() const;
+
+    // Return the memory used by the objects currently alive, in bytes.
+    size_t get_memory_size() const;
+
+    // Return the number of objects deleted so far to enforce the budget.
+    size_t get_eviction_count() const;
+
+    // Return a counter incremented whenever the budget could not be enforced
+    // because the objects that could be deleted were still being accessed.
+    // Caches holding accesses to these objects should drop them when it changes.
+    uint32 get_flush_epoch() const;
+
+  private:
+    friend class Lazy<Object>;
+
+    struct Entry
+    {
+        LazyType*   m_lazy;
+        size_t      m_memory_size;
+    };
+
+    struct OlderEntry
+    {
+        bool operator()(const Entry& lhs, const Entry& rhs) const;
+    };
+
+    // Only the pager requires objects to have a get_memory_size() method,
+    // not lazy objects that are never attached to a pager.
+    typedef size_t (*SizeFunction)(const ObjectType& object);
+
+    mutable boost::mutex    m_mutex;
+    const SizeFunction      m_memory_size_function;
+    const size_t            m_memory_budget;
+    volatile uint32         m_clock;
+    volatile uint32         m_flush_epoch;
+    volatile uint32         m_over_budget;
+    size_t                  m_memory_size;
+    size_t                  m_eviction_count;
+    std::vector<Entry>      m_entries;          // objects currently alive
+
+    static size_t get_object_memory_size(const ObjectType& object);
+
+    uint32 get_clock() const;
+
+    // Called by a lazy object after it created its object, while still holding a reference to it.
+    void on_object_created(LazyType& lazy);
+
+    // Called by a lazy object after its last reference was released while over budget.
+    void on_object_released();
+
+    // Called by a lazy object about to be destructed.
+    void on_lazy_deleted(LazyType& lazy);
+
+    // Evict objects until the budget is met. Return true if it could be met.
+    bool enforce_budget(const LazyType* protected_lazy);
 };
 
 
@@ -312,6 +417,10 @@ class AccessCacheMap
     // Constructor.
     AccessCacheMap();
 
+    // Drop all cached accesses whenever a given pager asks for it. Objects returned
+    // by access() must not be used after a subsequent call to access().
+    void set_pager(const LazyPager<ObjectType>* pager);
+
     // Access the object corresponding to a given key.
     const ObjectType* access(
         const KeyType&      key,
@@ -373,9 +482,11 @@ class AccessCacheMap
         AllocatorType
     > CacheType;
 
-    KeyHasher               m_key_hasher;
-    mutable ObjectSwapper   m_object_swapper;
-    mutable CacheType       m_cache;
+    KeyHasher                       m_key_hasher;
+    mutable ObjectSwapper           m_object_swapper;
+    mutable CacheType               m_cache;
+    const LazyPager<ObjectType>*    m_pager;
+    mutable uint32                  m_flush_epoch;
 };
 
 
@@ -386,10 +497,12 @@ class AccessCacheMap
 template <typename Object>
 Lazy<Object>::Lazy(std::auto_ptr<FactoryType> factory)
   : m_reference_count(0)
+  , m_access_stamp(0)
   , m_factory(factory.release())
   , m_source_object(0)
   , m_object(0)
   , m_own_object(true)
+  , m_pager(0)
 {
     assert(m_factory);
 }
@@ -397,10 +510,12 @@ Lazy<Object>::Lazy(std::auto_ptr<FactoryType> factory)
 template <typename Object>
 Lazy<Object>::Lazy(ObjectType* source_object)
   : m_reference_count(0)
+  , m_access_stamp(0)
   , m_factory(0)
   , m_source_object(source_object)
   , m_object(0)
   , m_own_object(false)
+  , m_pager(0)
 {
     assert(m_source_object);
 }
@@ -408,6 +523,9 @@ Lazy<Object>::Lazy(ObjectType* source_object)
 template <typename Object>
 Lazy<Object>::~Lazy()
 {
+    if (m_pager)
+        m_pager->on_lazy_deleted(*this);
+
     boost::mutex::scoped_lock lock(m_mutex);
     assert(m_reference_count == 0);
 
@@ -429,6 +547,224 @@ inline typename Lazy<Object>::ObjectType* Lazy<Object>::get_source_object() cons
     return m_source_object;
 }
 
+template <typename Object>
+inline void Lazy<Object>::set_pager(LazyPager<Object>* pager)
+{
+    assert(m_object == 0);
+    m_pager = pager;
+}
+
+template <typename Object>
+bool Lazy<Object>::evict()
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    if (!m_own_object || m_factory == 0 || m_object == 0)
+        return false;
+
+    // Only evict the object if nobody is accessing it. Threads acquiring
+    // a reference from now on will see the flag and wait for the mutex.
+    if (atomic_cas(&m_reference_count, 0, EvictionFlag) != 0)
+        return false;
+
+    delete m_object;
+    m_object = 0;
+
+    // Clear the flag, preserving references acquired in the meantime.
+    uint32 count = EvictionFlag;
+    while (true)
+    {
+        const uint32 actual = atomic_cas(&m_reference_count, count, count & ~EvictionFlag);
+        if (actual == count)
+            break;
+        count = actual;
+    }
+
+    return true;
+}
+
+template <typename Object>
+void Lazy<Object>::acquire(const bool create)
+{
+    const uint32 previous_count = atomic_inc(&m_reference_count);
+
+    if (m_pager)
+        m_access_stamp = m_pager->get_clock();
+
+    // Fast path: the object exists and is not being evicted.
+    if ((previous_count & EvictionFlag) == 0 && m_object != 0)
+        return;
+
+    bool created = false;
+
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+
+        // Create the object if it doesn't exist yet.
+        if (create && m_object == 0)
+        {
+            if (m_factory)
+            {
+                m_object = m_factory->create().release();
+                created = m_object != 0;
+            }
+            else m_object = m_source_object;
+        }
+    }
+
+    // Notify the pager outside of the lock: the pager locks other lazy objects.
+    if (created && m_pager)
+        m_pager->on_object_created(*this);
+}
+
+template <typename Object>
+inline void Lazy<Object>::release()
+{
+    assert((m_reference_count & ~EvictionFlag) > 0);
+    const uint32 previous_count = atomic_dec(&m_reference_count);
+
+    // Give the pager a chance to evict objects that are no longer accessed.
+    if (m_pager && m_pager->m_over_budget && (previous_count & ~EvictionFlag) == 1)
+        m_pager->on_object_released();
+}
+
+
+//
+// LazyPager class implementation.
+//
+
+template <typename Object>
+LazyPager<Object>::LazyPager(const size_t memory_budget)
+  : m_memory_size_function(&get_object_memory_size)
+  , m_memory_budget(memory_budget)
+  , m_clock(0)
+  , m_flush_epoch(0)
+  , m_over_budget(0)
+  , m_memory_size(0)
+  , m_eviction_count(0)
+{
+}
+
+template <typename Object>
+inline size_t LazyPager<Object>::get_memory_budget() const
+{
+    return m_memory_budget;
+}
+
+template <typename Object>
+size_t LazyPager<Object>::get_memory_size() const
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    return m_memory_size;
+}
+
+template <typename Object>
+size_t LazyPager<Object>::get_eviction_count() const
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    return m_eviction_count;
+}
+
+template <typename Object>
+inline uint32 LazyPager<Object>::get_flush_epoch() const
+{
+    return m_flush_epoch;
+}
+
+template <typename Object>
+inline bool LazyPager<Object>::OlderEntry::operator()(const Entry& lhs, const Entry& rhs) const
+{
+    return lhs.m_lazy->m_access_stamp < rhs.m_lazy->m_access_stamp;
+}
+
+template <typename Object>
+size_t LazyPager<Object>::get_object_memory_size(const ObjectType& object)
+{
+    return object.get_memory_size();
+}
+
+template <typename Object>
+inline uint32 LazyPager<Object>::get_clock() const
+{
+    return m_clock;
+}
+
+template <typename Object>
+void LazyPager<Object>::on_object_created(LazyType& lazy)
+{
+    assert(lazy.m_object);
+
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    // Advance the clock so that objects accessed from now on are more recent than existing ones.
+    lazy.m_access_stamp = m_clock++;
+
+    Entry entry;
+    entry.m_lazy = &lazy;
+    entry.m_memory_size = m_memory_size_function(*lazy.m_object);
+    m_entries.push_back(entry);
+    m_memory_size += entry.m_memory_size;
+
+    // Ask caches to drop their accesses if the objects to evict are still referenced.
+    if (m_memory_budget > 0 && m_memory_size > m_memory_budget && !enforce_budget(&lazy))
+        ++m_flush_epoch;
+}
+
+template <typename Object>
+void LazyPager<Object>::on_object_released()
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    if (m_over_budget)
+        enforce_budget(0);
+}
+
+template <typename Object>
+void LazyPager<Object>::on_lazy_deleted(LazyType& lazy)
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    for (size_t i = 0; i < m_entries.size(); ++i)
+    {
+        if (m_entries[i].m_lazy == &lazy)
+        {
+            m_memory_size -= m_entries[i].m_memory_size;
+            m_entries[i] = m_entries.back();
+            m_entries.pop_back();
+            m_over_budget = m_memory_budget > 0 && m_memory_size > m_memory_budget ? 1 : 0;
+            return;
+        }
+    }
+}
+
+template <typename Object>
+bool LazyPager<Object>::enforce_budget(const LazyType* protected_lazy)
+{
+    std::sort(m_entries.begin(), m_entries.end(), OlderEntry());
+
+    size_t kept = 0;
+
+    for (size_t i = 0; i < m_entries.size(); ++i)
+    {
+        const Entry& entry = m_entries[i];
+
+        if (m_memory_size > m_memory_budget &&
+            entry.m_lazy != protected_lazy &&
+            entry.m_lazy->evict())
+        {
+            m_memory_size -= entry.m_memory_size;
+            ++m_eviction_count;
+        }
+        else m_entries[kept++] = entry;
+    }
+
+    m_entries.resize(kept);
+
+    m_over_budget = m_memory_size > m_memory_budget ? 1 : 0;
+
+    return m_over_budget == 0;
+}
+
 
 //
 // Access class implementation.
@@ -466,28 +802,13 @@ void Access<Object>::reset(LazyType* lazy)
 {
     // Release access to the current lazy object, if any.
     if (m_lazy)
-    {
-        boost::mutex::scoped_lock lock(m_lazy->m_mutex);
-        assert(m_lazy->m_reference_count > 0);
-        --m_lazy->m_reference_count;
-    }
+        m_lazy->release();
 
     m_lazy = lazy;
 
-    // Acquire access to the new lazy object.
+    // Acquire access to the new lazy object, creating the object if it doesn't exist yet.
     if (m_lazy)
-    {
-        boost::mutex::scoped_lock lock(m_lazy->m_mutex);
-        ++m_lazy->m_reference_count;
-
-        // Create the object if it doesn't exist yet.
-        if (m_lazy->m_object == 0)
-        {
-            if (m_lazy->m_factory)
-                m_lazy->m_object = m_lazy->m_factory->create().release();
-            else m_lazy->m_object = m_lazy->m_source_object;
-        }
-    }
+        m_lazy->acquire(true);
 }
 
 template <typename Object>
@@ -555,20 +876,13 @@ void Update<Object>::reset(LazyType* lazy)
 {
     // Release access to the current lazy object, if any.
     if (m_lazy)
-    {
-        boost::mutex::scoped_lock lock(m_lazy->m_mutex);
-        assert(m_lazy->m_reference_count > 0);
-        --m_lazy->m_reference_count;
-    }
+        m_lazy->release();
 
     m_lazy = lazy;
 
     // Acquire access to the new lazy object.
     if (m_lazy)
-    {
-        boost::mutex::scoped_lock lock(m_lazy->m_mutex);
-        ++m_lazy->m_reference_count;
-    }
+        m_lazy->acquire(false);
 }
 
 template <typename Object>
@@ -702,15 +1016,32 @@ inline bool AccessCache<Object, Lines, Ways, Allocator>::ObjectSwapper::is_full(
 template <typename ObjectMap, size_t Lines, size_t Ways, typename Allocator>
 AccessCacheMap<ObjectMap, Lines, Ways, Allocator>::AccessCacheMap()
   : m_cache(m_key_hasher, m_object_swapper, ~0)
+  , m_pager(0)
+  , m_flush_epoch(0)
 {
 }
 
+template <typename ObjectMap, size_t Lines, size_t Ways, typename Allocator>
+inline void AccessCacheMap<ObjectMap, Lines, Ways, Allocator>::set_pager(
+    const LazyPager<ObjectType>* pager)
+{
+    m_pager = pager;
+    m_flush_epoch = pager ? pager->get_flush_epoch() : 0;
+}
+
 template <typename ObjectMap, size_t Lines, size_t Ways, typename Allocator>
 inline const typename AccessCacheMap<ObjectMap, Lines, Ways, Allocator>::ObjectType*
 AccessCacheMap<ObjectMap, Lines, Ways, Allocator>::access(
     const KeyType&      key,
     const ObjectMap&    object_map) const
 {
+    // Release the objects held by this cache so that the pager can evict them.
+    if (m_pager && m_pager->get_flush_epoch() != m_flush_epoch)
+    {
+        m_flush_epoch = m_pager->get_flush_epoch();
+        m_cache.clear();
+    }
+
     m_object_swapper.set_object_map(&object_map);
     return m_cache.get(key).get();
 }
@@ -46,6 +46,7 @@
 #include "renderer/modeling/scene/objectinstance.h"
 #include "renderer/modeling/scene/scene.h"
 #include "renderer/utility/bbox.h"
+#include "renderer/utility/paramarray.h"
 
 // appleseed.foundation headers.
 #include "foundation/math/beziercurve.h"
@@ -57,6 +58,7 @@
 #include "foundation/platform/timers.h"
 #include "foundation/platform/types.h"
 #include "foundation/utility/alignedallocator.h"
+#include "foundation/utility/containers/dictionary.h"
 #include "foundation/utility/foreach.h"
 #include "foundation/utility/lazy.h"
 #include "foundation/utility/siphash.h"
@@ -80,9 +82,20 @@ namespace renderer
 // AssemblyTree class implementation.
 //
 
+namespace
+{
+    size_t get_triangle_trees_memory_budget(const Scene& scene)
+    {
+        // The budget is expressed in megabytes; 0 means unlimited.
+        const ParamArray& params = scene.get_parameters().child("acceleration_structure");
+        return params.get_optional<size_t>("memory_budget", 0) * 1024 * 1024;
+    }
+}
+
 AssemblyTree::AssemblyTree(const Scene& scene)
   : TreeType(AlignedAllocator<void>(System::get_l1_data_cache_line_size()))
   , m_scene(scene)
+  , m_triangle_tree_pager(get_triangle_trees_memory_budget(scene))
 {
     update();
 }
@@ -90,6 +103,15 @@ AssemblyTree::AssemblyTree(const Scene& scene)
 AssemblyTree::~AssemblyTree()
 {
     RENDERER_LOG_INFO("deleting assembly tree...");
+
+    if (m_triangle_tree_pager.get_eviction_count() > 0)
+    {
+        RENDERER_LOG_DEBUG(
+            "%s triangle %s deleted to stay under the %s memory budget.",
+            pretty_uint(m_triangle_tree_pager.get_eviction_count()).c_str(),
+            plural(m_triangle_tree_pager.get_eviction_count(), "tree was", "trees were").c_str(),
+            pretty_size(m_triangle_tree_pager.get_memory_budget()).c_str());
+    }
 }
 
 void AssemblyTree::update()
@@ -108,6 +130,21 @@ size_t AssemblyTree::get_memory_size() const
         + m_assembly_versions.size() * sizeof(pair<UniqueID, VersionID>);
 }
 
+Dictionary AssemblyTree::get_params_metadata()
+{
+    Dictionary metadata;
+
+    metadata.dictionaries().insert(
+        "memory_budget",
+        Dictionary()
+            .insert("type", "int")
+            .insert("default", "0")
+            .insert("label", "Triangle Trees Memory Budget")
+            .insert("help", "Memory budget in megabytes shared by all triangle trees of the scene; least recently used trees are deleted and rebuilt on demand to stay under it; 0 for unlimited"));
+
+    return metadata;
+}
+
 void AssemblyTree::collect_assembly_instances(
     const AssemblyInstanceContainer&    assembly_instances,
     const TransformSequence&            parent_transform_seq,
@@ -430,7 +467,8 @@ void AssemblyTree::create_region_tree(const Assembly& assembly)
                 RegionTree::Arguments(
                     m_scene,
                     assembly.get_uid(),
-                    assembly)));
+                    assembly,
+                    &m_triangle_tree_pager)));
 
         tree = new Lazy<RegionTree>(region_tree_factory);
         m_region_tree_repository.insert(hash, tree);
@@ -464,7 +502,10 @@ void AssemblyTree::create_triangle_tree(const Assembly& assembly)
                     assembly,
                     regions)));
 
+        // Triangle trees that are not being accessed may be deleted
+        // to stay under the memory budget and rebuilt later.
         tree = new Lazy<TriangleTree>(triangle_tree_factory);
+        tree->set_pager(&m_triangle_tree_pager);
         m_triangle_tree_repository.insert(hash, tree);
     }
 
@@ -46,6 +46,7 @@
 #include "foundation/math/aabb.h"
 #include "foundation/math/bvh.h"
 #include "foundation/utility/alignedvector.h"
+#include "foundation/utility/lazy.h"
 #include "foundation/utility/uid.h"
 #include "foundation/utility/version.h"
 
@@ -55,6 +56,7 @@
 #include <vector>
 
 // Forward declarations.
+namespace foundation    { class Dictionary; }
 namespace foundation    { class Statistics; }
 namespace renderer      { class AssemblyInstance; }
 namespace renderer      { class Scene; }
@@ -75,7 +77,8 @@ class AssemblyTree
            >
 {
   public:
-    // Constructor, builds the tree for a given scene.
+    // Constructor, builds the tree for a given scene. The parameters of the
+    // scene's "acceleration_structure" dictionary are described by get_params_metadata().
     explicit AssemblyTree(const Scene& scene);
 
     // Destructor.
@@ -87,6 +90,9 @@ class AssemblyTree
     // Return the size (in bytes) of this object in memory.
     size_t get_memory_size() const;
 
+    // Get the metadata dictionary describing the scene's acceleration structure params.
+    static foundation::Dictionary get_params_metadata();
+
   private:
     friend class AssemblyLeafVisitor;
     friend class AssemblyLeafProbeVisitor;
@@ -122,6 +128,9 @@ class AssemblyTree
     ItemVector                      m_items;
     AssemblyVersionMap              m_assembly_versions;
 
+    // Keeps all triangle trees, including those of region trees, under the memory budget.
+    foundation::LazyPager<TriangleTree> m_triangle_tree_pager;
+
     TreeRepository<TriangleTree>    m_triangle_tree_repository;
     TriangleTreeContainer           m_triangle_trees;
 
@@ -65,6 +65,21 @@ using namespace std;
 namespace renderer
 {
 
+namespace
+{
+    GVector3 transform_point(const Curve3Type::MatrixType& m, const GVector3& p)
+    {
+        const Vector<GScalar, 4> pt(p.x, p.y, p.z, GScalar(1.0));
+        const Vector<GScalar, 4> xpt = m * pt;
+
+        assert(xpt.w != GScalar(0.0));
+        const GScalar rcp_w = GScalar(1.0) / xpt.w;
+
+        return GVector3(xpt.x * rcp_w, xpt.y * rcp_w, xpt.z * rcp_w);
+    }
+}
+
+
 //
 // CurveTree class implementation.
 //
@@ -114,6 +129,7 @@ CurveTree::CurveTree(const Arguments& arguments)
 void CurveTree::collect_curves(vector<GAABB3>& curve_bboxes)
 {
     const ObjectInstanceContainer& object_instances = m_arguments.m_assembly.object_instances();
+    vector<GVector3> strand_points;
 
     for (size_t i = 0; i < object_instances.size(); ++i)
     {
@@ -155,24 +171,40 @@ void CurveTree::collect_curves(vector<GAABB3>& curve_bboxes)
         }
 
         // Store degree-3 curves, curve keys and curve bounding boxes.
-        const size_t curve3_count = curve_object.get_curve3_count();
-        for (size_t j = 0; j < curve3_count; ++j)
+        // Strand points are transformed once and shared by consecutive curves.
+        const Curve3Type::MatrixType curve_transform(transform);
+        const size_t strand_count = curve_object.get_curve3_strand_count();
+        size_t curve3_index = 0;
+        for (size_t j = 0; j < strand_count; ++j)
         {
-            const Curve3Type curve(curve_object.get_curve3(j), transform);
-            const CurveKey curve_key(
-                i,                  // object instance index
-                j,                  // curve index in object
-                m_curves3.size(),   // curve index in tree
-                0,                  // for now we assume all the curves have the same material
-                3);                 // curve degree
-
-            GAABB3 curve_bbox = curve.compute_bbox();
-            curve_bbox.grow(GVector3(GScalar(0.5) * curve.compute_max_width()));
-
-            m_curves3.push_back(curve);
-            m_curve_keys.push_back(curve_key);
-            curve_bboxes.push_back(curve_bbox);
+            const size_t point_count = curve_object.get_curve3_strand_point_count(j);
+            const GVector3* points = curve_object.get_curve3_strand_points(j);
+            const GScalar* widths = curve_object.get_curve3_strand_widths(j);
+
+            strand_points.resize(point_count);
+            for (size_t k = 0; k < point_count; ++k)
+                strand_points[k] = transform_point(curve_transform, points[k]);
+
+            for (size_t k = 0; k + 1 < point_count; k += 3, ++curve3_index)
+            {
+                const Curve3Type curve(&strand_points[k], &widths[k]);
+                const CurveKey curve_key(
+                    i,                  // object instance index
+                    curve3_index,       // curve index in object
+                    m_curves3.size(),   // curve index in tree
+                    0,                  // for now we assume all the curves have the same material
+                    3);                 // curve degree
+
+                GAABB3 curve_bbox = curve.compute_bbox();
+                curve_bbox.grow(GVector3(GScalar(0.5) * curve.compute_max_width()));
+
+                m_curves3.push_back(curve);
+                m_curve_keys.push_back(curve_key);
+                curve_bboxes.push_back(curve_bbox);
+            }
         }
+
+        assert(curve3_index == curve_object.get_curve3_count());
     }
 }
 
@@ -36,6 +36,7 @@
 // appleseed.foundation headers.
 #include "foundation/math/beziercurve.h"
 #include "foundation/math/intersection/raytrianglemt.h"
+#include "foundation/math/intersection/raytrianglemt4.h"
 #include "foundation/math/matrix.h"
 
 // Standard headers.
@@ -87,7 +88,15 @@ typedef foundation::TriangleMT<GScalar> GTriangleType;
 typedef foundation::TriangleMT<double> TriangleType;
 typedef foundation::TriangleMTSupportPlane<double> TriangleSupportPlaneType;
 
-// Maximum number of triangles per leaf.
+// Format used for storing and intersecting groups of static triangles.
+typedef foundation::TriangleMT4<GScalar> GTriangleGroupType;
+
+// Minimum number of triangles in a leaf made only of static triangles for these
+// triangles to be stored in groups and intersected simultaneously.
+const size_t TriangleTreeMinGroupedLeafSize = 3;
+
+// Maximum number of triangles per leaf. Leaves are only stored in groups when the
+// "max_leaf_size" acceleration structure parameter is at least TriangleTreeMinGroupedLeafSize.
 const size_t TriangleTreeDefaultMaxLeafSize = 2;
 
 // Relative cost of traversing an interior node.
@@ -67,6 +67,8 @@ Intersector::Intersector(
   , m_shading_ray_count(0)
   , m_probe_ray_count(0)
 {
+    // Let the triangle tree pager reclaim the trees held by this thread's cache.
+    m_triangle_tree_cache.set_pager(&trace_context.get_assembly_tree().m_triangle_tree_pager);
 }
 
 Vector3d Intersector::refine(
@@ -412,12 +412,14 @@ namespace
 //
 
 RegionTree::Arguments::Arguments(
-    const Scene&    scene,
-    const UniqueID  assembly_uid,
-    const Assembly& assembly)
+    const Scene&                scene,
+    const UniqueID              assembly_uid,
+    const Assembly&             assembly,
+    LazyPager<TriangleTree>*    triangle_tree_pager)
   : m_scene(scene)
   , m_assembly_uid(assembly_uid)
   , m_assembly(assembly)
+  , m_triangle_tree_pager(triangle_tree_pager)
 {
 }
 
@@ -453,9 +455,11 @@ RegionTree::RegionTree(const Arguments& arguments)
                     interm_leaf->m_assembly,
                     interm_leaf->m_regions)));
 
-        // Create and store the triangle tree.
-        m_triangle_trees.insert(
-            make_pair(triangle_tree_uid, new Lazy<TriangleTree>(triangle_tree_factory)));
+        // Create and store the triangle tree. Triangle trees that are not being
+        // accessed may be deleted to stay under the memory budget and rebuilt later.
+        Lazy<TriangleTree>* triangle_tree = new Lazy<TriangleTree>(triangle_tree_factory);
+        triangle_tree->set_pager(arguments.m_triangle_tree_pager);
+        m_triangle_trees.insert(make_pair(triangle_tree_uid, triangle_tree));
 
         // Create and store the leaf.
         m_leaves.push_back(new RegionLeaf(*this, triangle_tree_uid));
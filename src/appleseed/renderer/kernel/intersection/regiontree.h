@@ -94,15 +94,17 @@ class RegionTree
     // Construction arguments.
     struct Arguments
     {
-        const Scene&                    m_scene;
-        const foundation::UniqueID      m_assembly_uid;
-        const Assembly&                 m_assembly;
+        const Scene&                            m_scene;
+        const foundation::UniqueID              m_assembly_uid;
+        const Assembly&                         m_assembly;
+        foundation::LazyPager<TriangleTree>*    m_triangle_tree_pager;
 
-        // Constructor.
+        // Constructor. The triangle trees of the region tree are attached to the pager.
         Arguments(
-            const Scene&                scene,
-            const foundation::UniqueID  assembly_uid,
-            const Assembly&             assembly);
+            const Scene&                        scene,
+            const foundation::UniqueID          assembly_uid,
+            const Assembly&                     assembly,
+            foundation::LazyPager<TriangleTree>* triangle_tree_pager);
     };
 
     // Constructor, builds the tree for a given assembly.
@@ -44,12 +44,46 @@ using namespace std;
 namespace renderer
 {
 
+bool TriangleEncoder::is_grouped_leaf(
+    const vector<TriangleVertexInfo>&   triangle_vertex_infos,
+    const vector<size_t>&               triangle_indices,
+    const size_t                        item_begin,
+    const size_t                        item_count)
+{
+    if (item_count < TriangleTreeMinGroupedLeafSize)
+        return false;
+
+    for (size_t i = 0; i < item_count; ++i)
+    {
+        const size_t triangle_index = triangle_indices[item_begin + i];
+
+        if (triangle_vertex_infos[triangle_index].m_motion_segment_count > 0)
+            return false;
+    }
+
+    return true;
+}
+
 size_t TriangleEncoder::compute_size(
     const vector<TriangleVertexInfo>&   triangle_vertex_infos,
     const vector<size_t>&               triangle_indices,
     const size_t                        item_begin,
     const size_t                        item_count)
 {
+    if (is_grouped_leaf(triangle_vertex_infos, triangle_indices, item_begin, item_count))
+    {
+        const size_t GroupSize = GTriangleGroupType::Size;
+        const size_t group_count = (item_count + GroupSize - 1) / GroupSize;
+
+        size_t size = 0;
+        size += sizeof(uint32);         // unused
+        size += sizeof(uint32);         // grouped leaf marker
+        size += group_count * GroupSize * sizeof(uint32);       // visibility flags
+        size += group_count * sizeof(GTriangleGroupType);
+
+        return size;
+    }
+
     size_t size = 0;
 
     for (size_t i = 0; i < item_count; ++i)
@@ -76,6 +110,46 @@ void TriangleEncoder::encode(
     const size_t                        item_count,
     MemoryWriter&                       writer)
 {
+    if (is_grouped_leaf(triangle_vertex_infos, triangle_indices, item_begin, item_count))
+    {
+        writer.write(uint32(0));
+        writer.write(static_cast<uint32>(GroupedLeafMarker));
+
+        const size_t GroupSize = GTriangleGroupType::Size;
+
+        for (size_t group_begin = 0; group_begin < item_count; group_begin += GroupSize)
+        {
+            uint32 vis_flags[GroupSize];
+            GTriangleGroupType group;
+            group.clear();
+
+            // Unused slots are left invisible and degenerate.
+            for (size_t j = 0; j < GroupSize; ++j)
+            {
+                vis_flags[j] = 0;
+
+                if (group_begin + j < item_count)
+                {
+                    const size_t triangle_index = triangle_indices[item_begin + group_begin + j];
+                    const TriangleVertexInfo& vertex_info = triangle_vertex_infos[triangle_index];
+
+                    vis_flags[j] = vertex_info.m_vis_flags;
+                    group.set(
+                        j,
+                        GTriangleType(
+                            triangle_vertices[vertex_info.m_vertex_index + 0],
+                            triangle_vertices[vertex_info.m_vertex_index + 1],
+                            triangle_vertices[vertex_info.m_vertex_index + 2]));
+                }
+            }
+
+            writer.write(vis_flags, sizeof(vis_flags));
+            writer.write(group);
+        }
+
+        return;
+    }
+
     for (size_t i = 0; i < item_count; ++i)
     {
         const size_t triangle_index = triangle_indices[item_begin + i];
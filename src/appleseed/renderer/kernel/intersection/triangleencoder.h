@@ -33,6 +33,9 @@
 // appleseed.renderer headers.
 #include "renderer/global/globaltypes.h"
 
+// appleseed.foundation headers.
+#include "foundation/platform/types.h"
+
 // Standard headers.
 #include <cstddef>
 #include <vector>
@@ -44,9 +47,32 @@ namespace renderer      { class TriangleVertexInfo; }
 namespace renderer
 {
 
+//
+// Leaves are encoded in one of two ways:
+//
+//   - Triangles are stored one after the other, each one preceded by its visibility
+//     flags and its number of motion segments. Moving triangles are stored as one
+//     triangle per motion step.
+//
+//   - When a leaf is made of at least TriangleTreeMinGroupedLeafSize triangles, all
+//     of which are static, triangles are stored in groups of GTriangleGroupType::Size
+//     triangles, each group preceded by the visibility flags of its triangles. Such
+//     leaves start with a GroupedLeafMarker in place of the first motion segment count.
+//
+
 class TriangleEncoder
 {
   public:
+    // Marker identifying leaves whose triangles are stored in groups.
+    static const foundation::uint32 GroupedLeafMarker = ~foundation::uint32(0);
+
+    // Return true if the triangles of a given leaf should be stored in groups.
+    static bool is_grouped_leaf(
+        const std::vector<TriangleVertexInfo>&  triangle_vertex_infos,
+        const std::vector<size_t>&              triangle_indices,
+        const size_t                            item_begin,
+        const size_t                            item_count);
+
     static size_t compute_size(
         const std::vector<TriangleVertexInfo>&  triangle_vertex_infos,
         const std::vector<size_t>&              triangle_indices,
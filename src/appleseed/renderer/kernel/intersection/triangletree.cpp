@@ -1347,6 +1347,16 @@ namespace
     typedef TriangleReaderImpl<
         sizeof(GTriangleType::ValueType) == sizeof(TriangleType::ValueType)
     > TriangleReader;
+
+    // Return true if the triangles of a given leaf are stored in groups.
+    bool is_grouped_leaf(
+        const TriangleTree::NodeType&   node,
+        const uint8*                    leaf_data)
+    {
+        return
+            node.get_item_count() >= TriangleTreeMinGroupedLeafSize &&
+            reinterpret_cast<const uint32*>(leaf_data)[1] == TriangleEncoder::GroupedLeafMarker;
+    }
 }
 
 
@@ -1373,6 +1383,78 @@ bool TriangleLeafVisitor::visit(
             : &m_tree.m_leaf_data[leaf_data_index];     // triangles are stored in the tree
     MemoryReader reader(leaf_data);
 
+    if (is_grouped_leaf(node, leaf_data))
+    {
+        reader += 2 * sizeof(uint32);
+
+        // Intersect the triangles of the leaf one group at a time.
+        const size_t GroupSize = GTriangleGroupType::Size;
+        for (size_t group_index = node.get_item_index(),
+                    triangle_count = node.get_item_count();
+                    triangle_count > 0;
+                    group_index += GroupSize,
+                    triangle_count -= min(triangle_count, GroupSize))
+        {
+            FOUNDATION_BVH_TRAVERSAL_STATS(stats.m_intersected_items.insert(min(triangle_count, GroupSize)));
+
+            // Retrieve the visibility flags of the triangles of this group.
+            const uint32* vis_flags = static_cast<const uint32*>(reader.read(GroupSize * sizeof(uint32)));
+
+            // Retrieve the triangles of this group.
+            const GTriangleGroupType& group = reader.read<GTriangleGroupType>();
+
+            // Check visibility flags.
+            int vis_mask = 0;
+            for (size_t i = 0; i < GroupSize; ++i)
+            {
+                if (vis_flags[i] & m_shading_point.m_ray.m_flags)
+                    vis_mask |= 1 << i;
+            }
+            if (vis_mask == 0)
+                continue;
+
+            // Intersect all the triangles of the group.
+            double t[GroupSize], u[GroupSize], v[GroupSize];
+            const int hit_mask = group.intersect(ray, t, u, v) & vis_mask;
+            if (hit_mask == 0)
+                continue;
+
+            // Process hits in triangle order, as if the triangles had been intersected one by one.
+            for (size_t i = 0; i < GroupSize; ++i)
+            {
+                if (!(hit_mask & (1 << i)))
+                    continue;
+
+                // Only keep hits closer than the ones found in this group so far.
+                if (t[i] >= m_shading_point.m_ray.m_tmax)
+                    continue;
+
+                const size_t triangle_index = group_index + i;
+
+                // Optionally filter intersections.
+                if (m_has_intersection_filters)
+                {
+                    const TriangleKey& triangle_key = m_tree.m_triangle_keys[triangle_index];
+                    const IntersectionFilter* filter =
+                        m_tree.m_intersection_filters[triangle_key.get_object_instance_index()];
+                    if (filter && !filter->accept(triangle_key, u[i], v[i]))
+                        continue;
+                }
+
+                m_hit_triangle_copy = group.get(i);
+                m_hit_triangle = &m_hit_triangle_copy;
+                m_hit_triangle_index = triangle_index;
+                m_shading_point.m_ray.m_tmax = t[i];
+                m_shading_point.m_bary[0] = static_cast<float>(u[i]);
+                m_shading_point.m_bary[1] = static_cast<float>(v[i]);
+            }
+        }
+
+        // Continue traversal.
+        distance = m_shading_point.m_ray.m_tmax;
+        return true;
+    }
+
     // Sequentially intersect all triangles of the leaf.
     for (size_t triangle_index = node.get_item_index(),
                 triangle_count = node.get_item_count();
@@ -1470,8 +1552,8 @@ bool TriangleLeafVisitor::visit(
                         continue;
                 }
 
-                m_interpolated_triangle = triangle;
-                m_hit_triangle = &m_interpolated_triangle;
+                m_hit_triangle_copy = triangle;
+                m_hit_triangle = &m_hit_triangle_copy;
                 m_hit_triangle_index = triangle_index;
                 m_shading_point.m_ray.m_tmax = t;
                 m_shading_point.m_bary[0] = static_cast<float>(u);
@@ -1528,6 +1610,47 @@ bool TriangleLeafProbeVisitor::visit(
             : &m_tree.m_leaf_data[leaf_data_index];     // triangles are stored in the tree
     MemoryReader reader(leaf_data);
 
+    if (is_grouped_leaf(node, leaf_data))
+    {
+        reader += 2 * sizeof(uint32);
+
+        // Intersect the triangles of the leaf one group at a time until a hit is found.
+        const size_t GroupSize = GTriangleGroupType::Size;
+        for (size_t triangle_count = node.get_item_count();
+                    triangle_count > 0;
+                    triangle_count -= min(triangle_count, GroupSize))
+        {
+            FOUNDATION_BVH_TRAVERSAL_STATS(stats.m_intersected_items.insert(min(triangle_count, GroupSize)));
+
+            // Retrieve the visibility flags of the triangles of this group.
+            const uint32* vis_flags = static_cast<const uint32*>(reader.read(GroupSize * sizeof(uint32)));
+
+            // Retrieve the triangles of this group.
+            const GTriangleGroupType& group = reader.read<GTriangleGroupType>();
+
+            // Check visibility flags.
+            int vis_mask = 0;
+            for (size_t i = 0; i < GroupSize; ++i)
+            {
+                if (vis_flags[i] & m_ray_flags)
+                    vis_mask |= 1 << i;
+            }
+            if (vis_mask == 0)
+                continue;
+
+            // Intersect all the triangles of the group.
+            if (group.intersect(ray) & vis_mask)
+            {
+                m_hit = true;
+                return false;
+            }
+        }
+
+        // Continue traversal.
+        distance = ray.m_tmax;
+        return true;
+    }
+
     // Sequentially intersect triangles until a hit is found.
     for (size_t triangle_count = node.get_item_count(); triangle_count--; )
     {
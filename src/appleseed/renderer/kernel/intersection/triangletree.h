@@ -233,7 +233,7 @@ class TriangleLeafVisitor
     const TriangleTree&     m_tree;
     const bool              m_has_intersection_filters;
     ShadingPoint&           m_shading_point;
-    GTriangleType           m_interpolated_triangle;
+    GTriangleType           m_hit_triangle_copy;        // interpolated or unpacked hit triangle
     const GTriangleType*    m_hit_triangle;
     size_t                  m_hit_triangle_index;
 };
@@ -223,7 +223,7 @@ void DirectLightingIntegrator::compute_outgoing_radiance_light_sampling_low_vari
 
         for (size_t i = 0; i < m_light_sample_count; ++i)
         {
-            const Vector3f s = sampling_context.next2<Vector3f>();
+            const Vector3d s = sampling_context.next2<Vector3d>();
 
             LightSample sample;
             m_light_sampler.sample_emitting_triangles(m_time, s, sample);
@@ -373,7 +373,7 @@ bool DirectLightingIntegrator::compute_incoming_radiance(
     LightSample sample;
     m_light_sampler.sample(
         m_time,
-        sampling_context.next2<Vector3f>(),
+        sampling_context.next2<Vector3d>(),
         sample);
 
     if (sample.m_triangle)
@@ -619,7 +619,7 @@ void DirectLightingIntegrator::take_single_light_sample(
     LightSample sample;
     m_light_sampler.sample(
         m_time,
-        sampling_context.next2<Vector3f>(),
+        sampling_context.next2<Vector3d>(),
         sample);
 
     if (sample.m_triangle)
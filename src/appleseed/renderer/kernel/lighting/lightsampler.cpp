@@ -129,7 +129,7 @@ LightSampler::LightSampler(const Scene& scene, const ParamArray& params)
     // Store the triangle probability densities into the emitting triangles.
     const size_t emitting_triangle_count = m_emitting_triangles.size();
     for (size_t i = 0; i < emitting_triangle_count; ++i)
-        m_emitting_triangles[i].m_triangle_prob = m_emitting_triangles_cdf[i].second;
+        m_emitting_triangles[i].m_triangle_prob = static_cast<float>(m_emitting_triangles_cdf[i].second);
 
    RENDERER_LOG_INFO(
         "found %s %s, %s emitting %s.",
@@ -327,9 +327,9 @@ void LightSampler::collect_emitting_triangles(
                     triangle.m_n1 != Triangle::None &&
                     triangle.m_n2 != Triangle::None)
                 {
-                    n0_os = Vector3d(tess->m_vertex_normals[triangle.m_n0]);
-                    n1_os = Vector3d(tess->m_vertex_normals[triangle.m_n1]);
-                    n2_os = Vector3d(tess->m_vertex_normals[triangle.m_n2]);
+                    n0_os = Vector3d(tess->get_vertex_normal(triangle.m_n0));
+                    n1_os = Vector3d(tess->get_vertex_normal(triangle.m_n1));
+                    n2_os = Vector3d(tess->get_vertex_normal(triangle.m_n2));
                 }
                 else
                     n0_os = n1_os = n2_os = geometric_normal;
@@ -423,14 +423,14 @@ void LightSampler::build_emitting_triangle_hash_table()
 
 void LightSampler::sample_non_physical_lights(
     const ShadingRay::Time&             time,
-    const Vector3f&                     s,
+    const Vector3d&                     s,
     LightSample&                        light_sample) const
 {
     assert(m_non_physical_lights_cdf.valid());
 
     const EmitterCDF::ItemWeightPair result = m_non_physical_lights_cdf.sample(s[0]);
     const size_t light_index = result.first;
-    const float light_prob = result.second;
+    const float light_prob = static_cast<float>(result.second);
 
     light_sample.m_triangle = 0;
     sample_non_physical_light(
@@ -445,19 +445,19 @@ void LightSampler::sample_non_physical_lights(
 
 void LightSampler::sample_emitting_triangles(
     const ShadingRay::Time&             time,
-    const Vector3f&                     s,
+    const Vector3d&                     s,
     LightSample&                        light_sample) const
 {
     assert(m_emitting_triangles_cdf.valid());
 
     const EmitterCDF::ItemWeightPair result = m_emitting_triangles_cdf.sample(s[0]);
     const size_t emitter_index = result.first;
-    const float emitter_prob = result.second;
+    const float emitter_prob = static_cast<float>(result.second);
 
     light_sample.m_light = 0;
     sample_emitting_triangle(
         time,
-        Vector2f(s[1], s[2]),
+        Vector2f(static_cast<float>(s[1]), static_cast<float>(s[2])),
         emitter_index,
         emitter_prob,
         light_sample);
@@ -468,7 +468,7 @@ void LightSampler::sample_emitting_triangles(
 
 void LightSampler::sample(
     const ShadingRay::Time&             time,
-    const Vector3f&                     s,
+    const Vector3d&                     s,
     LightSample&                        light_sample) const
 {
     assert(m_non_physical_lights_cdf.valid() || m_emitting_triangles_cdf.valid());
@@ -477,18 +477,18 @@ void LightSampler::sample(
     {
         if (m_emitting_triangles_cdf.valid())
         {
-            if (s[0] < 0.5f)
+            if (s[0] < 0.5)
             {
                 sample_non_physical_lights(
                     time,
-                    Vector3f(s[0] * 2.0f, s[1], s[2]),
+                    Vector3d(s[0] * 2.0, s[1], s[2]),
                     light_sample);
             }
             else
             {
                 sample_emitting_triangles(
                     time,
-                    Vector3f((s[0] - 0.5f) * 2.0f, s[1], s[2]),
+                    Vector3d((s[0] - 0.5) * 2.0, s[1], s[2]),
                     light_sample);
             }
 
@@ -38,7 +38,7 @@
 
 // appleseed.foundation headers.
 #include "foundation/core/concepts/noncopyable.h"
-#include "foundation/math/cdf.h"
+#include "foundation/math/aliastable.h"
 #include "foundation/math/hash.h"
 #include "foundation/math/transform.h"
 #include "foundation/math/vector.h"
@@ -193,7 +193,7 @@ class LightSampler
     // Sample the set of non-physical lights.
     void sample_non_physical_lights(
         const ShadingRay::Time&             time,
-        const foundation::Vector3f&         s,
+        const foundation::Vector3d&         s,
         LightSample&                        light_sample) const;
 
     // Sample a single given non-physical light.
@@ -205,13 +205,13 @@ class LightSampler
     // Sample the set of emitting triangles.
     void sample_emitting_triangles(
         const ShadingRay::Time&             time,
-        const foundation::Vector3f&         s,
+        const foundation::Vector3d&         s,
         LightSample&                        light_sample) const;
 
     // Sample the sets of non-physical lights and emitting triangles.
     void sample(
         const ShadingRay::Time&             time,
-        const foundation::Vector3f&         s,
+        const foundation::Vector3d&         s,
         LightSample&                        light_sample) const;
 
     // Compute the probability density in area measure of a given light sample.
@@ -227,7 +227,9 @@ class LightSampler
 
     typedef std::vector<NonPhysicalLightInfo> NonPhysicalLightVector;
     typedef std::vector<EmittingTriangle> EmittingTriangleVector;
-    typedef foundation::CDF<size_t, float> EmitterCDF;
+    // A single sample both selects a bucket and flips the alias coin, so double
+    // precision is required to keep the coin unbiased with millions of emitters.
+    typedef foundation::AliasTable<size_t, double> EmitterCDF;
 
     const Parameters            m_params;
 
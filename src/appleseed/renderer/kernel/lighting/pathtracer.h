@@ -42,6 +42,7 @@
 #include "renderer/kernel/shading/shadingray.h"
 #include "renderer/modeling/bsdf/bsdf.h"
 #include "renderer/modeling/bssrdf/bssrdf.h"
+#include "renderer/modeling/input/inputcache.h"
 #include "renderer/modeling/input/inputevaluator.h"
 #include "renderer/modeling/input/source.h"
 #include "renderer/modeling/material/material.h"
@@ -80,7 +81,8 @@ class PathTracer
         const size_t            rr_min_path_length,
         const size_t            max_path_length,
         const size_t            max_iterations = 1000,
-        const double            near_start = 0.0);          // abort tracing if the first ray is shorter than this
+        const double            near_start = 0.0,           // abort tracing if the first ray is shorter than this
+        InputCache*             input_cache = 0);           // if provided, reuse nearby input values where exactness does not matter
 
     size_t trace(
         SamplingContext&        sampling_context,
@@ -115,6 +117,7 @@ class PathTracer
     const size_t                m_max_path_length;
     const size_t                m_max_iterations;
     const double                m_near_start;
+    InputCache*                 m_input_cache;
 
     // Determine whether a ray can pass through a surface with a given alpha value.
     static bool pass_through(
@@ -133,12 +136,14 @@ inline PathTracer<PathVisitor, Adjoint>::PathTracer(
     const size_t                rr_min_path_length,
     const size_t                max_path_length,
     const size_t                max_iterations,
-    const double                near_start)
+    const double                near_start,
+    InputCache*                 input_cache)
   : m_path_visitor(path_visitor)
   , m_rr_min_path_length(rr_min_path_length)
   , m_max_path_length(max_path_length)
   , m_max_iterations(max_iterations)
   , m_near_start(near_start)
+  , m_input_cache(input_cache)
 {
 }
 
@@ -383,8 +388,13 @@ size_t PathTracer<PathVisitor, Adjoint>::trace(
             vertex.m_throughput *= 2.0f;
         }
 
+        // Inputs of points seen through a blurry lobe may be approximated by nearby values.
+        InputCache* input_cache = vertex.may_approximate_inputs() ? m_input_cache : 0;
+
         // Evaluate the inputs of the BSDF.
-        InputEvaluator bsdf_input_evaluator(shading_context.get_texture_cache());
+        InputEvaluator bsdf_input_evaluator(
+            shading_context.get_texture_cache(),
+            input_cache);
         if (vertex.m_bsdf)
         {
             vertex.m_bsdf->evaluate_inputs(
@@ -395,7 +405,9 @@ size_t PathTracer<PathVisitor, Adjoint>::trace(
         }
 
         // Evaluate the inputs of the BSSRDF.
-        InputEvaluator bssrdf_input_evaluator(shading_context.get_texture_cache());
+        InputEvaluator bssrdf_input_evaluator(
+            shading_context.get_texture_cache(),
+            input_cache);
         if (vertex.m_bssrdf)
         {
             vertex.m_bssrdf->evaluate_inputs(
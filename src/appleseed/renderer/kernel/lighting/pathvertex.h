@@ -104,6 +104,11 @@ class PathVertex
     const foundation::Basis3d& get_shading_basis() const;
     const Material* get_material() const;
 
+    // Return true if the inputs at this vertex may be approximated by nearby values, that is,
+    // if this vertex was reached through a diffuse or glossy bounce and is therefore only seen
+    // through a blurry lobe. Vertices seen from the camera or through specular bounces are not.
+    bool may_approximate_inputs() const;
+
     // Compute the radiance emitted at this vertex. Only call when there is an EDF (when m_edf is set).
     void compute_emitted_radiance(
         const ShadingContext&   shading_context,
@@ -167,6 +172,11 @@ inline const Material* PathVertex::get_material() const
     return m_shading_point->get_material();
 }
 
+inline bool PathVertex::may_approximate_inputs() const
+{
+    return m_path_length > 1 && m_prev_mode != ScatteringMode::Specular;
+}
+
 inline float PathVertex::get_bsdf_prob_area() const
 {
     // Make sure we're coming from a valid scattering event.
@@ -48,6 +48,7 @@
 #include "renderer/modeling/edf/edf.h"
 #include "renderer/modeling/environment/environment.h"
 #include "renderer/modeling/environmentedf/environmentedf.h"
+#include "renderer/modeling/input/inputcache.h"
 #include "renderer/modeling/input/inputevaluator.h"
 #include "renderer/modeling/light/light.h"
 #include "renderer/modeling/scene/scene.h"
@@ -67,6 +68,7 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <memory>
 #include <string>
 
 // Forward declarations.
@@ -112,6 +114,8 @@ namespace
             const bool      m_has_max_ray_intensity;
             const float     m_max_ray_intensity;
 
+            const size_t    m_input_cache_resolution;       // resolution of the texture space grid of the input cache, 0 to disable it
+
             float           m_rcp_dl_light_sample_count;
             float           m_rcp_ibl_env_sample_count;
 
@@ -126,6 +130,7 @@ namespace
               , m_ibl_env_sample_count(params.get_optional<float>("ibl_env_samples", 1.0f))
               , m_has_max_ray_intensity(params.strings().exist("max_ray_intensity"))
               , m_max_ray_intensity(params.get_optional<float>("max_ray_intensity", 0.0f))
+              , m_input_cache_resolution(params.get_optional<size_t>("input_cache_resolution", 0))
             {
                 // Precompute the reciprocal of the number of light samples.
                 m_rcp_dl_light_sample_count =
@@ -157,7 +162,8 @@ namespace
                     "  next event est.  %s\n"
                     "  dl light samples %s\n"
                     "  ibl env samples  %s\n"
-                    "  max ray intens.  %s",
+                    "  max ray intens.  %s\n"
+                    "  input cache      %s",
                     m_enable_dl ? "on" : "off",
                     m_enable_ibl ? "on" : "off",
                     m_enable_caustics ? "on" : "off",
@@ -166,7 +172,8 @@ namespace
                     m_next_event_estimation ? "on" : "off",
                     pretty_scalar(m_dl_light_sample_count).c_str(),
                     pretty_scalar(m_ibl_env_sample_count).c_str(),
-                    m_has_max_ray_intensity ? pretty_scalar(m_max_ray_intensity).c_str() : "infinite");
+                    m_has_max_ray_intensity ? pretty_scalar(m_max_ray_intensity).c_str() : "infinite",
+                    m_input_cache_resolution > 0 ? pretty_uint(m_input_cache_resolution).c_str() : "off");
             }
         };
 
@@ -177,6 +184,8 @@ namespace
           , m_light_sampler(light_sampler)
           , m_path_count(0)
         {
+            if (m_params.m_input_cache_resolution > 0)
+                m_input_cache.reset(new InputCache(m_params.m_input_cache_resolution));
         }
 
         virtual void release() APPLESEED_OVERRIDE
@@ -233,7 +242,9 @@ namespace
                 path_visitor,
                 m_params.m_rr_min_path_length,
                 m_params.m_max_path_length,
-                shading_context.get_max_iterations());
+                shading_context.get_max_iterations(),
+                0.0,
+                m_input_cache.get());
 
             const size_t path_length =
                 path_tracer.trace(
@@ -252,7 +263,13 @@ namespace
             stats.insert("path count", m_path_count);
             stats.insert("path length", m_path_length);
 
-            return StatisticsVector::make("path tracing statistics", stats);
+            StatisticsVector vec;
+            vec.insert("path tracing statistics", stats);
+
+            if (m_input_cache.get())
+                vec.insert("input cache statistics", m_input_cache->get_statistics());
+
+            return vec;
         }
 
       private:
@@ -262,6 +279,8 @@ namespace
         uint64                          m_path_count;
         Population<uint64>              m_path_length;
 
+        auto_ptr<InputCache>            m_input_cache;
+
         //
         // Base path visitor.
         //
@@ -915,6 +934,15 @@ Dictionary PTLightingEngineFactory::get_params_metadata()
             .insert("label", "Max Ray Intensity")
             .insert("help", "Clamp intensity of rays (after the first bounce) to this value to reduce fireflies"));
 
+    metadata.dictionaries().insert(
+        "input_cache_resolution",
+        Dictionary()
+            .insert("type", "int")
+            .insert("default", "0")
+            .insert("min", "0")
+            .insert("label", "Input Cache Resolution")
+            .insert("help", "Reuse material input values of indirect and subsurface hits within cells of this resolution in texture space (0 to disable)"));
+
     return metadata;
 }
 
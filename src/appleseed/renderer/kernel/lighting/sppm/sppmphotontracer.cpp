@@ -292,14 +292,14 @@ namespace
             const ShadingContext&   shading_context,
             SamplingContext&        sampling_context)
         {
-            const Vector4f s = sampling_context.next2<Vector4f>();
+            const Vector4d s = sampling_context.next2<Vector4d>();
             LightSample light_sample;
             m_light_sampler.sample(
                 ShadingRay::Time::create_with_normalized_time(
-                    s[0],
+                    static_cast<float>(s[0]),
                     m_shutter_open_time,
                     m_shutter_close_time),
-                Vector3f(s[1], s[2], s[3]),
+                Vector3d(s[1], s[2], s[3]),
                 light_sample);
 
             if (light_sample.m_triangle)
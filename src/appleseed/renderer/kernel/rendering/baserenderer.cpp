@@ -34,13 +34,25 @@
 #include "renderer/kernel/rendering/oiioerrorhandler.h"
 #include "renderer/kernel/rendering/rendererservices.h"
 #include "renderer/kernel/shading/closures.h"
+#include "renderer/kernel/texturing/texturestore.h"
 #include "renderer/modeling/project/project.h"
 #include "renderer/modeling/scene/scene.h"
+#include "renderer/modeling/shadergroup/shadergroupcache.h"
+#include "renderer/utility/settingsparsing.h"
 
 // appleseed.foundation headers.
 #include "foundation/platform/compiler.h"
+#include "foundation/platform/timers.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/containers/dictionary.h"
+#include "foundation/utility/job/jobmanager.h"
+#include "foundation/utility/job/jobqueue.h"
+#include "foundation/utility/statistics.h"
+#include "foundation/utility/stopwatch.h"
+#include "foundation/utility/string.h"
 
 // Standard headers.
+#include <cstddef>
 #include <string>
 
 using namespace foundation;
@@ -87,6 +99,7 @@ BaseRenderer::BaseRenderer(
         m_texture_system,
         m_error_handler);
     m_shading_system->attribute("lockgeom", 1);
+    m_shading_system->attribute("opt_texture_handle", 1);
     m_shading_system->attribute("colorspace", "Linear");
     m_shading_system->attribute("commonspace", "world");
     m_shading_system->attribute("statistics:level", 1);
@@ -104,12 +117,15 @@ BaseRenderer::BaseRenderer(
 
     // Register appleseed's closures into OSL's shading system.
     register_closures(*m_shading_system);
+
+    m_shader_group_cache = new ShaderGroupCache();
 }
 
 BaseRenderer::~BaseRenderer()
 {
     RENDERER_LOG_DEBUG("destroying osl shading system...");
     m_project.get_scene()->release_optimized_osl_shader_groups();
+    delete m_shader_group_cache;
 #if OSL_LIBRARY_VERSION_CODE >= 10700
     delete m_shading_system;
 #else
@@ -141,16 +157,107 @@ bool BaseRenderer::initialize_shading_system(
     TextureStore& texture_store,
     IAbortSwitch& abort_switch)
 {
-    initialize_oiio();
+    initialize_oiio(texture_store);
     return initialize_osl(texture_store, abort_switch);
 }
 
-void BaseRenderer::initialize_oiio()
+Dictionary BaseRenderer::get_texture_system_params_metadata()
+{
+    Dictionary metadata;
+
+    metadata.dictionaries().insert(
+        "max_size",
+        Dictionary()
+            .insert("type", "int")
+            .insert("label", "OIIO Texture Cache Size")
+            .insert("help", "OpenImageIO texture cache size in bytes (defaults to the texture store size, or half of it if the texture cache is unified)"));
+
+    metadata.dictionaries().insert(
+        "max_open_files",
+        Dictionary()
+            .insert("type", "int")
+            .insert("default", "100")
+            .insert("label", "Max Open Files")
+            .insert("help", "Maximum number of texture files kept open by OpenImageIO"));
+
+    metadata.dictionaries().insert(
+        "autotile",
+        Dictionary()
+            .insert("type", "int")
+            .insert("default", "0")
+            .insert("label", "Auto Tile Size")
+            .insert("help", "Tile size used by OpenImageIO to cache untiled textures, 0 to load them whole"));
+
+    return metadata;
+}
+
+namespace
+{
+    void insert_oiio_count(
+        Statistics&             stats,
+        OIIO::TextureSystem&    texture_system,
+        const char*             attribute,
+        const char*             name)
+    {
+        int value;
+        if (texture_system.getattribute(attribute, value))
+            stats.insert<uint64>(name, static_cast<uint64>(value));
+    }
+
+    void insert_oiio_size(
+        Statistics&             stats,
+        OIIO::TextureSystem&    texture_system,
+        const char*             attribute,
+        const char*             name)
+    {
+        long long value;
+        if (texture_system.getattribute(attribute, OIIO::TypeDesc::INT64, &value))
+            stats.insert_size(name, static_cast<uint64>(value));
+    }
+
+    void insert_oiio_time(
+        Statistics&             stats,
+        OIIO::TextureSystem&    texture_system,
+        const char*             attribute,
+        const char*             name)
+    {
+        float value;
+        if (texture_system.getattribute(attribute, value))
+            stats.insert_time(name, value);
+    }
+}
+
+StatisticsVector BaseRenderer::get_texture_system_statistics() const
+{
+    // Statistics that are not supported by the OIIO version in use are skipped.
+    Statistics stats;
+    insert_oiio_count(stats, *m_texture_system, "stat:texture_queries", "texture queries");
+    insert_oiio_count(stats, *m_texture_system, "stat:unique_files", "unique files");
+    insert_oiio_size(stats, *m_texture_system, "stat:files_totalsize", "files total size");
+    insert_oiio_size(stats, *m_texture_system, "stat:bytes_read", "bytes read");
+    insert_oiio_size(stats, *m_texture_system, "stat:cache_memory_used", "cache memory used");
+    insert_oiio_count(stats, *m_texture_system, "stat:tiles_peak", "peak tiles");
+    insert_oiio_count(stats, *m_texture_system, "stat:open_files_peak", "peak open files");
+    insert_oiio_time(stats, *m_texture_system, "stat:fileio_time", "file i/o time");
+    insert_oiio_time(stats, *m_texture_system, "stat:fileopen_time", "file open time");
+
+    return StatisticsVector::make("oiio texture system statistics", stats);
+}
+
+void BaseRenderer::initialize_oiio(const TextureStore& texture_store)
 {
-    const ParamArray& params = m_params.child("texture_store");
+    const ParamArray& params = m_params.child("texture_system");
 
+    // By default, the OIIO texture cache has the same size as appleseed's texture store,
+    // or gets the other half of the texture store budget if both caches are unified.
+    const size_t texture_store_size_bytes =
+        m_params.child("texture_store").get_optional<size_t>("max_size", 256 * 1024 * 1024);
     const size_t texture_cache_size_bytes =
-        params.get_optional<size_t>("max_size", 256 * 1024 * 1024);
+        params.get_optional<size_t>(
+            "max_size",
+            texture_store.is_unified()
+                ? texture_store_size_bytes - texture_store.get_memory_limit()
+                : texture_store_size_bytes);
     RENDERER_LOG_INFO(
         "setting oiio texture cache size to %s.",
         pretty_size(texture_cache_size_bytes).c_str());
@@ -158,6 +265,12 @@ void BaseRenderer::initialize_oiio()
         static_cast<float>(texture_cache_size_bytes) / (1024 * 1024);
     m_texture_system->attribute("max_memory_MB", texture_cache_size_mb);
 
+    const int max_open_files = params.get_optional<int>("max_open_files", 100);
+    m_texture_system->attribute("max_open_files", max_open_files);
+
+    const int autotile = params.get_optional<int>("autotile", 0);
+    m_texture_system->attribute("autotile", autotile);
+
     string prev_search_path;
     m_texture_system->getattribute("searchpath", prev_search_path);
 
@@ -185,11 +298,46 @@ bool BaseRenderer::initialize_osl(TextureStore& texture_store, IAbortSwitch& abo
         m_shading_system->attribute("searchpath:shader", new_search_path);
     }
 
+    // Only keep the OSL shader groups that are still used by the scene.
+    m_shader_group_cache->clear();
+
+    // Create a job manager to optimize and compile shader groups in parallel.
+    const size_t thread_count = get_rendering_thread_count(m_params);
+    JobQueue job_queue;
+    JobManager job_manager(
+        global_logger(),
+        job_queue,
+        thread_count,
+        JobManager::KeepRunningOnEmptyQueue);
+    if (thread_count > 1)
+        job_manager.start();
+
     // Re-optimize the shader groups that need updating.
-    return
+    Stopwatch<DefaultWallclockTimer> stopwatch;
+    stopwatch.start();
+    const bool success =
         m_project.get_scene()->create_optimized_osl_shader_groups(
             *m_shading_system,
-            &abort_switch);
+            &abort_switch,
+            m_shader_group_cache,
+            thread_count > 1 ? &job_queue : 0);
+    stopwatch.measure();
+
+    RENDERER_LOG_DEBUG(
+        "osl shader groups set up in %s.",
+        pretty_time(stopwatch.get_seconds()).c_str());
+
+    if (m_shader_group_cache->get_hit_count() > 0)
+    {
+        RENDERER_LOG_INFO(
+            "%s %s reused identical osl shader groups, %s unique osl %s in total.",
+            pretty_uint(m_shader_group_cache->get_hit_count()).c_str(),
+            plural(m_shader_group_cache->get_hit_count(), "shader group").c_str(),
+            pretty_uint(m_shader_group_cache->size()).c_str(),
+            plural(m_shader_group_cache->size(), "shader group").c_str());
+    }
+
+    return success;
 }
 
 }   // namespace renderer
@@ -51,10 +51,13 @@ BEGIN_OSL_INCLUDES
 END_OSL_INCLUDES
 
 // Forward declarations.
+namespace foundation    { class Dictionary; }
 namespace foundation    { class IAbortSwitch; }
+namespace foundation    { class StatisticsVector; }
 namespace renderer      { class OIIOErrorHandler; }
 namespace renderer      { class Project; }
 namespace renderer      { class RendererServices; }
+namespace renderer      { class ShaderGroupCache; }
 namespace renderer      { class TextureStore; }
 
 namespace renderer
@@ -79,6 +82,12 @@ class APPLESEED_DLLSYMBOL BaseRenderer
         TextureStore&               texture_store,
         foundation::IAbortSwitch&   abort_switch);
 
+    // Return the metadata of the parameters of the OIIO texture system.
+    static foundation::Dictionary get_texture_system_params_metadata();
+
+    // Return the statistics of the OIIO texture system.
+    foundation::StatisticsVector get_texture_system_statistics() const;
+
   protected:
     Project&                        m_project;
     ParamArray                      m_params;
@@ -94,7 +103,9 @@ class APPLESEED_DLLSYMBOL BaseRenderer
         const ParamArray&           params);
 
   private:
-    void initialize_oiio();
+    ShaderGroupCache*               m_shader_group_cache;
+
+    void initialize_oiio(const TextureStore& texture_store);
 
     bool initialize_osl(
         TextureStore&               texture_store,
@@ -0,0 +1,156 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "cooperativetile.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+
+using namespace foundation;
+using namespace std;
+
+namespace renderer
+{
+
+//
+// CooperativeTile class implementation.
+//
+
+CooperativeTile::CooperativeTile(const size_t chunk_size)
+  : m_chunk_size(chunk_size)
+  , m_framebuffer(0)
+  , m_work_item_count(0)
+  , m_next_work_item(0)
+  , m_participant_count(0)
+  , m_started(false)
+  , m_finished(false)
+{
+    assert(m_chunk_size > 0);
+}
+
+CooperativeTile::~CooperativeTile()
+{
+}
+
+bool CooperativeTile::join(bool& first)
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    first = !m_started;
+
+    // Don't let new participants in once all work has been claimed.
+    if (m_started && m_next_work_item >= m_work_item_count)
+        return false;
+
+    ++m_participant_count;
+
+    return true;
+}
+
+void CooperativeTile::start(
+    ShadingResultFrameBuffer*   framebuffer,
+    const size_t                work_item_count)
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    assert(!m_started);
+    assert(m_participant_count == 1);
+
+    m_framebuffer = framebuffer;
+    m_work_item_count = work_item_count;
+    m_started = true;
+}
+
+bool CooperativeTile::claim(
+    size_t&                     chunk_index,
+    size_t&                     begin,
+    size_t&                     end)
+{
+    size_t remaining;
+
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+
+        assert(m_started);
+
+        if (m_next_work_item >= m_work_item_count)
+            return false;
+
+        chunk_index = m_next_work_item / m_chunk_size;
+        begin = m_next_work_item;
+        end = min(m_next_work_item + m_chunk_size, m_work_item_count);
+        m_next_work_item = end;
+
+        remaining = m_work_item_count - end;
+    }
+
+    on_chunk_claimed(remaining);
+
+    return true;
+}
+
+void CooperativeTile::cancel()
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    m_next_work_item = m_work_item_count;
+}
+
+bool CooperativeTile::leave()
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    assert(m_participant_count > 0);
+
+    return --m_participant_count == 0;
+}
+
+void CooperativeTile::finish()
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    m_finished = true;
+    m_finished_event.notify_all();
+}
+
+void CooperativeTile::wait_until_finished()
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    while (!m_finished)
+        m_finished_event.wait(lock);
+}
+
+void CooperativeTile::on_chunk_claimed(const size_t remaining_work_item_count)
+{
+}
+
+}   // namespace renderer
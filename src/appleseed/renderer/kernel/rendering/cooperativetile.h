@@ -0,0 +1,130 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_RENDERER_KERNEL_RENDERING_COOPERATIVETILE_H
+#define APPLESEED_RENDERER_KERNEL_RENDERING_COOPERATIVETILE_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/platform/thread.h"
+
+// Boost headers.
+#include "boost/thread/condition_variable.hpp"
+
+// Standard headers.
+#include <cstddef>
+
+// Forward declarations.
+namespace renderer  { class ShadingResultFrameBuffer; }
+
+namespace renderer
+{
+
+//
+// State shared by the threads cooperatively rendering a tile.
+//
+// The first participant starts the tile: it provides the framebuffer into which
+// all participants accumulate samples and the number of work items (pixels).
+// Work items are then claimed in fixed-size chunks by any participant, so that
+// idle threads can join a tile that is still being rendered and take over part
+// of the remaining pixels. When all participants have left, the last one to
+// leave finishes the tile (e.g. develops the framebuffer) then releases the
+// others, which can then safely perform their own end-of-tile work.
+//
+
+class CooperativeTile
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    explicit CooperativeTile(const size_t chunk_size);
+
+    // Destructor.
+    virtual ~CooperativeTile();
+
+    // Join the tile. Return false if there is no work left to claim. The first
+    // participant must call start() right after joining, before claiming work.
+    bool join(bool& first);
+
+    // Start the tile. Only the first participant may call this method.
+    void start(
+        ShadingResultFrameBuffer*   framebuffer,
+        const size_t                work_item_count);
+
+    // Return the framebuffer shared by all participants.
+    ShadingResultFrameBuffer* get_framebuffer() const;
+
+    // Claim the next chunk of work items [begin, end). Return false if all work
+    // items have already been claimed. Chunk indices are independent of which
+    // participant claims which chunk.
+    bool claim(
+        size_t&                     chunk_index,
+        size_t&                     begin,
+        size_t&                     end);
+
+    // Give up all unclaimed work items, e.g. when rendering is aborted.
+    void cancel();
+
+    // Leave the tile. Return true if the caller is the last participant; it must
+    // then finish the tile and call finish(). Other participants must call
+    // wait_until_finished() before doing any end-of-tile work.
+    bool leave();
+    void finish();
+    void wait_until_finished();
+
+  protected:
+    // Invoked each time a chunk of work is claimed, with the number of work
+    // items that remain to be claimed. Lets derived classes recruit helpers.
+    virtual void on_chunk_claimed(const size_t remaining_work_item_count);
+
+  private:
+    const size_t                    m_chunk_size;
+    boost::mutex                    m_mutex;
+    boost::condition_variable_any   m_finished_event;
+    ShadingResultFrameBuffer*       m_framebuffer;
+    size_t                          m_work_item_count;
+    size_t                          m_next_work_item;
+    size_t                          m_participant_count;
+    bool                            m_started;
+    bool                            m_finished;
+};
+
+
+//
+// CooperativeTile class implementation.
+//
+
+inline ShadingResultFrameBuffer* CooperativeTile::get_framebuffer() const
+{
+    return m_framebuffer;
+}
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_KERNEL_RENDERING_COOPERATIVETILE_H
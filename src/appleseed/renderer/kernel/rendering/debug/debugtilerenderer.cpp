@@ -68,11 +68,12 @@ namespace
         }
 
         virtual void render_tile(
-            const Frame&    frame,
-            const size_t    tile_x,
-            const size_t    tile_y,
-            const size_t    pass_hash,
-            IAbortSwitch&   abort_switch) APPLESEED_OVERRIDE
+            const Frame&        frame,
+            const size_t        tile_x,
+            const size_t        tile_y,
+            const size_t        pass_hash,
+            CooperativeTile*    cooperative_tile,
+            IAbortSwitch&       abort_switch) APPLESEED_OVERRIDE
         {
             Image& image = frame.image();
 
@@ -131,7 +131,13 @@ namespace
                     frame.get_filter()));
 
             if (m_params.m_diagnostics)
+            {
                 m_diagnostics.reset(new Tile(tile.get_width(), tile.get_height(), 2, PixelFormatFloat));
+
+                // Mark all pixels as not rendered by this thread: when a tile is rendered
+                // cooperatively, other threads are responsible for the other pixels.
+                m_diagnostics->clear(Color<float, 2>(-1.0f));
+            }
         }
 
         virtual void on_tile_end(
@@ -151,6 +157,9 @@ namespace
                         Color<float, 2> values;
                         m_diagnostics->get_pixel(x, y, values);
 
+                        if (values[0] < 0.0f)
+                            continue;
+
                         if (m_variation_aov_index != size_t(~0))
                             aov_tiles.set_pixel(x, y, m_variation_aov_index, scalar_to_color(values[0]));
 
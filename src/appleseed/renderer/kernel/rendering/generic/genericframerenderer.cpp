@@ -168,10 +168,12 @@ namespace
                 new PassManagerFunc(
                     m_frame,
                     m_params.m_tile_ordering,
+                    m_params.m_tile_splitting,
                     m_params.m_pass_count,
                     m_tile_renderers,
                     m_tile_callbacks,
                     m_pass_callback,
+                    m_tile_job_factory,
                     m_job_queue,
                     m_abort_switch,
                     m_is_rendering));
@@ -216,11 +218,13 @@ namespace
         {
             const size_t                        m_thread_count;     // number of rendering threads
             const TileJobFactory::TileOrdering  m_tile_ordering;    // tile rendering order
+            const bool                          m_tile_splitting;   // let idle threads help rendering unfinished tiles
             const size_t                        m_pass_count;       // number of rendering passes
 
             explicit Parameters(const ParamArray& params)
               : m_thread_count(get_rendering_thread_count(params))
               , m_tile_ordering(get_tile_ordering(params))
+              , m_tile_splitting(params.get_optional<bool>("tile_splitting", false))
               , m_pass_count(params.get_optional<size_t>("passes", 1))
             {
             }
@@ -246,6 +250,10 @@ namespace
                 {
                     return TileJobFactory::RandomOrdering;
                 }
+                else if (tile_ordering == "cost")
+                {
+                    return TileJobFactory::CostOrdering;
+                }
                 else
                 {
                     RENDERER_LOG_ERROR(
@@ -266,19 +274,23 @@ namespace
             PassManagerFunc(
                 const Frame&                        frame,
                 const TileJobFactory::TileOrdering  tile_ordering,
+                const bool                          tile_splitting,
                 const size_t                        pass_count,
                 vector<ITileRenderer*>&             tile_renderers,
                 vector<ITileCallback*>&             tile_callbacks,
                 IPassCallback*                      pass_callback,
+                TileJobFactory&                     tile_job_factory,
                 JobQueue&                           job_queue,
                 IAbortSwitch&                       abort_switch,
                 bool&                               is_rendering)
               : m_frame(frame)
               , m_tile_ordering(tile_ordering)
+              , m_tile_splitting(tile_splitting)
               , m_pass_count(pass_count)
               , m_tile_renderers(tile_renderers)
               , m_tile_callbacks(tile_callbacks)
               , m_pass_callback(pass_callback)
+              , m_tile_job_factory(tile_job_factory)
               , m_job_queue(job_queue)
               , m_abort_switch(abort_switch)
               , m_is_rendering(is_rendering)
@@ -306,9 +318,11 @@ namespace
                     m_tile_job_factory.create(
                         m_frame,
                         m_tile_ordering,
+                        m_tile_splitting,
                         m_tile_renderers,
                         m_tile_callbacks,
                         pass_hash,
+                        m_job_queue,
                         tile_jobs,
                         m_abort_switch);
 
@@ -334,14 +348,15 @@ namespace
           private:
             const Frame&                            m_frame;
             const TileJobFactory::TileOrdering      m_tile_ordering;
+            const bool                              m_tile_splitting;
+            const size_t                            m_pass_count;
             vector<ITileRenderer*>&                 m_tile_renderers;
             vector<ITileCallback*>&                 m_tile_callbacks;
             IPassCallback*                          m_pass_callback;
-            const size_t                            m_pass_count;
+            TileJobFactory&                         m_tile_job_factory;
             JobQueue&                               m_job_queue;
             IAbortSwitch&                           m_abort_switch;
             bool&                                   m_is_rendering;
-            TileJobFactory                          m_tile_job_factory;
         };
 
         const Frame&                m_frame;            // target framebuffer
@@ -355,7 +370,7 @@ namespace
         vector<ITileCallback*>      m_tile_callbacks;   // tile callbacks, none or one per thread
         IPassCallback*              m_pass_callback;
 
-        TileJobFactory              m_tile_job_factory;
+        TileJobFactory              m_tile_job_factory; // shared by all renders so that tile times carry over
 
         bool                        m_is_rendering;
         auto_ptr<PassManagerFunc>   m_pass_manager_func;
@@ -442,7 +457,7 @@ Dictionary GenericFrameRendererFactory::get_params_metadata()
         "tile_ordering",
         Dictionary()
             .insert("type", "enum")
-            .insert("values", "linear|spiral|hilbert|random")
+            .insert("values", "linear|spiral|hilbert|random|cost")
             .insert("default", "spiral")
             .insert("label", "Tile Order")
             .insert("help", "Tile rendering order")
@@ -468,7 +483,20 @@ Dictionary GenericFrameRendererFactory::get_params_metadata()
                         "random",
                         Dictionary()
                             .insert("label", "Random")
-                            .insert("help", "Random tile ordering"))));
+                            .insert("help", "Random tile ordering"))
+                    .insert(
+                        "cost",
+                        Dictionary()
+                            .insert("label", "Cost")
+                            .insert("help", "Most expensive tiles first, based on the previous pass or render"))));
+
+    metadata.dictionaries().insert(
+        "tile_splitting",
+        Dictionary()
+            .insert("type", "bool")
+            .insert("default", "false")
+            .insert("label", "Tile Splitting")
+            .insert("help", "Let idle threads help rendering unfinished tiles"));
 
     return metadata;
 }
@@ -45,12 +45,15 @@
 // appleseed.foundation headers.
 #include "foundation/image/canvasproperties.h"
 #include "foundation/image/image.h"
+#include "foundation/math/aabb.h"
+#include "foundation/math/hash.h"
 #include "foundation/math/population.h"
 #include "foundation/math/qmc.h"
 #include "foundation/math/scalar.h"
 #include "foundation/math/vector.h"
 #include "foundation/platform/types.h"
 #include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/iostreamop.h"
 #include "foundation/utility/statistics.h"
 
 // Standard headers.
@@ -68,6 +71,45 @@ namespace renderer
 
 namespace
 {
+    //
+    // The focus region is a rectangle of the frame, expressed in pixels, that receives
+    // a larger share of the samples (for instance the region around the mouse cursor
+    // or around an object picked in the viewport). It is specified with the parameters:
+    //
+    //   focus_region             min_x min_y max_x max_y (inclusive pixel coordinates)
+    //   focus_sample_fraction    fraction of all samples placed in the focus region,
+    //                            at most MaxFocusSampleFraction so that the rest of
+    //                            the frame keeps converging
+    //
+    // Return the fraction of samples that must be placed in the focus region (zero if
+    // there is no focus region) and the focus region clipped to the crop window.
+    //
+
+    const float MaxFocusSampleFraction = 0.9f;
+
+    float get_focus_region(
+        const Frame&            frame,
+        const ParamArray&       params,
+        AABB2u&                 focus_region)
+    {
+        if (!params.strings().exist("focus_region"))
+            return 0.0f;
+
+        focus_region =
+            AABB2u::intersect(
+                params.get<AABB2u>("focus_region"),
+                frame.get_crop_window());
+
+        if (!focus_region.is_valid())
+            return 0.0f;
+
+        return
+            clamp(
+                params.get_optional<float>("focus_sample_fraction", 0.5f),
+                0.0f,
+                MaxFocusSampleFraction);
+    }
+
     class GenericSampleGenerator
       : public SampleGeneratorBase
     {
@@ -92,6 +134,12 @@ namespace
           , m_window_width_next_pow2(next_power(static_cast<double>(m_window_width), 2.0))
           , m_window_height_next_pow3(next_power(static_cast<double>(m_window_height), 3.0))
         {
+            // Quantize the focus sample fraction so that it can be compared against a 32-bit hash.
+            AABB2u focus_region;
+            const float focus_sample_fraction = get_focus_region(frame, params, focus_region);
+            m_focus_threshold = static_cast<uint64>(static_cast<double>(focus_sample_fraction) * 4294967296.0);
+            m_focus_origin = Vector2d(focus_region.min);
+            m_focus_extent = Vector2d(focus_region.extent()) + Vector2d(1.0);
         }
 
         virtual void release() APPLESEED_OVERRIDE
@@ -144,6 +192,10 @@ namespace
         const double                        m_window_width_next_pow2;
         const double                        m_window_height_next_pow3;
 
+        uint64                              m_focus_threshold;
+        Vector2d                            m_focus_origin;
+        Vector2d                            m_focus_extent;
+
         Population<uint64>                  m_total_sampling_dim;
         Population<uint64>                  m_total_sampling_inst;
 
@@ -155,24 +207,48 @@ namespace
             const size_t Bases[2] = { 2, 3 };
             const Vector2d s = halton_sequence<double, 2>(Bases, sequence_index);
 
+            // Place a fraction of the samples in the focus region. The decision is based on
+            // a hash of the sequence index rather than on another Halton dimension to avoid
+            // correlations with the dimensions consumed by the sampling context.
+            if (hash_uint32(static_cast<uint32>(sequence_index)) < m_focus_threshold)
+            {
+                // Compute the coordinates of the sample in the focus region.
+                const Vector2d t(
+                    m_focus_origin[0] + s[0] * m_focus_extent[0],
+                    m_focus_origin[1] + s[1] * m_focus_extent[1]);
+
+                return render_sample(sequence_index, t, samples);
+            }
+
             // Compute the coordinates of the pixel in the padded crop window.
             const Vector2d t(s[0] * m_window_width_next_pow2, s[1] * m_window_height_next_pow3);
-            const int x = truncate<int>(t[0]);
-            const int y = truncate<int>(t[1]);
 
             // Reject samples that fall outside the actual frame.
-            if (x >= m_window_width || y >= m_window_height)
+            if (truncate<int>(t[0]) >= m_window_width || truncate<int>(t[1]) >= m_window_height)
                 return 0;
 
+            return
+                render_sample(
+                    sequence_index,
+                    Vector2d(m_window_origin_x + t[0], m_window_origin_y + t[1]),
+                    samples);
+        }
+
+        // Render a sample at a given position in continuous image space.
+        size_t render_sample(
+            const size_t                    sequence_index,
+            const Vector2d&                 t,
+            SampleVector&                   samples)
+        {
             // Transform the sample position back to NDC. Full precision divisions are required
             // to ensure that the sample position indeed lies in the [0,1)^2 interval.
             const Vector2d sample_position(
-                (m_window_origin_x + t[0]) / m_canvas_width,
-                (m_window_origin_y + t[1]) / m_canvas_height);
+                t[0] / m_canvas_width,
+                t[1] / m_canvas_height);
 
             // Create a pixel context that identifies the pixel and sample currently being rendered.
             const PixelContext pixel_context(
-                Vector2i(m_window_origin_x + x, m_window_origin_y + y),
+                Vector2i(truncate<int>(t[0]), truncate<int>(t[1])),
                 sample_position);
 
             // Create a sampling context. We start with an initial dimension of 2,
@@ -251,11 +327,16 @@ SampleAccumulationBuffer* GenericSampleGeneratorFactory::create_sample_accumulat
 {
     const CanvasProperties& props = m_frame.image().properties();
 
+    // Samples placed in the focus region don't contribute to the coverage of the rest of the frame.
+    AABB2u focus_region;
+    const float focus_sample_fraction = get_focus_region(m_frame, m_params, focus_region);
+
     return
         new LocalSampleAccumulationBuffer(
             props.m_canvas_width,
             props.m_canvas_height,
-            m_frame.get_filter());
+            m_frame.get_filter(),
+            1.0f - focus_sample_fraction);
 }
 
 }   // namespace renderer
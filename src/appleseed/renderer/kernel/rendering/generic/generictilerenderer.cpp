@@ -35,6 +35,7 @@
 #include "renderer/global/globaltypes.h"
 #include "renderer/kernel/aov/imagestack.h"
 #include "renderer/kernel/aov/tilestack.h"
+#include "renderer/kernel/rendering/cooperativetile.h"
 #include "renderer/kernel/rendering/ipixelrenderer.h"
 #include "renderer/kernel/rendering/ishadingresultframebufferfactory.h"
 #include "renderer/kernel/rendering/pixelcontext.h"
@@ -110,11 +111,12 @@ namespace
         }
 
         virtual void render_tile(
-            const Frame&    frame,
-            const size_t    tile_x,
-            const size_t    tile_y,
-            const size_t    pass_hash,
-            IAbortSwitch&   abort_switch) APPLESEED_OVERRIDE
+            const Frame&        frame,
+            const size_t        tile_x,
+            const size_t        tile_y,
+            const size_t        pass_hash,
+            CooperativeTile*    cooperative_tile,
+            IAbortSwitch&       abort_switch) APPLESEED_OVERRIDE
         {
             // Retrieve frame properties.
             const CanvasProperties& frame_properties = frame.image().properties();
@@ -126,6 +128,7 @@ namespace
             TileStack aov_tiles = frame.aov_images().tiles(tile_x, tile_y);
             const int tile_origin_x = static_cast<int>(frame_properties.m_tile_width * tile_x);
             const int tile_origin_y = static_cast<int>(frame_properties.m_tile_height * tile_y);
+            const Vector2i tile_origin(tile_origin_x, tile_origin_y);
 
             // Compute the image space bounding box of the pixels to render.
             AABB2i tile_bbox;
@@ -150,6 +153,26 @@ namespace
             padded_tile_bbox.max.x = tile_bbox.max.x + m_margin_width;
             padded_tile_bbox.max.y = tile_bbox.max.y + m_margin_height;
 
+            const size_t tile_index = tile_y * frame_properties.m_tile_count_x + tile_x;
+
+            if (cooperative_tile)
+            {
+                render_tile_cooperatively(
+                    frame,
+                    tile_x,
+                    tile_y,
+                    tile_index,
+                    tile,
+                    aov_tiles,
+                    tile_origin,
+                    tile_bbox,
+                    padded_tile_bbox,
+                    pass_hash,
+                    *cooperative_tile,
+                    abort_switch);
+                return;
+            }
+
             // Inform the pixel renderer that we are about to render a tile.
             m_pixel_renderer->on_tile_begin(frame, tile, aov_tiles);
 
@@ -167,19 +190,70 @@ namespace
             // debugging: rendering a subset of a tile may lead to different computations
             // than rendering the full tile, e.g. if the sampling context switches to random
             // sampling because the number of dimensions becomes too high.
-            const size_t tile_index = tile_y * frame_properties.m_tile_count_x + tile_x;
 #ifdef APPLESEED_ARCH64
             m_rng = SamplingContext::RNGType(hash_uint64_to_uint32(pass_hash ^ tile_index));
 #else
             m_rng = SamplingContext::RNGType(pass_hash ^ tile_index);
 #endif
 
-            // Loop over tile pixels.
-            for (size_t i = 0, e = m_pixel_ordering.size(); i < e; ++i)
+            // Loop over tile pixels. Cancel any work done on this tile if rendering is aborted.
+            if (!render_pixels(
+                    frame,
+                    tile,
+                    aov_tiles,
+                    tile_origin,
+                    tile_bbox,
+                    padded_tile_bbox,
+                    pass_hash,
+                    0,
+                    m_pixel_ordering.size(),
+                    *framebuffer,
+                    abort_switch))
+                return;
+
+            // Develop the framebuffer to the tile.
+            if (frame.is_premultiplied_alpha())
+                framebuffer->develop_to_tile_premult_alpha(tile, aov_tiles);
+            else framebuffer->develop_to_tile_straight_alpha(tile, aov_tiles);
+
+            // Release the framebuffer.
+            m_framebuffer_factory->destroy(framebuffer);
+
+            // Inform the pixel renderer that we are done rendering the tile.
+            m_pixel_renderer->on_tile_end(frame, tile, aov_tiles);
+        }
+
+        virtual StatisticsVector get_statistics() const APPLESEED_OVERRIDE
+        {
+            return m_pixel_renderer->get_statistics();
+        }
+
+      protected:
+        auto_release_ptr<IPixelRenderer>    m_pixel_renderer;
+        IShadingResultFrameBufferFactory*   m_framebuffer_factory;
+        int                                 m_margin_width;
+        int                                 m_margin_height;
+        vector<Vector<int16, 2> >           m_pixel_ordering;
+        SamplingContext::RNGType            m_rng;
+
+        // Render pixels [begin, end) of the pixel ordering. Return false if rendering was aborted.
+        bool render_pixels(
+            const Frame&                frame,
+            Tile&                       tile,
+            TileStack&                  aov_tiles,
+            const Vector2i&             tile_origin,
+            const AABB2i&               tile_bbox,
+            const AABB2i&               padded_tile_bbox,
+            const size_t                pass_hash,
+            const size_t                begin,
+            const size_t                end,
+            ShadingResultFrameBuffer&   framebuffer,
+            IAbortSwitch&               abort_switch)
+        {
+            for (size_t i = begin; i < end; ++i)
             {
-                // Cancel any work done on this tile if rendering is aborted.
                 if (abort_switch.is_aborted())
-                    return;
+                    return false;
 
                 // Retrieve the coordinates of the pixel in the padded tile.
                 const Vector2i pt(m_pixel_ordering[i].x, m_pixel_ordering[i].y);
@@ -188,7 +262,7 @@ namespace
                 if (!padded_tile_bbox.contains(pt))
                     continue;
 
-                const Vector2i pi(tile_origin_x + pt.x, tile_origin_y + pt.y);
+                const Vector2i pi(tile_origin.x + pt.x, tile_origin.y + pt.y);
 
 #ifdef DEBUG_BREAK_AT_PIXEL
 
@@ -208,33 +282,127 @@ namespace
                     pi,
                     pt,
                     m_rng,
-                    *framebuffer);
+                    framebuffer);
             }
 
-            // Develop the framebuffer to the tile.
-            if (frame.is_premultiplied_alpha())
-                framebuffer->develop_to_tile_premult_alpha(tile, aov_tiles);
-            else framebuffer->develop_to_tile_straight_alpha(tile, aov_tiles);
+            return true;
+        }
 
-            // Release the framebuffer.
-            m_framebuffer_factory->destroy(framebuffer);
+        void render_tile_cooperatively(
+            const Frame&                frame,
+            const size_t                tile_x,
+            const size_t                tile_y,
+            const size_t                tile_index,
+            Tile&                       tile,
+            TileStack&                  aov_tiles,
+            const Vector2i&             tile_origin,
+            const AABB2i&               tile_bbox,
+            const AABB2i&               padded_tile_bbox,
+            const size_t                pass_hash,
+            CooperativeTile&            cooperative_tile,
+            IAbortSwitch&               abort_switch)
+        {
+            // Bail out if there is nothing left to do on this tile.
+            bool first;
+            if (!cooperative_tile.join(first))
+                return;
 
-            // Inform the pixel renderer that we are done rendering the tile.
-            m_pixel_renderer->on_tile_end(frame, tile, aov_tiles);
+            // Inform the pixel renderer that we are about to render (part of) a tile.
+            m_pixel_renderer->on_tile_begin(frame, tile, aov_tiles);
+
+            // The first participant creates the framebuffer shared by all participants.
+            // Samples are accumulated into it with atomic updates.
+            if (first)
+            {
+                cooperative_tile.start(
+                    m_framebuffer_factory->create(
+                        frame,
+                        tile_x,
+                        tile_y,
+                        tile_bbox),
+                    m_pixel_ordering.size());
+            }
+
+            ShadingResultFrameBuffer* framebuffer = cooperative_tile.get_framebuffer();
+            assert(framebuffer);
+
+            try
+            {
+                // Render chunks of pixels until none is left.
+                size_t chunk_index, begin, end;
+                while (cooperative_tile.claim(chunk_index, begin, end))
+                {
+                    // Seed the RNG per chunk so that the result does not depend
+                    // on which thread renders which chunk.
+                    m_rng =
+                        SamplingContext::RNGType(
+                            mix_uint32(
+                                static_cast<uint32>(pass_hash),
+                                static_cast<uint32>(tile_index),
+                                static_cast<uint32>(chunk_index)));
+
+                    if (!render_pixels(
+                            frame,
+                            tile,
+                            aov_tiles,
+                            tile_origin,
+                            tile_bbox,
+                            padded_tile_bbox,
+                            pass_hash,
+                            begin,
+                            end,
+                            *framebuffer,
+                            abort_switch))
+                    {
+                        cooperative_tile.cancel();
+                        break;
+                    }
+                }
+            }
+            catch (...)
+            {
+                // Make sure the other participants don't wait for us forever.
+                cooperative_tile.cancel();
+                leave_cooperative_tile(frame, tile, aov_tiles, cooperative_tile, abort_switch);
+                throw;
+            }
+
+            leave_cooperative_tile(frame, tile, aov_tiles, cooperative_tile, abort_switch);
         }
 
-        virtual StatisticsVector get_statistics() const APPLESEED_OVERRIDE
+        void leave_cooperative_tile(
+            const Frame&                frame,
+            Tile&                       tile,
+            TileStack&                  aov_tiles,
+            CooperativeTile&            cooperative_tile,
+            IAbortSwitch&               abort_switch)
         {
-            return m_pixel_renderer->get_statistics();
-        }
+            ShadingResultFrameBuffer* framebuffer = cooperative_tile.get_framebuffer();
 
-      protected:
-        auto_release_ptr<IPixelRenderer>    m_pixel_renderer;
-        IShadingResultFrameBufferFactory*   m_framebuffer_factory;
-        int                                 m_margin_width;
-        int                                 m_margin_height;
-        vector<Vector<int16, 2> >           m_pixel_ordering;
-        SamplingContext::RNGType            m_rng;
+            if (cooperative_tile.leave())
+            {
+                // We are the last participant: develop the framebuffer to the tile.
+                if (!abort_switch.is_aborted())
+                {
+                    if (frame.is_premultiplied_alpha())
+                        framebuffer->develop_to_tile_premult_alpha(tile, aov_tiles);
+                    else framebuffer->develop_to_tile_straight_alpha(tile, aov_tiles);
+                }
+
+                m_framebuffer_factory->destroy(framebuffer);
+
+                cooperative_tile.finish();
+            }
+            else
+            {
+                // Wait until the last participant has developed the framebuffer.
+                cooperative_tile.wait_until_finished();
+            }
+
+            // Inform the pixel renderer that we are done rendering (part of) the tile.
+            if (!abort_switch.is_aborted())
+                m_pixel_renderer->on_tile_end(frame, tile, aov_tiles);
+        }
 
         void compute_tile_margins(const Frame& frame, const bool primary)
         {
@@ -39,6 +39,8 @@
 #include "foundation/image/canvasproperties.h"
 #include "foundation/image/image.h"
 #include "foundation/image/tile.h"
+#include "foundation/platform/defaulttimers.h"
+#include "foundation/utility/stopwatch.h"
 
 // Standard headers.
 #include <cassert>
@@ -61,6 +63,9 @@ TileJob::TileJob(
     const size_t                tile_x,
     const size_t                tile_y,
     const size_t                pass_hash,
+    double*                     tile_time,
+    CooperativeTile*            cooperative_tile,
+    const bool                  is_helper,
     IAbortSwitch&               abort_switch)
   : m_tile_renderers(tile_renderers)
   , m_tile_callbacks(tile_callbacks)
@@ -68,6 +73,9 @@ TileJob::TileJob(
   , m_tile_x(tile_x)
   , m_tile_y(tile_y)
   , m_pass_hash(pass_hash)
+  , m_tile_time(tile_time)
+  , m_cooperative_tile(cooperative_tile)
+  , m_is_helper(is_helper)
   , m_abort_switch(abort_switch)
 {
     // Either there is no tile callback, or there is the same number
@@ -75,12 +83,28 @@ TileJob::TileJob(
     assert(
            m_tile_callbacks.size() == 0
         || m_tile_callbacks.size() == tile_renderers.size());
+
+    // Helper jobs only make sense for cooperatively rendered tiles.
+    assert(!m_is_helper || m_cooperative_tile);
 }
 
 void TileJob::execute(const size_t thread_index)
 {
     assert(thread_index < m_tile_renderers.size());
 
+    // Help rendering a tile that another thread is responsible for.
+    if (m_is_helper)
+    {
+        m_tile_renderers[thread_index]->render_tile(
+            m_frame,
+            m_tile_x,
+            m_tile_y,
+            m_pass_hash,
+            m_cooperative_tile,
+            m_abort_switch);
+        return;
+    }
+
     // Retrieve the tile callback.
     ITileCallback* tile_callback =
         m_tile_callbacks.size() == m_tile_renderers.size()
@@ -103,6 +127,9 @@ void TileJob::execute(const size_t thread_index)
         tile_callback->pre_render(x, y, width, height);
     }
 
+    Stopwatch<DefaultWallclockTimer> stopwatch(0);
+    stopwatch.start();
+
     try
     {
         // Render the tile.
@@ -111,6 +138,7 @@ void TileJob::execute(const size_t thread_index)
             m_tile_x,
             m_tile_y,
             m_pass_hash,
+            m_cooperative_tile,
             m_abort_switch);
     }
     catch (const exception&)
@@ -123,6 +151,10 @@ void TileJob::execute(const size_t thread_index)
         throw;
     }
 
+    // Record the time spent rendering the tile, unless rendering was interrupted.
+    if (m_tile_time && !m_abort_switch.is_aborted())
+        *m_tile_time = stopwatch.measure().get_seconds();
+
     // Call the post-render tile callback.
     if (tile_callback)
         tile_callback->post_render_tile(&m_frame, m_tile_x, m_tile_y);
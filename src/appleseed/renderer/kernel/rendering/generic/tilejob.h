@@ -38,6 +38,7 @@
 #include <vector>
 
 // Forward declarations.
+namespace renderer  { class CooperativeTile; }
 namespace renderer  { class Frame; }
 namespace renderer  { class ITileCallback; }
 namespace renderer  { class ITileRenderer; }
@@ -56,7 +57,10 @@ class TileJob
     typedef std::vector<ITileRenderer*> TileRendererVector;
     typedef std::vector<ITileCallback*> TileCallbackVector;
 
-    // Constructor.
+    // Constructor. If tile_time is not null, the time in seconds spent
+    // rendering the tile is stored there once the job has been executed.
+    // If cooperative_tile is not null, other threads may help rendering
+    // the tile; helper jobs neither invoke tile callbacks nor record time.
     TileJob(
         const TileRendererVector&   tile_renderers,
         const TileCallbackVector&   tile_callbacks,
@@ -64,6 +68,9 @@ class TileJob
         const size_t                tile_x,
         const size_t                tile_y,
         const size_t                pass_hash,
+        double*                     tile_time,
+        CooperativeTile*            cooperative_tile,
+        const bool                  is_helper,
         foundation::IAbortSwitch&   abort_switch);
 
     // Execute the job.
@@ -76,6 +83,9 @@ class TileJob
     const size_t                    m_tile_x;
     const size_t                    m_tile_y;
     const size_t                    m_pass_hash;
+    double*                         m_tile_time;
+    CooperativeTile*                m_cooperative_tile;
+    const bool                      m_is_helper;
     foundation::IAbortSwitch&       m_abort_switch;
 };
 
@@ -31,15 +31,18 @@
 #include "tilejobfactory.h"
 
 // appleseed.renderer headers.
+#include "renderer/kernel/rendering/cooperativetile.h"
 #include "renderer/modeling/frame/frame.h"
 
 // appleseed.foundation headers.
 #include "foundation/image/canvasproperties.h"
 #include "foundation/image/image.h"
 #include "foundation/math/ordering.h"
+#include "foundation/utility/job.h"
 #include "foundation/utility/otherwise.h"
 
 // Standard headers.
+#include <algorithm>
 #include <cassert>
 
 using namespace foundation;
@@ -48,19 +51,129 @@ using namespace std;
 namespace renderer
 {
 
+namespace
+{
+    // Number of pixels claimed at once by the threads rendering a tile cooperatively.
+    const size_t CooperativeTileChunkSize = 32;
+
+    //
+    // A cooperative tile that schedules helper jobs when worker threads become idle.
+    //
+
+    class RecruitingCooperativeTile
+      : public CooperativeTile
+    {
+      public:
+        RecruitingCooperativeTile(
+            const TileJob::TileRendererVector&  tile_renderers,
+            const TileJob::TileCallbackVector&  tile_callbacks,
+            const Frame&                        frame,
+            const size_t                        tile_x,
+            const size_t                        tile_y,
+            const size_t                        pass_hash,
+            JobQueue&                           job_queue,
+            IAbortSwitch&                       abort_switch)
+          : CooperativeTile(CooperativeTileChunkSize)
+          , m_tile_renderers(tile_renderers)
+          , m_tile_callbacks(tile_callbacks)
+          , m_frame(frame)
+          , m_tile_x(tile_x)
+          , m_tile_y(tile_y)
+          , m_pass_hash(pass_hash)
+          , m_job_queue(job_queue)
+          , m_abort_switch(abort_switch)
+        {
+        }
+
+      protected:
+        virtual void on_chunk_claimed(const size_t remaining_work_item_count) APPLESEED_OVERRIDE
+        {
+            // Only share the tile if there are at least two chunks left.
+            const size_t remaining_chunk_count = remaining_work_item_count / CooperativeTileChunkSize;
+            if (remaining_chunk_count < 2)
+                return;
+
+            // Worker threads are only idle if there are no more scheduled jobs. This also
+            // prevents recruiting more helpers while the previous ones haven't started yet.
+            if (m_job_queue.has_scheduled_jobs())
+                return;
+
+            const size_t thread_count = m_tile_renderers.size();
+            const size_t running_job_count = m_job_queue.get_running_job_count();
+            if (running_job_count >= thread_count)
+                return;
+
+            const size_t helper_count =
+                min(thread_count - running_job_count, remaining_chunk_count - 1);
+
+            for (size_t i = 0; i < helper_count; ++i)
+            {
+                m_job_queue.schedule(
+                    new TileJob(
+                        m_tile_renderers,
+                        m_tile_callbacks,
+                        m_frame,
+                        m_tile_x,
+                        m_tile_y,
+                        m_pass_hash,
+                        0,
+                        this,
+                        true,
+                        m_abort_switch));
+            }
+        }
+
+      private:
+        const TileJob::TileRendererVector&  m_tile_renderers;
+        const TileJob::TileCallbackVector&  m_tile_callbacks;
+        const Frame&                        m_frame;
+        const size_t                        m_tile_x;
+        const size_t                        m_tile_y;
+        const size_t                        m_pass_hash;
+        JobQueue&                           m_job_queue;
+        IAbortSwitch&                       m_abort_switch;
+    };
+
+    struct DecreasingTileTimePredicate
+    {
+        const vector<double>& m_tile_times;
+
+        explicit DecreasingTileTimePredicate(const vector<double>& tile_times)
+          : m_tile_times(tile_times)
+        {
+        }
+
+        bool operator()(const size_t lhs, const size_t rhs) const
+        {
+            return m_tile_times[lhs] > m_tile_times[rhs];
+        }
+    };
+}
+
+
 //
 // TileJobFactory class implementation.
 //
 
+TileJobFactory::~TileJobFactory()
+{
+    clear_cooperative_tiles();
+}
+
 void TileJobFactory::create(
     const Frame&                        frame,
     const TileOrdering                  tile_ordering,
+    const bool                          tile_splitting,
     const TileJob::TileRendererVector&  tile_renderers,
     const TileJob::TileCallbackVector&  tile_callbacks,
     const size_t                        pass_hash,
+    JobQueue&                           job_queue,
     TileJobVector&                      tile_jobs,
     IAbortSwitch&                       abort_switch)
 {
+    // Cooperative tiles of the previous call are no longer referenced by any job.
+    clear_cooperative_tiles();
+
     // Retrieve frame properties.
     const CanvasProperties& props = frame.image().properties();
 
@@ -71,6 +184,12 @@ void TileJobFactory::create(
     // Make sure the right number of tiles was created.
     assert(tiles.size() == props.m_tile_count);
 
+    // Tile rendering times are only recorded for the cost-based ordering.
+    // Times from a frame with a different tile layout are meaningless.
+    const bool record_tile_times = tile_ordering == CostOrdering;
+    if (record_tile_times && m_tile_times.size() != props.m_tile_count)
+        m_tile_times.assign(props.m_tile_count, 0.0);
+
     // Create tile jobs, one per tile.
     for (size_t i = 0; i < props.m_tile_count; ++i)
     {
@@ -81,6 +200,23 @@ void TileJobFactory::create(
         assert(tile_x < props.m_tile_count_x);
         assert(tile_y < props.m_tile_count_y);
 
+        // Create the state shared by the threads that will render this tile.
+        CooperativeTile* cooperative_tile = 0;
+        if (tile_splitting)
+        {
+            cooperative_tile =
+                new RecruitingCooperativeTile(
+                    tile_renderers,
+                    tile_callbacks,
+                    frame,
+                    tile_x,
+                    tile_y,
+                    pass_hash,
+                    job_queue,
+                    abort_switch);
+            m_cooperative_tiles.push_back(cooperative_tile);
+        }
+
         // Create the tile job.
         tile_jobs.push_back(
             new TileJob(
@@ -90,10 +226,21 @@ void TileJobFactory::create(
                 tile_x,
                 tile_y,
                 pass_hash,
+                record_tile_times ? &m_tile_times[tile_index] : 0,
+                cooperative_tile,
+                false,
                 abort_switch));
     }
 }
 
+void TileJobFactory::clear_cooperative_tiles()
+{
+    for (size_t i = 0; i < m_cooperative_tiles.size(); ++i)
+        delete m_cooperative_tiles[i];
+
+    m_cooperative_tiles.clear();
+}
+
 void TileJobFactory::generate_tile_ordering(
     const CanvasProperties&             frame_properties,
     const TileOrdering                  tile_ordering,
@@ -128,8 +275,33 @@ void TileJobFactory::generate_tile_ordering(
             m_rng);
         break;
 
+      case CostOrdering:
+        generate_cost_ordering(frame_properties, tiles);
+        break;
+
       assert_otherwise;
     }
 }
 
+void TileJobFactory::generate_cost_ordering(
+    const CanvasProperties&             frame_properties,
+    vector<size_t>&                     tiles) const
+{
+    // Start from a Hilbert ordering: it is used as is when no tile has been rendered
+    // yet, and it keeps neighboring tiles of equal cost together otherwise.
+    hilbert_ordering(
+        tiles,
+        frame_properties.m_tile_count_x,
+        frame_properties.m_tile_count_y);
+
+    // Render the most expensive tiles first so that cheap tiles fill the gaps at the end.
+    if (m_tile_times.size() == frame_properties.m_tile_count)
+    {
+        stable_sort(
+            tiles.begin(),
+            tiles.end(),
+            DecreasingTileTimePredicate(m_tile_times));
+    }
+}
+
 }   // namespace renderer
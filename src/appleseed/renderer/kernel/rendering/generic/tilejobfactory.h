@@ -34,6 +34,7 @@
 #include "renderer/kernel/rendering/generic/tilejob.h"
 
 // appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
 #include "foundation/math/rng/mersennetwister.h"
 
 // Standard headers.
@@ -43,6 +44,8 @@
 // Forward declarations.
 namespace foundation    { class CanvasProperties; }
 namespace foundation    { class IAbortSwitch; }
+namespace foundation    { class JobQueue; }
+namespace renderer      { class CooperativeTile; }
 namespace renderer      { class Frame; }
 namespace renderer      { class TileJob; }
 
@@ -54,6 +57,7 @@ namespace renderer
 //
 
 class TileJobFactory
+  : public foundation::NonCopyable
 {
   public:
     typedef std::vector<TileJob*> TileJobVector;
@@ -64,26 +68,43 @@ class TileJobFactory
         LinearOrdering,
         SpiralOrdering,
         HilbertOrdering,
-        RandomOrdering
+        RandomOrdering,
+        CostOrdering        // most expensive tiles first, based on the previous pass or render
     };
 
-    // Create tile jobs for a given frame.
+    // Destructor.
+    ~TileJobFactory();
+
+    // Create tile jobs for a given frame. If tile_splitting is true, tiles are
+    // rendered cooperatively: while a tile is being rendered and worker threads
+    // become idle, helper jobs are scheduled into job_queue to share the rest of
+    // the tile. The jobs created by a previous call must all have completed.
     void create(
         const Frame&                        frame,
         const TileOrdering                  tile_ordering,
+        const bool                          tile_splitting,
         const TileJob::TileRendererVector&  tile_renderers,
         const TileJob::TileCallbackVector&  tile_callbacks,
         const size_t                        pass_hash,
+        foundation::JobQueue&               job_queue,
         TileJobVector&                      tile_jobs,
         foundation::IAbortSwitch&           abort_switch);
 
   private:
     foundation::MersenneTwister             m_rng;
+    std::vector<double>                     m_tile_times;       // tile rendering times in seconds
+    std::vector<CooperativeTile*>           m_cooperative_tiles;
+
+    void clear_cooperative_tiles();
 
     void generate_tile_ordering(
         const foundation::CanvasProperties& frame_properties,
         const TileOrdering                  tile_ordering,
         std::vector<size_t>&                tiles);
+
+    void generate_cost_ordering(
+        const foundation::CanvasProperties& frame_properties,
+        std::vector<size_t>&                tiles) const;
 };
 
 }       // namespace renderer
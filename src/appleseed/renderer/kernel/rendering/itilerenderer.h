@@ -39,6 +39,7 @@
 // Forward declarations.
 namespace foundation    { class IAbortSwitch; }
 namespace foundation    { class StatisticsVector; }
+namespace renderer      { class CooperativeTile; }
 namespace renderer      { class Frame; }
 
 namespace renderer
@@ -52,12 +53,16 @@ class ITileRenderer
   : public foundation::IUnknown
 {
   public:
-    // Render a tile.
+    // Render a tile. If cooperative_tile is not null, the tile may be rendered
+    // by several threads at once, each of them calling this method with the
+    // same CooperativeTile object. Tile renderers that do not support this
+    // may simply ignore cooperative_tile: no other thread will then join.
     virtual void render_tile(
         const Frame&                frame,
         const size_t                tile_x,
         const size_t                tile_y,
         const size_t                pass_hash,
+        CooperativeTile*            cooperative_tile,
         foundation::IAbortSwitch&   abort_switch) = 0;
 
     // Retrieve performance statistics.
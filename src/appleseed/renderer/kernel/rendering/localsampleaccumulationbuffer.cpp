@@ -83,8 +83,12 @@ namespace renderer
 LocalSampleAccumulationBuffer::LocalSampleAccumulationBuffer(
     const size_t        width,
     const size_t        height,
-    const Filter2f&     filter)
+    const Filter2f&     filter,
+    const float         uniform_sample_fraction)
+  : m_uniform_sample_fraction(uniform_sample_fraction)
 {
+    assert(m_uniform_sample_fraction > 0.0f && m_uniform_sample_fraction <= 1.0f);
+
     const size_t MinSize = 32;
 
     size_t level_width = width;
@@ -136,7 +140,7 @@ void LocalSampleAccumulationBuffer::clear()
         m_levels[i]->clear();
 
         m_remaining_pixels[i] =
-            static_cast<int32>(m_levels[i]->get_pixel_count());
+            static_cast<int32>(m_levels[i]->get_pixel_count() / m_uniform_sample_fraction);
     }
 
     m_active_level = static_cast<uint32>(m_levels.size() - 1);
@@ -59,11 +59,14 @@ class LocalSampleAccumulationBuffer
   : public SampleAccumulationBuffer
 {
   public:
-    // Constructor.
+    // Constructor. `uniform_sample_fraction` is the fraction of the samples that are
+    // uniformly distributed over the frame; it delays the switch to finer levels when
+    // the remaining samples are concentrated in a focus region.
     LocalSampleAccumulationBuffer(
         const size_t                        width,
         const size_t                        height,
-        const foundation::Filter2f&         filter);
+        const foundation::Filter2f&         filter,
+        const float                         uniform_sample_fraction = 1.0f);
 
     // Destructor.
     ~LocalSampleAccumulationBuffer();
@@ -107,6 +110,7 @@ class LocalSampleAccumulationBuffer
         foundation::SleepWaitPolicy<5>
     > LockType;
 
+    const float                             m_uniform_sample_fraction;
     LockType                                m_lock;
     std::vector<foundation::FilteredTile*>  m_levels;
     boost::atomic<foundation::int32>*       m_remaining_pixels;
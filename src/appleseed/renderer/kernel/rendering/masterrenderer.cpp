@@ -43,16 +43,20 @@
 #include "renderer/modeling/input/inputbinder.h"
 #include "renderer/modeling/project/project.h"
 #include "renderer/modeling/scene/scene.h"
+#include "renderer/utility/settingsparsing.h"
 
 // appleseed.foundation headers.
 #include "foundation/platform/compiler.h"
 #include "foundation/platform/thread.h"
 #include "foundation/utility/job/iabortswitch.h"
+#include "foundation/utility/job/jobmanager.h"
+#include "foundation/utility/job/jobqueue.h"
 #include "foundation/utility/otherwise.h"
 #include "foundation/utility/statistics.h"
 
 // Standard headers.
 #include <cassert>
+#include <cstddef>
 #include <exception>
 #include <string>
 
@@ -232,7 +236,8 @@ IRendererController::Status MasterRenderer::initialize_and_render_frame_sequence
     // Create the texture store.
     TextureStore texture_store(
         *m_project.get_scene(),
-        m_params.child("texture_store"));
+        m_params.child("texture_store"),
+        m_texture_system);
 
     if (!initialize_shading_system(texture_store, abort_switch))
         return IRendererController::AbortRendering;
@@ -265,8 +270,9 @@ IRendererController::Status MasterRenderer::initialize_and_render_frame_sequence
     // Perform post-render rendering actions.
     m_project.get_scene()->on_render_end(m_project);
 
-    // Print texture store performance statistics.
+    // Print texture store and texture system performance statistics.
     RENDERER_LOG_DEBUG("%s", texture_store.get_statistics().to_string().c_str());
+    RENDERER_LOG_DEBUG("%s", get_texture_system_statistics().to_string().c_str());
 
     return status;
 }
@@ -284,9 +290,23 @@ IRendererController::Status MasterRenderer::render_frame_sequence(
         // of the scene which assumes the scene is up-to-date and ready to be rendered.
         m_renderer_controller->on_frame_begin();
 
+        // Create a job manager to prepare independent scene entities in parallel.
+        const size_t thread_count = get_rendering_thread_count(m_params);
+        JobQueue job_queue;
+        JobManager job_manager(
+            global_logger(),
+            job_queue,
+            thread_count,
+            JobManager::KeepRunningOnEmptyQueue);
+        if (thread_count > 1)
+            job_manager.start();
+
         // Perform pre-frame rendering actions. Don't proceed if that failed.
-        OnFrameBeginRecorder recorder;
-        if (!m_project.get_scene()->on_frame_begin(m_project, 0, recorder, &abort_switch))
+        OnFrameBeginRecorder recorder(thread_count > 1 ? &job_queue : 0);
+        const bool success = m_project.get_scene()->on_frame_begin(m_project, 0, recorder, &abort_switch);
+        job_manager.stop();
+        RENDERER_LOG_DEBUG("%s", recorder.get_statistics().to_string().c_str());
+        if (!success)
         {
             recorder.on_frame_end(m_project);
             m_renderer_controller->on_frame_end();
@@ -784,6 +784,21 @@ Dictionary ProgressiveFrameRendererFactory::get_params_metadata()
             .insert("label", "Max Samples")
             .insert("help", "Maximum number of samples per pixel"));
 
+    metadata.dictionaries().insert(
+        "focus_region",
+        Dictionary()
+            .insert("type", "text")
+            .insert("label", "Focus Region")
+            .insert("help", "Region of the frame receiving a larger share of the samples, as min_x min_y max_x max_y in pixels"));
+
+    metadata.dictionaries().insert(
+        "focus_sample_fraction",
+        Dictionary()
+            .insert("type", "float")
+            .insert("default", "0.5")
+            .insert("label", "Focus Sample Fraction")
+            .insert("help", "Fraction of the samples placed in the focus region, at most 0.9"));
+
     return metadata;
 }
 
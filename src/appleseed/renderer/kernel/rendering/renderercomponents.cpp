@@ -256,11 +256,17 @@ bool RendererComponents::create_sample_generator_factory()
             return false;
         }
 
+        // The focus region is exposed as a setting of the progressive frame renderer.
+        ParamArray params = get_child_and_inherit_globals(m_params, "generic_sample_generator");
+        const ParamArray progressive_params = m_params.child("progressive_frame_renderer");
+        copy_param(params, progressive_params, "focus_region");
+        copy_param(params, progressive_params, "focus_sample_fraction");
+
         m_sample_generator_factory.reset(
             new GenericSampleGeneratorFactory(
                 m_frame,
                 m_sample_renderer_factory.get(),
-                get_child_and_inherit_globals(m_params, "generic_sample_generator")));
+                params));
         return true;
     }
     else if (name == "lighttracing")
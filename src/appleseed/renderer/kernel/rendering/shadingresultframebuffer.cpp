@@ -31,6 +31,7 @@
 #include "shadingresultframebuffer.h"
 
 // appleseed.renderer headers.
+#include "renderer/kernel/aov/aovsettings.h"
 #include "renderer/kernel/aov/tilestack.h"
 #include "renderer/kernel/shading/shadingfragment.h"
 #include "renderer/kernel/shading/shadingresult.h"
@@ -70,8 +71,8 @@ ShadingResultFrameBuffer::ShadingResultFrameBuffer(
         get_total_channel_count(aov_count),
         filter)
   , m_aov_count(aov_count)
-  , m_scratch(get_total_channel_count(aov_count))
 {
+    assert(m_aov_count <= MaxAOVCount);
 }
 
 ShadingResultFrameBuffer::ShadingResultFrameBuffer(
@@ -87,8 +88,8 @@ ShadingResultFrameBuffer::ShadingResultFrameBuffer(
         crop_window,
         filter)
   , m_aov_count(aov_count)
-  , m_scratch(get_total_channel_count(aov_count))
 {
+    assert(m_aov_count <= MaxAOVCount);
 }
 
 void ShadingResultFrameBuffer::add(
@@ -98,7 +99,10 @@ void ShadingResultFrameBuffer::add(
 {
     assert(sample.m_color_space == ColorSpaceLinearRGB);
 
-    float* ptr = &m_scratch[0];
+    // Stage the sample on the stack: several threads may add samples
+    // to the same framebuffer when tiles are rendered cooperatively.
+    float values[(1 + MaxAOVCount) * 4];
+    float* ptr = values;
 
     *ptr++ = sample.m_main.m_color[0];
     *ptr++ = sample.m_main.m_color[1];
@@ -115,7 +119,7 @@ void ShadingResultFrameBuffer::add(
         *ptr++ = aov.m_alpha[0];
     }
 
-    FilteredTile::add(x, y, &m_scratch[0]);
+    FilteredTile::add(x, y, values);
 }
 
 void ShadingResultFrameBuffer::merge(
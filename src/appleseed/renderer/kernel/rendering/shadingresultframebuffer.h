@@ -37,7 +37,6 @@
 
 // Standard headers.
 #include <cstddef>
-#include <vector>
 
 // Forward declarations.
 namespace foundation    { class Tile; }
@@ -88,7 +87,6 @@ class ShadingResultFrameBuffer
 
   private:
     const size_t                        m_aov_count;
-    std::vector<float>                  m_scratch;
 };
 
 }       // namespace renderer
@@ -1158,6 +1158,8 @@ CompositeClosure::CompositeClosure()
   : m_num_closures(0)
   , m_num_bytes(0)
 {
+    BOOST_STATIC_ASSERT(sizeof(ClosureEntry) == ClosureEntryAlignment);
+    assert(is_aligned(m_entries, ClosureEntryAlignment));
     assert(is_aligned(m_pool, InputValuesAlignment));
 }
 
@@ -1167,27 +1169,27 @@ void CompositeClosure::compute_cdf()
 
     if (closure_count == 1)
     {
-        m_pdf_weights[0] = 1.0f;
-        m_cdf[0] = 1.0f;
+        m_entries[0].m_pdf_weight = 1.0f;
+        m_entries[0].m_cdf = 1.0f;
     }
     else if (closure_count > 1)
     {
         float total_weight = 0.0f;
         for (size_t i = 0; i < closure_count; ++i)
         {
-            total_weight += m_pdf_weights[i];
-            m_cdf[i] = total_weight;
+            total_weight += m_entries[i].m_pdf_weight;
+            m_entries[i].m_cdf = total_weight;
         }
 
         const float rcp_total_weight = 1.0f / total_weight;
 
         for (size_t i = 0; i < closure_count; ++i)
-            m_pdf_weights[i] *= rcp_total_weight;
-
-        for (size_t i = 0; i < closure_count - 1; ++i)
-            m_cdf[i] *= rcp_total_weight;
+        {
+            m_entries[i].m_pdf_weight *= rcp_total_weight;
+            m_entries[i].m_cdf *= rcp_total_weight;
+        }
 
-        m_cdf[closure_count - 1] = 1.0f;
+        m_entries[closure_count - 1].m_cdf = 1.0f;
     }
 }
 
@@ -1205,7 +1207,17 @@ size_t CompositeClosure::choose_closure(SamplingContext& sampling_context) const
 
 size_t CompositeClosure::choose_closure(const float w) const
 {
-    return sample_cdf_linear_search(m_cdf, w);
+    assert(w >= 0.0f);
+    assert(w < 1.0f);
+
+    // Same as sample_cdf_linear_search() but reading the CDF from the packed entries.
+    size_t i = 0;
+
+    while (m_entries[i].m_cdf < w)
+        ++i;
+
+    assert(i < get_num_closures());
+    return i;
 }
 
 void CompositeClosure::compute_closure_shading_basis(
@@ -1216,7 +1228,7 @@ void CompositeClosure::compute_closure_shading_basis(
     if APPLESEED_LIKELY(normal_square_norm != 0.0f)
     {
         const float rcp_normal_norm = 1.0f / sqrt(normal_square_norm);
-        m_bases[m_num_closures] =
+        m_entries[m_num_closures].m_basis =
             Basis3f(
                 normal * rcp_normal_norm,
                 original_shading_basis.get_tangent_u());
@@ -1224,7 +1236,7 @@ void CompositeClosure::compute_closure_shading_basis(
     else
     {
         // Fallback to the original shading basis if the normal is zero.
-        m_bases[m_num_closures] = original_shading_basis;
+        m_entries[m_num_closures].m_basis = original_shading_basis;
     }
 }
 
@@ -1241,7 +1253,7 @@ void CompositeClosure::compute_closure_shading_basis(
         {
             const float rcp_normal_norm = 1.0f / sqrt(normal_square_norm);
             const float rcp_tangent_norm = 1.0f / sqrt(tangent_square_norm);
-            m_bases[m_num_closures] =
+            m_entries[m_num_closures].m_basis =
                 Basis3f(
                     normal * rcp_normal_norm,
                     tangent * rcp_tangent_norm);
@@ -1249,7 +1261,7 @@ void CompositeClosure::compute_closure_shading_basis(
         else
         {
             // Fallback to the original shading basis if the normal is zero.
-            m_bases[m_num_closures] = original_shading_basis;
+            m_entries[m_num_closures].m_basis = original_shading_basis;
         }
     }
     else
@@ -1319,19 +1331,19 @@ InputValues* CompositeClosure::do_add_closure(
     const float w = luminance(weight);
     assert(w > 0.0f);
 
-    m_pdf_weights[m_num_closures] = w;
-    m_weights[m_num_closures] = weight;
+    ClosureEntry& entry = m_entries[m_num_closures];
+    entry.m_type = closure_type;
+    entry.m_pdf_weight = w;
+    entry.m_weight = weight;
 
     if (!has_tangent)
         compute_closure_shading_basis(normal, original_shading_basis);
     else compute_closure_shading_basis(normal, tangent, original_shading_basis);
 
-    m_closure_types[m_num_closures] = closure_type;
-
     char* values_ptr = m_pool + m_num_bytes;
     assert(is_aligned(values_ptr, InputValuesAlignment));
     new (values_ptr) InputValues();
-    m_input_values[m_num_closures] = values_ptr;
+    entry.m_values_offset = static_cast<uint32>(m_num_bytes);
     m_num_bytes += align(sizeof(InputValues), InputValuesAlignment);
     ++m_num_closures;
 
@@ -1550,15 +1562,15 @@ InputValues* CompositeEmissionClosure::add_closure(
 
     assert(m_num_bytes + sizeof(InputValues) <= MaxPoolSize);
 
-    m_pdf_weights[m_num_closures] = max_weight_component;
-    m_weights[m_num_closures] = weight;
-
-    m_closure_types[m_num_closures] = closure_type;
+    ClosureEntry& entry = m_entries[m_num_closures];
+    entry.m_type = closure_type;
+    entry.m_pdf_weight = max_weight_component;
+    entry.m_weight = weight;
 
     char* values_ptr = m_pool + m_num_bytes;
     assert(is_aligned(values_ptr, InputValuesAlignment));
     new (values_ptr) InputValues();
-    m_input_values[m_num_closures] = values_ptr;
+    entry.m_values_offset = static_cast<uint32>(m_num_bytes);
     m_num_bytes += align(sizeof(InputValues), InputValuesAlignment);
     ++m_num_closures;
 
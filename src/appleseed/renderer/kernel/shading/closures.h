@@ -52,6 +52,7 @@
 #include "foundation/math/basis.h"
 #include "foundation/math/vector.h"
 #include "foundation/platform/compiler.h"
+#include "foundation/platform/types.h"
 
 // OSL headers.
 #include "foundation/platform/oslheaderguards.h"
@@ -152,13 +153,13 @@ struct ExceptionOSLRuntimeError
 // Composite OSL closure.
 //
 
-class APPLESEED_ALIGN(16) CompositeClosure
+class APPLESEED_ALIGN(64) CompositeClosure
   : public foundation::NonCopyable
 {
   public:
     size_t get_num_closures() const;
     ClosureID get_closure_type(const size_t index) const;
-    const Spectrum& get_closure_weight(const size_t index) const;
+    Spectrum get_closure_weight(const size_t index) const;
     float get_closure_pdf_weight(const size_t index) const;
     void* get_closure_input_values(const size_t index) const;
 
@@ -215,19 +216,32 @@ class APPLESEED_ALIGN(16) CompositeClosure
             boost::mpl::sizeof_<boost::mpl::_1> > >::type BiggestInputValueType;
 
     enum { InputValuesAlignment = 16 };
+    enum { ClosureEntryAlignment = 64 };    // size of a cache line
     enum { MaxClosureEntries = 16 };
     enum { MaxPoolSize = MaxClosureEntries * (sizeof(boost::mpl::deref<BiggestInputValueType::base>::type) + InputValuesAlignment) };
 
-    // m_pool has to be first, because it has to be aligned.
-    char                            m_pool[MaxPoolSize];
-    void*                           m_input_values[MaxClosureEntries];
-    ClosureID                       m_closure_types[MaxClosureEntries];
+    // Everything needed to select, evaluate and weight a closure, packed in a single
+    // cache line. Weights are always RGB and only promoted to Spectrum on access.
+    // Composite closures are placement-constructed at the start of the cache line
+    // aligned storage of InputEvaluator, so entries never straddle two cache lines.
+    struct APPLESEED_ALIGN(64) ClosureEntry
+    {
+        ClosureID                   m_type;
+        float                       m_pdf_weight;
+        float                       m_cdf;
+        foundation::uint32          m_values_offset;
+        foundation::Color3f         m_weight;
+        foundation::Basis3f         m_basis;
+    };
+
+    // The capacity is fixed because the closure lives in the InputEvaluator buffer,
+    // whose layout is sized statically. Entries and input values are filled front
+    // to back though, so the memory touched grows with the number of closures:
+    // the counters' cache line, one line per entry, and the used part of the pool.
     size_t                          m_num_closures;
     size_t                          m_num_bytes;
-    Spectrum                        m_weights[MaxClosureEntries];
-    float                           m_cdf[MaxClosureEntries];
-    float                           m_pdf_weights[MaxClosureEntries];
-    foundation::Basis3f             m_bases[MaxClosureEntries];
+    ClosureEntry                    m_entries[MaxClosureEntries];
+    char                            m_pool[MaxPoolSize];
 
     CompositeClosure();
 
@@ -248,7 +262,7 @@ class APPLESEED_ALIGN(16) CompositeClosure
 // Composite OSL surface closure.
 //
 
-class APPLESEED_ALIGN(16) CompositeSurfaceClosure
+class APPLESEED_ALIGN(64) CompositeSurfaceClosure
   : public CompositeClosure
 {
   public:
@@ -278,7 +292,7 @@ class APPLESEED_ALIGN(16) CompositeSurfaceClosure
 // Composite OSL subsurface closure.
 //
 
-class APPLESEED_ALIGN(16) CompositeSubsurfaceClosure
+class APPLESEED_ALIGN(64) CompositeSubsurfaceClosure
   : public CompositeClosure
 {
   public:
@@ -299,7 +313,7 @@ class APPLESEED_ALIGN(16) CompositeSubsurfaceClosure
 // Composite OSL emission closure.
 //
 
-class APPLESEED_ALIGN(16) CompositeEmissionClosure
+class APPLESEED_ALIGN(64) CompositeEmissionClosure
   : public CompositeClosure
 {
   public:
@@ -347,31 +361,31 @@ inline size_t CompositeClosure::get_num_closures() const
 inline ClosureID CompositeClosure::get_closure_type(const size_t index) const
 {
     assert(index < get_num_closures());
-    return m_closure_types[index];
+    return m_entries[index].m_type;
 }
 
-inline const Spectrum& CompositeClosure::get_closure_weight(const size_t index) const
+inline Spectrum CompositeClosure::get_closure_weight(const size_t index) const
 {
     assert(index < get_num_closures());
-    return m_weights[index];
+    return Spectrum(m_entries[index].m_weight);
 }
 
 inline float CompositeClosure::get_closure_pdf_weight(const size_t index) const
 {
     assert(index < get_num_closures());
-    return m_pdf_weights[index];
+    return m_entries[index].m_pdf_weight;
 }
 
 inline void* CompositeClosure::get_closure_input_values(const size_t index) const
 {
     assert(index < get_num_closures());
-    return m_input_values[index];
+    return const_cast<char*>(m_pool) + m_entries[index].m_values_offset;
 }
 
 inline const foundation::Basis3f& CompositeClosure::get_closure_shading_basis(const size_t index) const
 {
     assert(index < get_num_closures());
-    return m_bases[index];
+    return m_entries[index].m_basis;
 }
 
 }       // namespace renderer
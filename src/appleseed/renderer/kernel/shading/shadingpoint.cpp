@@ -171,9 +171,9 @@ void ShadingPoint::fetch_triangle_source_geometry() const
             // Fetch vertex normals from previous pose.
             if (base_index == 0)
             {
-                m_n0 = tess.m_vertex_normals[triangle.m_n0];
-                m_n1 = tess.m_vertex_normals[triangle.m_n1];
-                m_n2 = tess.m_vertex_normals[triangle.m_n2];
+                m_n0 = tess.get_vertex_normal(triangle.m_n0);
+                m_n1 = tess.get_vertex_normal(triangle.m_n1);
+                m_n2 = tess.get_vertex_normal(triangle.m_n2);
             }
             else
             {
@@ -198,9 +198,9 @@ void ShadingPoint::fetch_triangle_source_geometry() const
         }
         else
         {
-            m_n0 = tess.m_vertex_normals[triangle.m_n0];
-            m_n1 = tess.m_vertex_normals[triangle.m_n1];
-            m_n2 = tess.m_vertex_normals[triangle.m_n2];
+            m_n0 = tess.get_vertex_normal(triangle.m_n0);
+            m_n1 = tess.get_vertex_normal(triangle.m_n1);
+            m_n2 = tess.get_vertex_normal(triangle.m_n2);
         }
 
         assert(is_normalized(m_n0));
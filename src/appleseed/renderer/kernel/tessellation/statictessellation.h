@@ -36,11 +36,19 @@
 
 // appleseed.foundation headers.
 #include "foundation/core/concepts/noncopyable.h"
+#include "foundation/math/octahedral.h"
+#include "foundation/platform/exrheaderguards.h"
+#include "foundation/platform/types.h"
 #include "foundation/utility/attributeset.h"
 #include "foundation/utility/lazy.h"
 #include "foundation/utility/numerictype.h"
 #include "foundation/utility/poolallocator.h"
 
+// OpenEXR headers.
+BEGIN_EXR_INCLUDES
+#include "OpenEXR/half.h"
+END_EXR_INCLUDES
+
 // Standard headers.
 #include <cassert>
 #include <cstddef>
@@ -68,7 +76,6 @@ class StaticTessellation
 
     // Primary features.
     VectorArray                 m_vertices;
-    VectorArray                 m_vertex_normals;
     PrimitiveArray              m_primitives;
 
     // Additional attributes.
@@ -83,17 +90,26 @@ class StaticTessellation
     // Constructor.
     StaticTessellation();
 
+    // Insert and access vertex normals.
+    void reserve_vertex_normals(const size_t count);
+    size_t push_vertex_normal(const GVector3& normal);      // the normal must be unit-length
+    size_t get_vertex_normal_count() const;
+    GVector3 get_vertex_normal(const size_t index) const;
+    void clear_vertex_normals();
+
     // Insert and access texture coordinates.
     void reserve_tex_coords(const size_t count);
     size_t push_tex_coords(const GVector2& uv);
     size_t get_tex_coords_count() const;
     GVector2 get_tex_coords(const size_t index) const;
+    void clear_tex_coords();
 
     // Insert and access vertex tangents.
     void reserve_vertex_tangents(const size_t count);
     size_t push_vertex_tangent(const GVector3& tangent);    // the tangent must be unit-length
     size_t get_vertex_tangent_count() const;
     GVector3 get_vertex_tangent(const size_t index) const;
+    void clear_vertex_tangents();
 
     // Set/get the number of motion segments (the number of motion vectors per vertex).
     void set_motion_segment_count(const size_t count);
@@ -144,9 +160,21 @@ class StaticTessellation
     // Compute the local space bounding box of the tessellation over the shutter interval.
     GAABB3 compute_local_bbox() const;
 
+    // Store vertex normals and vertex tangents as 32-bit octahedral codes and texture
+    // coordinates as pairs of half floats. Existing and future attributes are converted
+    // on insertion and decoded on access. Normal and tangent poses remain uncompressed.
+    void compress_vertex_attributes();
+    bool has_compressed_vertex_attributes() const;
+
   private:
-    foundation::AttributeSet::ChannelID m_uv_0_cid;         // UV coordinates set #0
-    foundation::AttributeSet::ChannelID m_tangents_cid;     // per-vertex tangent vectors
+    typedef std::vector<foundation::uint32> PackedVectorArray;
+
+    VectorArray                 m_vertex_normals;
+    PackedVectorArray           m_packed_vertex_normals;
+    bool                        m_compressed_vertex_attributes;
+
+    foundation::AttributeSet::ChannelID m_uv_0_cid;         // UV coordinates set #0 (half floats when compressed)
+    foundation::AttributeSet::ChannelID m_tangents_cid;     // per-vertex tangent vectors (octahedral codes when compressed)
     foundation::AttributeSet::ChannelID m_ms_count_cid;     // motion segment count
     foundation::AttributeSet::ChannelID m_vp_cid;           // vertex poses
     foundation::AttributeSet::ChannelID m_vnp_cid;          // vertex normal poses
@@ -176,9 +204,33 @@ typedef foundation::AccessCache<
 // StaticTessellation class implementation.
 //
 
+namespace statictessellation_impl
+{
+    inline foundation::uint32 pack_tex_coords(const GVector2& uv)
+    {
+        const half u(static_cast<float>(uv[0]));
+        const half v(static_cast<float>(uv[1]));
+        return
+              static_cast<foundation::uint32>(u.bits())
+            | (static_cast<foundation::uint32>(v.bits()) << 16);
+    }
+
+    inline GVector2 unpack_tex_coords(const foundation::uint32 packed)
+    {
+        half u, v;
+        u.setBits(static_cast<unsigned short>(packed & 0xFFFF));
+        v.setBits(static_cast<unsigned short>(packed >> 16));
+        return
+            GVector2(
+                static_cast<GScalar>(static_cast<float>(u)),
+                static_cast<GScalar>(static_cast<float>(v)));
+    }
+}
+
 template <typename Primitive>
 inline StaticTessellation<Primitive>::StaticTessellation()
-  : m_uv_0_cid(foundation::AttributeSet::InvalidChannelID)
+  : m_compressed_vertex_attributes(false)
+  , m_uv_0_cid(foundation::AttributeSet::InvalidChannelID)
   , m_tangents_cid(foundation::AttributeSet::InvalidChannelID)
   , m_ms_count_cid(foundation::AttributeSet::InvalidChannelID)
   , m_vp_cid(foundation::AttributeSet::InvalidChannelID)
@@ -187,6 +239,58 @@ inline StaticTessellation<Primitive>::StaticTessellation()
 {
 }
 
+template <typename Primitive>
+inline void StaticTessellation<Primitive>::reserve_vertex_normals(const size_t count)
+{
+    if (m_compressed_vertex_attributes)
+        m_packed_vertex_normals.reserve(count);
+    else m_vertex_normals.reserve(count);
+}
+
+template <typename Primitive>
+inline size_t StaticTessellation<Primitive>::push_vertex_normal(const GVector3& normal)
+{
+    if (m_compressed_vertex_attributes)
+    {
+        const size_t index = m_packed_vertex_normals.size();
+        m_packed_vertex_normals.push_back(foundation::encode_octahedral(normal));
+        return index;
+    }
+    else
+    {
+        const size_t index = m_vertex_normals.size();
+        m_vertex_normals.push_back(normal);
+        return index;
+    }
+}
+
+template <typename Primitive>
+inline size_t StaticTessellation<Primitive>::get_vertex_normal_count() const
+{
+    return
+        m_compressed_vertex_attributes
+            ? m_packed_vertex_normals.size()
+            : m_vertex_normals.size();
+}
+
+template <typename Primitive>
+inline GVector3 StaticTessellation<Primitive>::get_vertex_normal(const size_t index) const
+{
+    assert(index < get_vertex_normal_count());
+
+    return
+        m_compressed_vertex_attributes
+            ? foundation::decode_octahedral<GScalar>(m_packed_vertex_normals[index])
+            : m_vertex_normals[index];
+}
+
+template <typename Primitive>
+inline void StaticTessellation<Primitive>::clear_vertex_normals()
+{
+    m_vertex_normals.clear();
+    m_packed_vertex_normals.clear();
+}
+
 template <typename Primitive>
 inline void StaticTessellation<Primitive>::reserve_tex_coords(const size_t count)
 {
@@ -202,7 +306,10 @@ inline size_t StaticTessellation<Primitive>::push_tex_coords(const GVector2& uv)
     if (m_uv_0_cid == foundation::AttributeSet::InvalidChannelID)
         create_uv_0_attribute();
 
-    return m_vertex_attributes.push_attribute(m_uv_0_cid, uv);
+    return
+        m_compressed_vertex_attributes
+            ? m_vertex_attributes.push_attribute(m_uv_0_cid, statictessellation_impl::pack_tex_coords(uv))
+            : m_vertex_attributes.push_attribute(m_uv_0_cid, uv);
 }
 
 template <typename Primitive>
@@ -219,12 +326,29 @@ inline GVector2 StaticTessellation<Primitive>::get_tex_coords(const size_t index
 {
     assert(m_uv_0_cid != foundation::AttributeSet::InvalidChannelID);
 
+    if (m_compressed_vertex_attributes)
+    {
+        foundation::uint32 packed;
+        m_vertex_attributes.get_attribute(m_uv_0_cid, index, &packed);
+        return statictessellation_impl::unpack_tex_coords(packed);
+    }
+
     GVector2 uv;
     m_vertex_attributes.get_attribute(m_uv_0_cid, index, &uv);
 
     return uv;
 }
 
+template <typename Primitive>
+void StaticTessellation<Primitive>::clear_tex_coords()
+{
+    if (m_uv_0_cid != foundation::AttributeSet::InvalidChannelID)
+    {
+        m_vertex_attributes.delete_channel(m_uv_0_cid);
+        m_uv_0_cid = foundation::AttributeSet::InvalidChannelID;
+    }
+}
+
 template <typename Primitive>
 inline void StaticTessellation<Primitive>::reserve_vertex_tangents(const size_t count)
 {
@@ -240,7 +364,10 @@ inline size_t StaticTessellation<Primitive>::push_vertex_tangent(const GVector3&
     if (m_tangents_cid == foundation::AttributeSet::InvalidChannelID)
         create_tangents_attribute();
 
-    return m_vertex_attributes.push_attribute(m_tangents_cid, tangent);
+    return
+        m_compressed_vertex_attributes
+            ? m_vertex_attributes.push_attribute(m_tangents_cid, foundation::encode_octahedral(tangent))
+            : m_vertex_attributes.push_attribute(m_tangents_cid, tangent);
 }
 
 template <typename Primitive>
@@ -257,12 +384,29 @@ inline GVector3 StaticTessellation<Primitive>::get_vertex_tangent(const size_t i
 {
     assert(m_tangents_cid != foundation::AttributeSet::InvalidChannelID);
 
+    if (m_compressed_vertex_attributes)
+    {
+        foundation::uint32 packed;
+        m_vertex_attributes.get_attribute(m_tangents_cid, index, &packed);
+        return foundation::decode_octahedral<GScalar>(packed);
+    }
+
     GVector3 tangent;
     m_vertex_attributes.get_attribute(m_tangents_cid, index, &tangent);
 
     return tangent;
 }
 
+template <typename Primitive>
+void StaticTessellation<Primitive>::clear_vertex_tangents()
+{
+    if (m_tangents_cid != foundation::AttributeSet::InvalidChannelID)
+    {
+        m_vertex_attributes.delete_channel(m_tangents_cid);
+        m_tangents_cid = foundation::AttributeSet::InvalidChannelID;
+    }
+}
+
 template <typename Primitive>
 inline void StaticTessellation<Primitive>::set_motion_segment_count(const size_t count)
 {
@@ -352,7 +496,7 @@ inline void StaticTessellation<Primitive>::set_vertex_normal_pose(
     const size_t    motion_segment_index,
     const GVector3& normal)
 {
-    assert(normal_index < m_vertex_normals.size());
+    assert(normal_index < get_vertex_normal_count());
 
     const size_t motion_segment_count = get_motion_segment_count();
     assert(motion_segment_index < motion_segment_count);
@@ -378,7 +522,7 @@ inline GVector3 StaticTessellation<Primitive>::get_vertex_normal_pose(
     const size_t    motion_segment_index) const
 {
     assert(m_vnp_cid != foundation::AttributeSet::InvalidChannelID);
-    assert(normal_index < m_vertex_normals.size());
+    assert(normal_index < get_vertex_normal_count());
 
     const size_t motion_segment_count = get_motion_segment_count();
     assert(motion_segment_index < motion_segment_count);
@@ -434,7 +578,7 @@ inline GVector3 StaticTessellation<Primitive>::get_vertex_tangent_pose(
     const size_t    motion_segment_index) const
 {
     assert(m_vtp_cid != foundation::AttributeSet::InvalidChannelID);
-    assert(tangent_index < m_vertex_normals.size());
+    assert(tangent_index < get_vertex_tangent_count());
 
     const size_t motion_segment_count = get_motion_segment_count();
     assert(motion_segment_index < motion_segment_count);
@@ -478,24 +622,98 @@ GAABB3 StaticTessellation<Primitive>::compute_local_bbox() const
     return bbox;
 }
 
+template <typename Primitive>
+void StaticTessellation<Primitive>::compress_vertex_attributes()
+{
+    if (m_compressed_vertex_attributes)
+        return;
+
+    // Fetch the uncompressed attributes.
+    std::vector<GVector2> tex_coords(get_tex_coords_count());
+    for (size_t i = 0, e = tex_coords.size(); i < e; ++i)
+        tex_coords[i] = get_tex_coords(i);
+
+    std::vector<GVector3> tangents(get_vertex_tangent_count());
+    for (size_t i = 0, e = tangents.size(); i < e; ++i)
+        tangents[i] = get_vertex_tangent(i);
+
+    const bool has_tex_coords = m_uv_0_cid != foundation::AttributeSet::InvalidChannelID;
+    const bool has_tangents = m_tangents_cid != foundation::AttributeSet::InvalidChannelID;
+
+    clear_tex_coords();
+    clear_vertex_tangents();
+
+    m_compressed_vertex_attributes = true;
+
+    // Vertex normals.
+    m_packed_vertex_normals.reserve(m_vertex_normals.size());
+    for (size_t i = 0, e = m_vertex_normals.size(); i < e; ++i)
+        m_packed_vertex_normals.push_back(foundation::encode_octahedral(m_vertex_normals[i]));
+    VectorArray().swap(m_vertex_normals);
+
+    // Texture coordinates.
+    if (has_tex_coords)
+    {
+        reserve_tex_coords(tex_coords.size());
+        for (size_t i = 0, e = tex_coords.size(); i < e; ++i)
+            push_tex_coords(tex_coords[i]);
+    }
+
+    // Vertex tangents.
+    if (has_tangents)
+    {
+        reserve_vertex_tangents(tangents.size());
+        for (size_t i = 0, e = tangents.size(); i < e; ++i)
+            push_vertex_tangent(tangents[i]);
+    }
+}
+
+template <typename Primitive>
+inline bool StaticTessellation<Primitive>::has_compressed_vertex_attributes() const
+{
+    return m_compressed_vertex_attributes;
+}
+
 template <typename Primitive>
 void StaticTessellation<Primitive>::create_uv_0_attribute()
 {
-    m_uv_0_cid =
-        m_vertex_attributes.create_channel(
-            "uv_0",
-            foundation::NumericType::id<GVector2::ValueType>(),
-            2);
+    if (m_compressed_vertex_attributes)
+    {
+        m_uv_0_cid =
+            m_vertex_attributes.create_channel(
+                "uv_0",
+                foundation::NumericTypeUInt32,
+                1);
+    }
+    else
+    {
+        m_uv_0_cid =
+            m_vertex_attributes.create_channel(
+                "uv_0",
+                foundation::NumericType::id<GVector2::ValueType>(),
+                2);
+    }
 }
 
 template <typename Primitive>
 void StaticTessellation<Primitive>::create_tangents_attribute()
 {
-    m_tangents_cid =
-        m_vertex_attributes.create_channel(
-            "tangents",
-            foundation::NumericType::id<GVector3::ValueType>(),
-            3);
+    if (m_compressed_vertex_attributes)
+    {
+        m_tangents_cid =
+            m_vertex_attributes.create_channel(
+                "tangents",
+                foundation::NumericTypeUInt32,
+                1);
+    }
+    else
+    {
+        m_tangents_cid =
+            m_vertex_attributes.create_channel(
+                "tangents",
+                foundation::NumericType::id<GVector3::ValueType>(),
+                3);
+    }
 }
 
 }       // namespace renderer
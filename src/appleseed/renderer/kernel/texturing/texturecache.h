@@ -35,6 +35,8 @@
 
 // appleseed.foundation headers.
 #include "foundation/core/concepts/noncopyable.h"
+#include "foundation/image/compressedtile.h"
+#include "foundation/image/tile.h"
 #include "foundation/math/hash.h"
 #include "foundation/platform/types.h"
 #include "foundation/utility/cache.h"
@@ -44,15 +46,16 @@
 // Standard headers.
 #include <cstddef>
 
-// Forward declarations.
-namespace foundation    { class Tile; }
-
 namespace renderer
 {
 
 //
 // A thread-local cache of texture tiles.
 //
+// Tiles kept compressed by the texture store are decompressed into tiles owned
+// by a smaller secondary cache, and their memory is accounted for by the store;
+// other tiles are shared with the texture store.
+//
 
 class TextureCache
   : public foundation::NonCopyable
@@ -76,7 +79,12 @@ class TextureCache
   private:
     typedef TextureStore::TileKey TileKey;
     typedef TextureStore::TileRecord TileRecord;
-    typedef TileRecord* TileRecordPtr;
+
+    struct CachedTile
+    {
+        TileRecord*         m_record;           // null if the tile is kept compressed by the store
+        foundation::Tile*   m_tile;             // null if the tile is kept compressed by the store
+    };
 
     struct TileKeyHasher
       : public foundation::NonCopyable
@@ -93,10 +101,27 @@ class TextureCache
         explicit TileRecordSwapper(TextureStore& store);
 
         // Load a cache line.
-        void load(const TileKey& key, TileRecordPtr& record);
+        void load(const TileKey& key, CachedTile& cached_tile);
+
+        // Unload a cache line.
+        void unload(const TileKey& key, CachedTile& cached_tile);
+
+      private:
+        TextureStore& m_store;
+    };
+
+    class DecompressedTileSwapper
+      : public foundation::NonCopyable
+    {
+      public:
+        // Constructor.
+        explicit DecompressedTileSwapper(TextureStore& store);
+
+        // Load a cache line.
+        void load(const TileKey& key, foundation::Tile*& tile);
 
         // Unload a cache line.
-        void unload(const TileKey& key, TileRecordPtr& record);
+        void unload(const TileKey& key, foundation::Tile*& tile);
 
       private:
         TextureStore& m_store;
@@ -105,15 +130,26 @@ class TextureCache
     typedef foundation::SACache<
         TileKey,
         TileKeyHasher,
-        TileRecordPtr,
+        CachedTile,
         TileRecordSwapper,
         512,                // number of cache lines
         4                   // number of ways
     > TileCache;
 
+    typedef foundation::SACache<
+        TileKey,
+        TileKeyHasher,
+        foundation::Tile*,
+        DecompressedTileSwapper,
+        16,                 // number of cache lines
+        4                   // number of ways
+    > DecompressedTileCache;
+
     TileKeyHasher           m_tile_key_hasher;
     TileRecordSwapper       m_tile_record_swapper;
     TileCache               m_tile_cache;
+    DecompressedTileSwapper m_decompressed_tile_swapper;
+    DecompressedTileCache   m_decompressed_tile_cache;
 };
 
 
@@ -124,6 +160,8 @@ class TextureCache
 inline TextureCache::TextureCache(TextureStore& store)
   : m_tile_record_swapper(store)
   , m_tile_cache(m_tile_key_hasher, m_tile_record_swapper, TileKey::invalid())
+  , m_decompressed_tile_swapper(store)
+  , m_decompressed_tile_cache(m_tile_key_hasher, m_decompressed_tile_swapper, TileKey::invalid())
 {
 }
 
@@ -134,15 +172,29 @@ inline foundation::Tile& TextureCache::get(
     const size_t                    tile_y)
 {
     const TileKey key(assembly_uid, texture_uid, tile_x, tile_y);
-    return *m_tile_cache.get(key)->m_tile;
+    const CachedTile& cached_tile = m_tile_cache.get(key);
+
+    return
+        cached_tile.m_tile
+            ? *cached_tile.m_tile
+            : *m_decompressed_tile_cache.get(key);
 }
 
 inline foundation::StatisticsVector TextureCache::get_statistics() const
 {
-    return
+    foundation::StatisticsVector vec =
         foundation::StatisticsVector::make(
             "texture cache statistics",
             foundation::make_single_stage_cache_stats(m_tile_cache));
+
+    if (m_decompressed_tile_cache.get_miss_count() > 0)
+    {
+        vec.insert(
+            "decompressed tile cache statistics",
+            foundation::make_single_stage_cache_stats(m_decompressed_tile_cache));
+    }
+
+    return vec;
 }
 
 inline foundation::uint64 TextureCache::get_hit_count() const
@@ -179,14 +231,56 @@ inline TextureCache::TileRecordSwapper::TileRecordSwapper(TextureStore& store)
 {
 }
 
-inline void TextureCache::TileRecordSwapper::load(const TileKey& key, TileRecordPtr& record)
+inline void TextureCache::TileRecordSwapper::load(const TileKey& key, CachedTile& cached_tile)
+{
+    TileRecord& record = m_store.acquire(key);
+
+    if (record.m_compressed_tile)
+    {
+        // The tile will be decompressed by the secondary cache.
+        cached_tile.m_record = 0;
+        cached_tile.m_tile = 0;
+        m_store.release(record);
+    }
+    else
+    {
+        cached_tile.m_record = &record;
+        cached_tile.m_tile = record.m_tile;
+    }
+}
+
+inline void TextureCache::TileRecordSwapper::unload(const TileKey& key, CachedTile& cached_tile)
+{
+    if (cached_tile.m_record)
+        m_store.release(*cached_tile.m_record);
+}
+
+
+//
+// TextureCache::DecompressedTileSwapper class implementation.
+//
+
+inline TextureCache::DecompressedTileSwapper::DecompressedTileSwapper(TextureStore& store)
+  : m_store(store)
+{
+}
+
+inline void TextureCache::DecompressedTileSwapper::load(const TileKey& key, foundation::Tile*& tile)
 {
-    record = &m_store.acquire(key);
+    TileRecord& record = m_store.acquire(key);
+    assert(record.m_compressed_tile);
+
+    // The decompressed tile doesn't depend on the store's copy anymore.
+    tile = record.m_compressed_tile->decompress();
+    m_store.release(record);
+
+    m_store.add_decompressed_tile(*tile);
 }
 
-inline void TextureCache::TileRecordSwapper::unload(const TileKey& key, TileRecordPtr& record)
+inline void TextureCache::DecompressedTileSwapper::unload(const TileKey& key, foundation::Tile*& tile)
 {
-    m_store.release(*record);
+    m_store.remove_decompressed_tile(*tile);
+    delete tile;
 }
 
 }       // namespace renderer
@@ -38,22 +38,31 @@
 #include "renderer/utility/paramarray.h"
 
 // appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
 #include "foundation/image/color.h"
 #include "foundation/image/colorspace.h"
+#include "foundation/image/compressedtile.h"
+#include "foundation/image/pixel.h"
 #include "foundation/image/tile.h"
 #include "foundation/utility/api/apistring.h"
 #include "foundation/utility/containers/dictionary.h"
 #include "foundation/utility/foreach.h"
+#include "foundation/utility/job.h"
 #include "foundation/utility/memory.h"
 #include "foundation/utility/statistics.h"
 #include "foundation/utility/string.h"
 
+// Boost headers.
+#include "boost/filesystem/path.hpp"
+
 // Standard headers.
 #include <algorithm>
 #include <string>
+#include <vector>
 
 using namespace foundation;
 using namespace std;
+namespace bf = boost::filesystem;
 
 namespace renderer
 {
@@ -63,18 +72,41 @@ namespace renderer
 //
 
 TextureStore::TextureStore(
-    const Scene&        scene,
-    const ParamArray&   params)
-  : m_tile_swapper(scene, params)
+    const Scene&            scene,
+    const ParamArray&       params,
+    OIIO::TextureSystem*    texture_system)
+  : m_tile_swapper(scene, params, texture_system)
   , m_tile_cache(m_tile_key_hasher, m_tile_swapper)
 {
 }
 
+void TextureStore::add_decompressed_tile(const Tile& tile)
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_tile_swapper.add_memory_size(tile.get_memory_size());
+}
+
+void TextureStore::remove_decompressed_tile(const Tile& tile)
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_tile_swapper.remove_memory_size(tile.get_memory_size());
+}
+
 StatisticsVector TextureStore::get_statistics() const
 {
     Statistics stats = make_single_stage_cache_stats(m_tile_cache);
     stats.insert_size("peak size", m_tile_swapper.get_peak_memory_size());
 
+    const uint64 prefetched_tile_count = m_tile_swapper.get_prefetched_tile_count();
+    if (prefetched_tile_count > 0)
+    {
+        stats.insert("prefetched tiles", prefetched_tile_count);
+        stats.insert_percent(
+            "used prefetched tiles",
+            m_tile_swapper.get_used_prefetched_tile_count(),
+            prefetched_tile_count);
+    }
+
     return StatisticsVector::make("texture store statistics", stats);
 }
 
@@ -89,7 +121,39 @@ Dictionary TextureStore::get_params_metadata()
             .insert("type", "int")
             .insert("default", DefaultTextureStoreSizeMB * 1024 * 1024)
             .insert("label", "Texture Cache Size")
-            .insert("help", "Texture cache size in bytes"));
+            .insert("help", "Texture cache size in bytes, shared with the OpenImageIO texture cache if the texture caches are unified"));
+
+    metadata.dictionaries().insert(
+        "unified_cache",
+        Dictionary()
+            .insert("type", "bool")
+            .insert("default", "true")
+            .insert("label", "Unified Texture Cache")
+            .insert("help", "Read texture files through OpenImageIO so that files also used by OSL shaders are only cached once, within a single texture cache size"));
+
+    metadata.dictionaries().insert(
+        "compress_tiles",
+        Dictionary()
+            .insert("type", "bool")
+            .insert("default", "false")
+            .insert("label", "Compress Texture Tiles")
+            .insert("help", "Keep texture tiles compressed in memory to fit more of them in the texture cache"));
+
+    metadata.dictionaries().insert(
+        "prefetch_threads",
+        Dictionary()
+            .insert("type", "int")
+            .insert("default", "0")
+            .insert("label", "Texture Prefetch Threads")
+            .insert("help", "Number of threads loading texture tiles in the background, 0 to disable prefetching"));
+
+    metadata.dictionaries().insert(
+        "max_prefetched_tiles",
+        Dictionary()
+            .insert("type", "int")
+            .insert("default", "256")
+            .insert("label", "Max Prefetched Texture Tiles")
+            .insert("help", "Maximum number of texture tiles loaded in the background and not used yet; their memory counts toward the texture cache size"));
 
     return metadata;
 }
@@ -101,6 +165,15 @@ Dictionary TextureStore::get_params_metadata()
 
 namespace
 {
+    // Return the amount of memory used by the tile of a tile record.
+    size_t get_tile_memory_size(const TextureStore::TileRecord& record)
+    {
+        return
+            record.m_compressed_tile
+                ? record.m_compressed_tile->get_memory_size()
+                : record.m_tile->get_memory_size();
+    }
+
     // Convert a tile from the sRGB color space to the linear RGB color space.
     void convert_tile_srgb_to_linear_rgb(Tile& tile)
     {
@@ -158,29 +231,112 @@ namespace
             }
         }
     }
+
+    bool get_oiio_type_desc(const PixelFormat pixel_format, OIIO::TypeDesc& type_desc)
+    {
+        switch (pixel_format)
+        {
+          case PixelFormatUInt8: type_desc = OIIO::TypeDesc::UINT8; return true;
+          case PixelFormatUInt16: type_desc = OIIO::TypeDesc::UINT16; return true;
+          case PixelFormatUInt32: type_desc = OIIO::TypeDesc::UINT32; return true;
+          case PixelFormatHalf: type_desc = OIIO::TypeDesc::HALF; return true;
+          case PixelFormatFloat: type_desc = OIIO::TypeDesc::FLOAT; return true;
+          case PixelFormatDouble: type_desc = OIIO::TypeDesc::DOUBLE; return true;
+          default: return false;
+        }
+    }
 }
 
+class TextureStore::TileSwapper::PrefetchJob
+  : public IJob
+{
+  public:
+    PrefetchJob(
+        TileSwapper&            swapper,
+        Texture&                texture,
+        const TileKey&          key)
+      : m_swapper(swapper)
+      , m_texture(texture)
+      , m_key(key)
+    {
+    }
+
+    virtual void execute(const size_t thread_index) APPLESEED_OVERRIDE
+    {
+        bool shared;
+        Tile* tile =
+            m_swapper.read_tile(
+                m_texture,
+                m_key.get_tile_x(),
+                m_key.get_tile_y(),
+                shared);
+
+        m_swapper.on_tile_prefetched(m_texture, m_key, tile, shared);
+    }
+
+  private:
+    TileSwapper&                m_swapper;
+    Texture&                    m_texture;
+    const TileKey               m_key;
+};
+
 TextureStore::TileSwapper::TileSwapper(
-    const Scene&        scene,
-    const ParamArray&   params)
+    const Scene&            scene,
+    const ParamArray&       params,
+    OIIO::TextureSystem*    texture_system)
   : m_scene(scene)
-  , m_params(params)
+  , m_params(params, texture_system != 0)
+  , m_texture_system(m_params.m_unified_cache ? texture_system : 0)
   , m_memory_size(0)
   , m_peak_memory_size(0)
+  , m_prefetched_memory_size(0)
+  , m_prefetch_stamp(0)
+  , m_prefetched_tile_count(0)
+  , m_used_prefetched_tile_count(0)
 {
     gather_assemblies(scene.assemblies());
+
+    if (m_texture_system)
+    {
+        RENDERER_LOG_INFO(
+            "texture files are read through oiio, texture store gets %s of the texture cache size.",
+            pretty_size(m_params.m_memory_limit).c_str());
+    }
+
+    if (m_params.m_prefetch_thread_count > 0)
+    {
+        m_prefetch_queue.reset(new JobQueue());
+        m_prefetch_job_manager.reset(
+            new JobManager(
+                global_logger(),
+                *m_prefetch_queue,
+                m_params.m_prefetch_thread_count,
+                JobManager::KeepRunningOnEmptyQueue));
+        m_prefetch_job_manager->start();
+    }
 }
 
-void TextureStore::TileSwapper::load(const TileKey& key, TileRecord& record)
+TextureStore::TileSwapper::~TileSwapper()
 {
-    // Fetch the texture container.
-    const TextureContainer& textures =
-        key.m_assembly_uid == UniqueID(~0)
-            ? m_scene.textures()
-            : m_assemblies[key.m_assembly_uid]->textures();
+    if (m_prefetch_queue.get())
+    {
+        // Cancel pending requests and wait until running ones are completed.
+        m_prefetch_queue->clear_scheduled_jobs();
+        m_prefetch_job_manager->stop();
+
+        // Release tiles that were loaded in the background but never used.
+        for (const_each<PrefetchedTileMap> i = m_prefetched_tiles; i; ++i)
+        {
+            if (i->second.m_tile)
+                discard_tile(*get_texture(i->first), i->first, i->second.m_tile, i->second.m_shared);
+        }
+    }
+}
 
+void TextureStore::TileSwapper::load(const TileKey& key, TileRecord& record)
+{
     // Fetch the texture.
-    Texture* texture = textures.get_by_uid(key.m_texture_uid);
+    Texture* texture = get_texture(key);
 
     if (m_params.m_track_tile_loading)
     {
@@ -192,30 +348,29 @@ void TextureStore::TileSwapper::load(const TileKey& key, TileRecord& record)
             texture->get_path().c_str());
     }
 
-    // Load the tile.
-    record.m_tile = texture->load_tile(key.get_tile_x(), key.get_tile_y());
+    // Load the tile, unless it was already loaded in the background.
+    if (!take_prefetched_tile(key, record))
+        record.m_tile = read_tile(*texture, key.get_tile_x(), key.get_tile_y(), record.m_shared);
+    record.m_compressed_tile = 0;
     record.m_owners = 0;
 
-    // Convert the tile to the linear RGB color space.
-    switch (texture->get_color_space())
+    // Only keep a compressed copy of tiles of file-backed textures.
+    if (m_params.m_compress_tiles && texture->get_filepath() != 0)
     {
-      case ColorSpaceLinearRGB:
-        break;
-
-      case ColorSpaceSRGB:
-        convert_tile_srgb_to_linear_rgb(*record.m_tile);
-        break;
-
-      case ColorSpaceCIEXYZ:
-        convert_tile_ciexyz_to_linear_rgb(*record.m_tile);
-        break;
+        record.m_compressed_tile = new CompressedTile(*record.m_tile);
+        discard_tile(*texture, key, record.m_tile, record.m_shared);
+        record.m_tile = 0;
+    }
 
-      assert_otherwise;
+    // Neighboring tiles are likely to be requested soon.
+    if (m_prefetch_queue.get())
+    {
+        m_resident_tiles.insert(key);
+        prefetch_neighbors(key, *texture);
     }
 
     // Track the amount of memory used by the tile cache.
-    m_memory_size += record.m_tile->get_memory_size();
-    m_peak_memory_size = max(m_peak_memory_size, m_memory_size);
+    add_memory_size(get_tile_memory_size(record));
 
     if (m_params.m_track_store_size)
     {
@@ -238,6 +393,18 @@ void TextureStore::TileSwapper::load(const TileKey& key, TileRecord& record)
     }
 }
 
+void TextureStore::TileSwapper::add_memory_size(const size_t size)
+{
+    m_memory_size += size;
+    m_peak_memory_size = max(m_peak_memory_size, m_memory_size + get_prefetched_memory_size());
+}
+
+void TextureStore::TileSwapper::remove_memory_size(const size_t size)
+{
+    assert(m_memory_size >= size);
+    m_memory_size -= size;
+}
+
 bool TextureStore::TileSwapper::unload(const TileKey& key, TileRecord& record)
 {
     // Cannot unload tiles that are still in use.
@@ -245,18 +412,13 @@ bool TextureStore::TileSwapper::unload(const TileKey& key, TileRecord& record)
         return false;
 
     // Track the amount of memory used by the tile cache.
-    const size_t tile_memory_size = record.m_tile->get_memory_size();
-    assert(m_memory_size >= tile_memory_size);
-    m_memory_size -= tile_memory_size;
+    remove_memory_size(get_tile_memory_size(record));
 
-    // Fetch the texture container.
-    const TextureContainer& textures =
-        key.m_assembly_uid == UniqueID(~0)
-            ? m_scene.textures()
-            : m_assemblies[key.m_assembly_uid]->textures();
+    if (m_prefetch_queue.get())
+        m_resident_tiles.erase(key);
 
     // Fetch the texture.
-    Texture* texture = textures.get_by_uid(key.m_texture_uid);
+    Texture* texture = get_texture(key);
 
     if (m_params.m_track_tile_unloading)
     {
@@ -269,7 +431,9 @@ bool TextureStore::TileSwapper::unload(const TileKey& key, TileRecord& record)
     }
 
     // Unload the tile.
-    texture->unload_tile(key.get_tile_x(), key.get_tile_y(), record.m_tile);
+    if (record.m_compressed_tile)
+        delete record.m_compressed_tile;
+    else discard_tile(*texture, key, record.m_tile, record.m_shared);
 
     // Successfully unloaded the tile.
     return true;
@@ -284,13 +448,279 @@ void TextureStore::TileSwapper::gather_assemblies(const AssemblyContainer& assem
     }
 }
 
+Texture* TextureStore::TileSwapper::get_texture(const TileKey& key)
+{
+    // Fetch the texture container.
+    const TextureContainer& textures =
+        key.m_assembly_uid == UniqueID(~0)
+            ? m_scene.textures()
+            : m_assemblies[key.m_assembly_uid]->textures();
+
+    // Fetch the texture.
+    return textures.get_by_uid(key.m_texture_uid);
+}
+
+size_t TextureStore::TileSwapper::get_prefetched_memory_size() const
+{
+    if (m_prefetch_queue.get() == 0)
+        return 0;
+
+    boost::mutex::scoped_lock lock(m_prefetch_mutex);
+
+    return m_prefetched_memory_size;
+}
+
+Tile* TextureStore::TileSwapper::read_tile(
+    Texture&                texture,
+    const size_t            tile_x,
+    const size_t            tile_y,
+    bool&                   shared)
+{
+    // Load the tile, preferably through the OIIO texture system.
+    Tile* tile = m_texture_system ? load_shared_tile(texture, tile_x, tile_y) : 0;
+    shared = tile != 0;
+    if (!shared)
+        tile = texture.load_tile(tile_x, tile_y);
+
+    // Convert the tile to the linear RGB color space.
+    switch (texture.get_color_space())
+    {
+      case ColorSpaceLinearRGB:
+        break;
+
+      case ColorSpaceSRGB:
+        convert_tile_srgb_to_linear_rgb(*tile);
+        break;
+
+      case ColorSpaceCIEXYZ:
+        convert_tile_ciexyz_to_linear_rgb(*tile);
+        break;
+
+      assert_otherwise;
+    }
+
+    return tile;
+}
+
+Tile* TextureStore::TileSwapper::load_shared_tile(
+    const Texture&          texture,
+    const size_t            tile_x,
+    const size_t            tile_y)
+{
+    // Only textures backed by a file can be read through OIIO.
+    const char* filepath = texture.get_filepath();
+    if (filepath == 0)
+        return 0;
+
+    // The layout of the tiles is dictated by the texture.
+    const CanvasProperties& props = const_cast<Texture&>(texture).properties();
+
+    OIIO::TypeDesc type_desc;
+    if (!get_oiio_type_desc(props.m_pixel_format, type_desc))
+        return 0;
+
+    const size_t tile_width = props.get_tile_width(tile_x);
+    const size_t tile_height = props.get_tile_height(tile_y);
+    const int x0 = static_cast<int>(tile_x * props.m_tile_width);
+    const int y0 = static_cast<int>(tile_y * props.m_tile_height);
+
+    Tile* tile =
+        new Tile(
+            tile_width,
+            tile_height,
+            props.m_channel_count,
+            props.m_pixel_format);
+
+    // OIIO premultiplies the texels of files that store straight alpha (PNG files, among
+    // the formats of the built-in file reader), while the built-in file reader returns them
+    // as stored. Such texels are fetched in floating point and unpremultiplied below.
+    const bool straight_alpha =
+        props.m_channel_count == 4 &&
+        lower_case(bf::path(filepath).extension().string()) == ".png";
+
+    vector<Color4f> texels;
+    if (straight_alpha)
+        texels.resize(tile->get_pixel_count());
+
+    OIIO::TextureOpt options;
+    if (!m_texture_system->get_texels(
+            OIIO::ustring(filepath),
+            options,
+            0,
+            x0, x0 + static_cast<int>(tile_width),
+            y0, y0 + static_cast<int>(tile_height),
+            0, 1,
+            0, static_cast<int>(props.m_channel_count),
+            straight_alpha ? OIIO::TypeDesc(OIIO::TypeDesc::FLOAT) : type_desc,
+            straight_alpha ? static_cast<void*>(&texels[0]) : tile->get_storage()))
+    {
+        // Fall back to the texture's own file reader.
+        const string message = trim_both(m_texture_system->geterror());
+        RENDERER_LOG_WARNING(
+            "failed to read texture file %s through oiio, falling back to built-in file reader: %s",
+            filepath,
+            message.c_str());
+        delete tile;
+        return 0;
+    }
+
+    if (straight_alpha)
+    {
+        unpremultiply_alpha(&texels[0], texels.size());
+
+        for (size_t i = 0; i < texels.size(); ++i)
+            tile->set_pixel(i, texels[i]);
+    }
+
+    return tile;
+}
+
+void TextureStore::TileSwapper::discard_tile(
+    Texture&                texture,
+    const TileKey&          key,
+    Tile*                   tile,
+    const bool              shared)
+{
+    if (shared)
+        delete tile;
+    else texture.unload_tile(key.get_tile_x(), key.get_tile_y(), tile);
+}
+
+bool TextureStore::TileSwapper::take_prefetched_tile(const TileKey& key, TileRecord& record)
+{
+    if (m_prefetch_queue.get() == 0)
+        return false;
+
+    boost::mutex::scoped_lock lock(m_prefetch_mutex);
+
+    const PrefetchedTileMap::iterator i = m_prefetched_tiles.find(key);
+    if (i == m_prefetched_tiles.end())
+        return false;
+
+    // If the tile is still being loaded, don't wait for it: the I/O thread
+    // will discard its copy once it notices that the request is gone.
+    Tile* tile = i->second.m_tile;
+    const bool shared = i->second.m_shared;
+    m_prefetched_tiles.erase(i);
+
+    if (tile == 0)
+        return false;
+
+    // The tile now counts toward the memory used by resident tiles.
+    assert(m_prefetched_memory_size >= tile->get_memory_size());
+    m_prefetched_memory_size -= tile->get_memory_size();
+
+    record.m_tile = tile;
+    record.m_shared = shared;
+    ++m_used_prefetched_tile_count;
+
+    return true;
+}
+
+void TextureStore::TileSwapper::prefetch_neighbors(const TileKey& key, Texture& texture)
+{
+    // Only file-backed textures are worth loading in the background.
+    if (texture.get_filepath() == 0)
+        return;
+
+    const CanvasProperties& props = texture.properties();
+    const size_t tile_x = key.get_tile_x();
+    const size_t tile_y = key.get_tile_y();
+
+    const size_t x_begin = tile_x > 0 ? tile_x - 1 : 0;
+    const size_t y_begin = tile_y > 0 ? tile_y - 1 : 0;
+    const size_t x_end = min(tile_x + 2, props.m_tile_count_x);
+    const size_t y_end = min(tile_y + 2, props.m_tile_count_y);
+
+    boost::mutex::scoped_lock lock(m_prefetch_mutex);
+
+    for (size_t y = y_begin; y < y_end; ++y)
+    {
+        for (size_t x = x_begin; x < x_end; ++x)
+        {
+            const TileKey neighbor_key(key.m_assembly_uid, key.m_texture_uid, x, y);
+
+            // Skip tiles that are already loaded or being loaded.
+            if (m_resident_tiles.find(neighbor_key) != m_resident_tiles.end() ||
+                m_prefetched_tiles.find(neighbor_key) != m_prefetched_tiles.end())
+                continue;
+
+            // Bound the number of prefetched tiles and keep them within the memory budget.
+            if ((m_prefetched_tiles.size() >= m_params.m_max_prefetched_tiles ||
+                 m_memory_size + m_prefetched_memory_size >= m_params.m_memory_limit) &&
+                !evict_prefetched_tile())
+                return;
+
+            PrefetchedTile& prefetched_tile = m_prefetched_tiles[neighbor_key];
+            prefetched_tile.m_tile = 0;
+            prefetched_tile.m_shared = false;
+            prefetched_tile.m_stamp = m_prefetch_stamp++;
+            ++m_prefetched_tile_count;
+
+            m_prefetch_queue->schedule(new PrefetchJob(*this, texture, neighbor_key));
+        }
+    }
+}
+
+bool TextureStore::TileSwapper::evict_prefetched_tile()
+{
+    PrefetchedTileMap::iterator oldest = m_prefetched_tiles.end();
+
+    for (PrefetchedTileMap::iterator i = m_prefetched_tiles.begin(), e = m_prefetched_tiles.end(); i != e; ++i)
+    {
+        if (i->second.m_tile &&
+            (oldest == m_prefetched_tiles.end() || i->second.m_stamp < oldest->second.m_stamp))
+            oldest = i;
+    }
+
+    if (oldest == m_prefetched_tiles.end())
+        return false;
+
+    assert(m_prefetched_memory_size >= oldest->second.m_tile->get_memory_size());
+    m_prefetched_memory_size -= oldest->second.m_tile->get_memory_size();
+
+    discard_tile(*get_texture(oldest->first), oldest->first, oldest->second.m_tile, oldest->second.m_shared);
+    m_prefetched_tiles.erase(oldest);
+
+    return true;
+}
+
+void TextureStore::TileSwapper::on_tile_prefetched(
+    Texture&                texture,
+    const TileKey&          key,
+    Tile*                   tile,
+    const bool              shared)
+{
+    boost::mutex::scoped_lock lock(m_prefetch_mutex);
+
+    const PrefetchedTileMap::iterator i = m_prefetched_tiles.find(key);
+
+    if (i != m_prefetched_tiles.end() && i->second.m_tile == 0)
+    {
+        i->second.m_tile = tile;
+        i->second.m_shared = shared;
+        m_prefetched_memory_size += tile->get_memory_size();
+    }
+    else
+    {
+        // The tile was loaded synchronously in the meantime.
+        discard_tile(texture, key, tile, shared);
+    }
+}
+
 
 //
 // TextureStore::TileSwapper::Parameters class implementation.
 //
 
-TextureStore::TileSwapper::Parameters::Parameters(const ParamArray& params)
-  : m_memory_limit(params.get_optional<size_t>("max_size", 256 * 1024 * 1024))
+TextureStore::TileSwapper::Parameters::Parameters(
+    const ParamArray&   params,
+    const bool          has_texture_system)
+  : m_unified_cache(has_texture_system && params.get_optional<bool>("unified_cache", true))
+  , m_memory_limit(params.get_optional<size_t>("max_size", 256 * 1024 * 1024) / (m_unified_cache ? 2 : 1))
+  , m_compress_tiles(params.get_optional<bool>("compress_tiles", false))
+  , m_prefetch_thread_count(params.get_optional<size_t>("prefetch_threads", 0))
+  , m_max_prefetched_tiles(params.get_optional<size_t>("max_prefetched_tiles", 256))
   , m_track_tile_loading(params.get_optional<bool>("track_tile_loading", false))
   , m_track_tile_unloading(params.get_optional<bool>("track_tile_unloading", false))
   , m_track_store_size(params.get_optional<bool>("track_store_size", false))
@@ -42,18 +42,30 @@
 #include "foundation/utility/cache.h"
 #include "foundation/utility/uid.h"
 
+// OpenImageIO headers.
+#include "foundation/platform/oiioheaderguards.h"
+BEGIN_OIIO_INCLUDES
+#include "OpenImageIO/texture.h"
+END_OIIO_INCLUDES
+
 // Standard headers.
 #include <cassert>
 #include <cstddef>
 #include <map>
+#include <memory>
+#include <set>
 
 // Forward declarations.
+namespace foundation    { class CompressedTile; }
 namespace foundation    { class Dictionary; }
+namespace foundation    { class JobManager; }
+namespace foundation    { class JobQueue; }
 namespace foundation    { class Statistics; }
 namespace foundation    { class Tile; }
 namespace renderer      { class Assemblies; }
 namespace renderer      { class ParamArray; }
 namespace renderer      { class Scene; }
+namespace renderer      { class Texture; }
 
 namespace renderer
 {
@@ -102,14 +114,33 @@ class TextureStore
 
     struct TileRecord
     {
-        foundation::Tile*           m_tile;
+        foundation::Tile*           m_tile;         // null if the tile is kept compressed
+        foundation::CompressedTile* m_compressed_tile;
         volatile foundation::uint32 m_owners;
+        bool                        m_shared;       // true if the tile was read through the OIIO texture system
     };
 
-    // Constructor.
+    // Constructor. If an OIIO texture system is provided and the "unified_cache" parameter
+    // is enabled (it is by default), tiles of file-backed textures are read through the
+    // texture system so that files also used by OSL shaders are only read and cached once.
+    // In that case, "max_size" is a single budget that the texture store and the OIIO
+    // texture cache split evenly.
+    // If the "prefetch_threads" parameter is positive, tiles neighboring a missed tile of a
+    // file-backed texture are loaded in the background by that many I/O threads. At most
+    // "max_prefetched_tiles" tiles wait to be used; they count toward the "max_size" budget.
+    // If the "compress_tiles" parameter is enabled, tiles of file-backed textures are kept
+    // in memory in compressed form; texture caches then hold a bounded number of decompressed
+    // copies, which also count toward the "max_size" budget.
     TextureStore(
-        const Scene&        scene,
-        const ParamArray&   params = ParamArray());
+        const Scene&            scene,
+        const ParamArray&       params = ParamArray(),
+        OIIO::TextureSystem*    texture_system = 0);
+
+    // Return true if tiles of file-backed textures are read through the OIIO texture system.
+    bool is_unified() const;
+
+    // Return the maximum amount of memory in bytes used by the texture store.
+    size_t get_memory_limit() const;
 
     // Acquire an element from the cache. Thread-safe.
     TileRecord& acquire(const TileKey& key);
@@ -117,6 +148,10 @@ class TextureStore
     // Release a previously-acquired element. Thread-safe.
     void release(TileRecord& record) const;
 
+    // Account for a tile decompressed by a texture cache, until it is deleted. Thread-safe.
+    void add_decompressed_tile(const foundation::Tile& tile);
+    void remove_decompressed_tile(const foundation::Tile& tile);
+
     // Retrieve performance statistics.
     foundation::StatisticsVector get_statistics() const;
 
@@ -135,8 +170,12 @@ class TextureStore
       public:
         // Constructor.
         TileSwapper(
-            const Scene&        scene,
-            const ParamArray&   params);
+            const Scene&            scene,
+            const ParamArray&       params,
+            OIIO::TextureSystem*    texture_system);
+
+        // Destructor.
+        ~TileSwapper();
 
         // Load a cache line.
         void load(const TileKey& key, TileRecord& record);
@@ -147,29 +186,112 @@ class TextureStore
         // Return true if the cache is full, false otherwise.
         bool is_full(const size_t element_count) const;
 
+        // Track the memory used by tiles decompressed outside of the cache.
+        void add_memory_size(const size_t size);
+        void remove_memory_size(const size_t size);
+
         // Return the peak memory size in bytes of the tile cache.
         size_t get_peak_memory_size() const;
 
+        // Return true if tiles of file-backed textures are read through the OIIO texture system.
+        bool is_unified() const;
+
+        // Return the maximum amount of memory in bytes used by the tile cache.
+        size_t get_memory_limit() const;
+
+        // Return the number of tiles loaded in the background, and how many of them were used.
+        foundation::uint64 get_prefetched_tile_count() const;
+        foundation::uint64 get_used_prefetched_tile_count() const;
+
       private:
+        class PrefetchJob;
+
         struct Parameters
         {
+            const bool      m_unified_cache;
             const size_t    m_memory_limit;
+            const bool      m_compress_tiles;
+            const size_t    m_prefetch_thread_count;
+            const size_t    m_max_prefetched_tiles;
             const bool      m_track_tile_loading;
             const bool      m_track_tile_unloading;
             const bool      m_track_store_size;
 
-            explicit Parameters(const ParamArray& params);
+            Parameters(
+                const ParamArray&   params,
+                const bool          has_texture_system);
         };
 
-        typedef std::map<foundation::UniqueID, const Assembly*> AssemblyMap;
+        struct PrefetchedTile
+        {
+            foundation::Tile*       m_tile;         // 0 while the tile is being loaded
+            bool                    m_shared;
+            size_t                  m_stamp;        // order of the prefetch requests
+        };
 
-        const Scene&        m_scene;
-        const Parameters    m_params;
-        size_t              m_memory_size;
-        size_t              m_peak_memory_size;
-        AssemblyMap         m_assemblies;
+        typedef std::map<foundation::UniqueID, const Assembly*> AssemblyMap;
+        typedef std::set<TileKey> TileKeySet;
+        typedef std::map<TileKey, PrefetchedTile> PrefetchedTileMap;
+
+        const Scene&            m_scene;
+        const Parameters        m_params;
+        OIIO::TextureSystem*    m_texture_system;
+        size_t                  m_memory_size;
+        size_t                  m_peak_memory_size;
+        AssemblyMap             m_assemblies;
+
+        // Background tile loading. Only the members below m_prefetch_mutex may be
+        // accessed from I/O threads, and only while holding that mutex.
+        std::auto_ptr<foundation::JobQueue>     m_prefetch_queue;
+        std::auto_ptr<foundation::JobManager>   m_prefetch_job_manager;
+        TileKeySet              m_resident_tiles;
+        mutable boost::mutex    m_prefetch_mutex;
+        PrefetchedTileMap       m_prefetched_tiles;
+        size_t                  m_prefetched_memory_size;
+        size_t                  m_prefetch_stamp;
+        foundation::uint64      m_prefetched_tile_count;
+        foundation::uint64      m_used_prefetched_tile_count;
 
         void gather_assemblies(const AssemblyContainer& assemblies);
+
+        Texture* get_texture(const TileKey& key);
+
+        // Return the amount of memory used by tiles loaded in the background but not used yet.
+        size_t get_prefetched_memory_size() const;
+
+        // Load a tile and convert it to the linear RGB color space. Thread-safe.
+        foundation::Tile* read_tile(
+            Texture&                texture,
+            const size_t            tile_x,
+            const size_t            tile_y,
+            bool&                   shared);
+
+        foundation::Tile* load_shared_tile(
+            const Texture&          texture,
+            const size_t            tile_x,
+            const size_t            tile_y);
+
+        void discard_tile(
+            Texture&                texture,
+            const TileKey&          key,
+            foundation::Tile*       tile,
+            const bool              shared);
+
+        // Retrieve a tile previously loaded in the background, if any.
+        bool take_prefetched_tile(const TileKey& key, TileRecord& record);
+
+        // Schedule the background loading of the tiles surrounding a given tile.
+        void prefetch_neighbors(const TileKey& key, Texture& texture);
+
+        // Evict the oldest prefetched tile that was never used.
+        bool evict_prefetched_tile();
+
+        // Called from I/O threads once a prefetched tile is loaded.
+        void on_tile_prefetched(
+            Texture&                texture,
+            const TileKey&          key,
+            foundation::Tile*       tile,
+            const bool              shared);
     };
 
     typedef foundation::LRUCache<
@@ -200,6 +322,16 @@ inline TextureStore::TileRecord& TextureStore::acquire(const TileKey& key)
     return record;
 }
 
+inline bool TextureStore::is_unified() const
+{
+    return m_tile_swapper.is_unified();
+}
+
+inline size_t TextureStore::get_memory_limit() const
+{
+    return m_tile_swapper.get_memory_limit();
+}
+
 inline void TextureStore::release(TileRecord& record) const
 {
     assert(foundation::atomic_read(&record.m_owners) > 0);
@@ -300,7 +432,7 @@ inline size_t TextureStore::TileKeyHasher::operator()(const TileKey& key) const
 
 inline bool TextureStore::TileSwapper::is_full(const size_t element_count) const
 {
-    return m_memory_size >= m_params.m_memory_limit;
+    return m_memory_size + get_prefetched_memory_size() >= m_params.m_memory_limit;
 }
 
 inline size_t TextureStore::TileSwapper::get_peak_memory_size() const
@@ -308,6 +440,26 @@ inline size_t TextureStore::TileSwapper::get_peak_memory_size() const
     return m_peak_memory_size;
 }
 
+inline bool TextureStore::TileSwapper::is_unified() const
+{
+    return m_texture_system != 0;
+}
+
+inline size_t TextureStore::TileSwapper::get_memory_limit() const
+{
+    return m_params.m_memory_limit;
+}
+
+inline foundation::uint64 TextureStore::TileSwapper::get_prefetched_tile_count() const
+{
+    return m_prefetched_tile_count;
+}
+
+inline foundation::uint64 TextureStore::TileSwapper::get_used_prefetched_tile_count() const
+{
+    return m_used_prefetched_tile_count;
+}
+
 }       // namespace renderer
 
 #endif  // !APPLESEED_RENDERER_KERNEL_TEXTURING_TEXTURESTORE_H
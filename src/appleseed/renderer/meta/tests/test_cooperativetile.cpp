@@ -0,0 +1,208 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/kernel/rendering/cooperativetile.h"
+
+// appleseed.foundation headers.
+#include "foundation/platform/thread.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+
+TEST_SUITE(Renderer_Kernel_Rendering_CooperativeTile)
+{
+    TEST_CASE(Join_FirstParticipant_IsFirst)
+    {
+        CooperativeTile tile(4);
+
+        bool first;
+        const bool joined = tile.join(first);
+
+        EXPECT_TRUE(joined);
+        EXPECT_TRUE(first);
+    }
+
+    TEST_CASE(Claim_SingleParticipant_ClaimsAllWorkItemsInChunks)
+    {
+        CooperativeTile tile(4);
+
+        bool first;
+        tile.join(first);
+        tile.start(0, 10);
+
+        size_t chunk_index, begin, end;
+
+        EXPECT_TRUE(tile.claim(chunk_index, begin, end));
+        EXPECT_EQ(0, chunk_index);
+        EXPECT_EQ(0, begin);
+        EXPECT_EQ(4, end);
+
+        EXPECT_TRUE(tile.claim(chunk_index, begin, end));
+        EXPECT_EQ(1, chunk_index);
+
+        EXPECT_TRUE(tile.claim(chunk_index, begin, end));
+        EXPECT_EQ(2, chunk_index);
+        EXPECT_EQ(8, begin);
+        EXPECT_EQ(10, end);
+
+        EXPECT_FALSE(tile.claim(chunk_index, begin, end));
+    }
+
+    TEST_CASE(Join_AllWorkItemsClaimed_ReturnsFalse)
+    {
+        CooperativeTile tile(4);
+
+        bool first;
+        tile.join(first);
+        tile.start(0, 4);
+
+        size_t chunk_index, begin, end;
+        tile.claim(chunk_index, begin, end);
+
+        const bool joined = tile.join(first);
+
+        EXPECT_FALSE(joined);
+    }
+
+    TEST_CASE(Join_AfterCancel_ReturnsFalse)
+    {
+        CooperativeTile tile(4);
+
+        bool first;
+        tile.join(first);
+        tile.start(0, 100);
+        tile.cancel();
+
+        const bool joined = tile.join(first);
+
+        EXPECT_FALSE(joined);
+    }
+
+    TEST_CASE(Leave_LastParticipant_ReturnsTrue)
+    {
+        CooperativeTile tile(4);
+
+        bool first;
+        tile.join(first);
+        tile.start(0, 100);
+        tile.join(first);
+
+        EXPECT_FALSE(tile.leave());
+        EXPECT_TRUE(tile.leave());
+    }
+
+    struct Participant
+    {
+        CooperativeTile&    m_tile;
+        vector<size_t>&     m_claims;
+        size_t&             m_finisher_count;
+
+        Participant(
+            CooperativeTile&    tile,
+            vector<size_t>&     claims,
+            size_t&             finisher_count)
+          : m_tile(tile)
+          , m_claims(claims)
+          , m_finisher_count(finisher_count)
+        {
+        }
+
+        void operator()()
+        {
+            bool first;
+            if (!m_tile.join(first))
+                return;
+
+            size_t chunk_index, begin, end;
+            while (m_tile.claim(chunk_index, begin, end))
+            {
+                for (size_t i = begin; i < end; ++i)
+                    ++m_claims[i];      // each work item is written by a single thread
+            }
+
+            if (m_tile.leave())
+            {
+                ++m_finisher_count;
+                m_tile.finish();
+            }
+            else m_tile.wait_until_finished();
+        }
+    };
+
+    TEST_CASE(Claim_MultipleParticipants_ClaimsEachWorkItemExactlyOnce)
+    {
+        const size_t WorkItemCount = 10000;
+        const size_t ThreadCount = 4;
+
+        CooperativeTile tile(7);
+        vector<size_t> claims(WorkItemCount, 0);
+        size_t finisher_count = 0;
+
+        bool first;
+        tile.join(first);
+        tile.start(0, WorkItemCount);
+
+        boost::thread_group threads;
+        for (size_t i = 0; i < ThreadCount; ++i)
+            threads.create_thread(Participant(tile, claims, finisher_count));
+
+        size_t chunk_index, begin, end;
+        while (tile.claim(chunk_index, begin, end))
+        {
+            for (size_t i = begin; i < end; ++i)
+                ++claims[i];
+        }
+
+        if (tile.leave())
+        {
+            ++finisher_count;
+            tile.finish();
+        }
+        else tile.wait_until_finished();
+
+        threads.join_all();
+
+        size_t errors = 0;
+        for (size_t i = 0; i < WorkItemCount; ++i)
+        {
+            if (claims[i] != 1)
+                ++errors;
+        }
+
+        EXPECT_EQ(0, errors);
+        EXPECT_EQ(1, finisher_count);
+    }
+}
@@ -0,0 +1,106 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/intersection/intersectionsettings.h"
+#include "renderer/modeling/object/curveobject.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Modeling_Object_CurveObject)
+{
+    struct Fixture
+    {
+        auto_release_ptr<CurveObject>   m_object;
+        GVector3                        m_points[7];
+        GScalar                         m_widths[7];
+
+        Fixture()
+          : m_object(CurveObjectFactory::create("curves", ParamArray()))
+        {
+            for (size_t i = 0; i < 7; ++i)
+            {
+                m_points[i] = GVector3(static_cast<GScalar>(i), 0.0f, 0.0f);
+                m_widths[i] = static_cast<GScalar>(i + 1) * 0.1f;
+            }
+        }
+    };
+
+    TEST_CASE_F(PushCurve3Strand_GivenTwoCurves_StoresOneStrandOfTwoCurves, Fixture)
+    {
+        const size_t first_curve = m_object->push_curve3_strand(m_points, m_widths, 7);
+
+        EXPECT_EQ(0, first_curve);
+        EXPECT_EQ(2, m_object->get_curve3_count());
+        ASSERT_EQ(1, m_object->get_curve3_strand_count());
+        EXPECT_EQ(7, m_object->get_curve3_strand_point_count(0));
+        EXPECT_EQ(GVector3(6.0f, 0.0f, 0.0f), m_object->get_curve3_strand_points(0)[6]);
+        EXPECT_FEQ(0.7f, m_object->get_curve3_strand_widths(0)[6]);
+    }
+
+    TEST_CASE_F(GetCurve3_GivenStrandOfTwoCurves_CurvesShareEndPoint, Fixture)
+    {
+        m_object->push_curve3_strand(m_points, m_widths, 7);
+
+        const Curve3Type curve0 = m_object->get_curve3(0);
+        const Curve3Type curve1 = m_object->get_curve3(1);
+
+        EXPECT_EQ(GVector3(0.0f, 0.0f, 0.0f), curve0.get_control_point(0));
+        EXPECT_EQ(GVector3(3.0f, 0.0f, 0.0f), curve0.get_control_point(3));
+        EXPECT_EQ(GVector3(3.0f, 0.0f, 0.0f), curve1.get_control_point(0));
+        EXPECT_EQ(GVector3(6.0f, 0.0f, 0.0f), curve1.get_control_point(3));
+        EXPECT_FEQ(0.4f, curve0.get_width(3));
+        EXPECT_FEQ(0.4f, curve1.get_width(0));
+    }
+
+    TEST_CASE_F(PushCurve3_AfterStrand_StoresSingleCurveStrand, Fixture)
+    {
+        m_object->push_curve3_strand(m_points, m_widths, 7);
+
+        const size_t index = m_object->push_curve3(Curve3Type(&m_points[3], &m_widths[3]));
+
+        EXPECT_EQ(2, index);
+        EXPECT_EQ(3, m_object->get_curve3_count());
+        ASSERT_EQ(2, m_object->get_curve3_strand_count());
+        EXPECT_EQ(4, m_object->get_curve3_strand_point_count(1));
+        EXPECT_EQ(GVector3(3.0f, 0.0f, 0.0f), m_object->get_curve3(2).get_control_point(0));
+        EXPECT_EQ(GVector3(6.0f, 0.0f, 0.0f), m_object->get_curve3(2).get_control_point(3));
+    }
+}
@@ -0,0 +1,124 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/intersection/intersectionsettings.h"
+#include "renderer/modeling/object/curveobject.h"
+#include "renderer/modeling/object/curveobjectreader.h"
+#include "renderer/modeling/object/curveobjectwriter.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/searchpaths.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Modeling_Object_CurveObjectWriter)
+{
+    auto_release_ptr<CurveObject> write_and_read_back(
+        const CurveObject&  object,
+        const char*         filepath)
+    {
+        const bool success = CurveObjectWriter::write(object, filepath);
+
+        if (!success)
+            return auto_release_ptr<CurveObject>();
+
+        return
+            CurveObjectReader::read(
+                SearchPaths(),
+                "curves",
+                ParamArray().insert("filepath", filepath));
+    }
+
+    TEST_CASE(WriteBinaryCurves_GivenEmptyObject_ReadsBackEmptyObject)
+    {
+        auto_release_ptr<CurveObject> object(CurveObjectFactory::create("curves", ParamArray()));
+
+        auto_release_ptr<CurveObject> result =
+            write_and_read_back(
+                object.ref(),
+                "unit tests/outputs/test_curveobjectwriter_empty.binarycurves");
+
+        ASSERT_NEQ(0, result.get());
+        EXPECT_EQ(0, result->get_curve1_count());
+        EXPECT_EQ(0, result->get_curve3_count());
+        EXPECT_EQ(0, result->get_curve3_strand_count());
+    }
+
+    TEST_CASE(WriteBinaryCurves_GivenCurvesAndStrands_ReadsBackSameCurvesAndStrands)
+    {
+        auto_release_ptr<CurveObject> object(CurveObjectFactory::create("curves", ParamArray()));
+
+        const GVector3 curve1_points[2] = { GVector3(0.0f, 0.0f, 0.0f), GVector3(0.0f, 1.0f, 0.0f) };
+        const GScalar curve1_widths[2] = { 0.5f, 0.25f };
+        object->push_curve1(Curve1Type(curve1_points, curve1_widths));
+
+        GVector3 strand_points[7];
+        GScalar strand_widths[7];
+        for (size_t i = 0; i < 7; ++i)
+        {
+            strand_points[i] = GVector3(static_cast<GScalar>(i), 0.5f, -1.0f);
+            strand_widths[i] = static_cast<GScalar>(7 - i) * 0.01f;
+        }
+        object->push_curve3_strand(strand_points, strand_widths, 7);
+        object->push_curve3(Curve3Type(&strand_points[2], 0.05f));
+
+        auto_release_ptr<CurveObject> result =
+            write_and_read_back(
+                object.ref(),
+                "unit tests/outputs/test_curveobjectwriter_curves.binarycurves");
+
+        ASSERT_NEQ(0, result.get());
+
+        ASSERT_EQ(1, result->get_curve1_count());
+        for (size_t i = 0; i < 2; ++i)
+        {
+            EXPECT_EQ(curve1_points[i], result->get_curve1(0).get_control_point(i));
+            EXPECT_EQ(curve1_widths[i], result->get_curve1(0).get_width(i));
+        }
+
+        EXPECT_EQ(3, result->get_curve3_count());
+        ASSERT_EQ(2, result->get_curve3_strand_count());
+        ASSERT_EQ(7, result->get_curve3_strand_point_count(0));
+        ASSERT_EQ(4, result->get_curve3_strand_point_count(1));
+        EXPECT_SEQUENCE_EQ(7, strand_points, result->get_curve3_strand_points(0));
+        EXPECT_SEQUENCE_EQ(7, strand_widths, result->get_curve3_strand_widths(0));
+        EXPECT_SEQUENCE_EQ(4, &strand_points[2], result->get_curve3_strand_points(1));
+        EXPECT_EQ(0.05f, result->get_curve3_strand_widths(1)[3]);
+    }
+}
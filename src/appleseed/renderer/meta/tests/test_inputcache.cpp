@@ -0,0 +1,212 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/lighting/pathvertex.h"
+#include "renderer/kernel/lighting/scatteringmode.h"
+#include "renderer/kernel/texturing/texturecache.h"
+#include "renderer/kernel/texturing/texturestore.h"
+#include "renderer/modeling/input/inputarray.h"
+#include "renderer/modeling/input/inputcache.h"
+#include "renderer/modeling/input/inputevaluator.h"
+#include "renderer/modeling/input/source.h"
+#include "renderer/modeling/scene/scene.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/vector.h"
+#include "foundation/platform/compiler.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/test.h"
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Modeling_Input_InputCache)
+{
+    // A varying source whose value is the u texture coordinate.
+    class USource
+      : public Source
+    {
+      public:
+        USource()
+          : Source(false)
+        {
+        }
+
+        virtual uint64 compute_signature() const APPLESEED_OVERRIDE
+        {
+            return 0;
+        }
+
+        virtual void evaluate(
+            TextureCache&           texture_cache,
+            const Vector2f&         uv,
+            float&                  scalar) const APPLESEED_OVERRIDE
+        {
+            scalar = uv[0];
+        }
+    };
+
+    struct Fixture
+    {
+        auto_release_ptr<Scene>     m_scene;
+        TextureStore                m_texture_store;
+        TextureCache                m_texture_cache;
+        InputArray                  m_inputs;
+        InputCache                  m_input_cache;
+
+        Fixture()
+          : m_scene(SceneFactory::create())
+          , m_texture_store(m_scene.ref())
+          , m_texture_cache(m_texture_store)
+          , m_input_cache(4)    // cells of 0.25 x 0.25 in texture space
+        {
+            m_inputs.declare("u", InputFormatFloat);
+            m_inputs.find("u").bind(new USource());
+        }
+
+        float evaluate(const InputArray& inputs, const float u, const float v)
+        {
+            APPLESEED_SIMD4_ALIGN uint8 values[InputCache::MaxDataSize * 2];
+            m_input_cache.evaluate(inputs, m_texture_cache, Vector2f(u, v), values);
+            return *reinterpret_cast<const float*>(values);
+        }
+
+        float evaluate(const float u, const float v)
+        {
+            return evaluate(m_inputs, u, v);
+        }
+    };
+
+    TEST_CASE_F(Evaluate_GivenTexCoordsInSameCell_ReturnsValuesOfFirstLookupInCell, Fixture)
+    {
+        evaluate(0.1f, 0.1f);
+
+        EXPECT_EQ(0.1f, evaluate(0.2f, 0.2f));
+    }
+
+    TEST_CASE_F(Evaluate_GivenTexCoordsInDifferentCellAlongU_EvaluatesInputs, Fixture)
+    {
+        evaluate(0.1f, 0.1f);
+
+        EXPECT_EQ(0.3f, evaluate(0.3f, 0.1f));
+    }
+
+    TEST_CASE_F(Evaluate_GivenTexCoordsInDifferentCellAlongV_EvaluatesInputs, Fixture)
+    {
+        evaluate(0.1f, 0.1f);
+
+        EXPECT_EQ(0.2f, evaluate(0.2f, 0.3f));
+    }
+
+    TEST_CASE_F(Evaluate_GivenOtherInputArrayInSameCell_EvaluatesOtherInputArray, Fixture)
+    {
+        InputArray other_inputs;
+        other_inputs.declare("u", InputFormatFloat);
+        other_inputs.find("u").bind(new USource());
+
+        evaluate(0.1f, 0.1f);
+
+        EXPECT_EQ(0.2f, evaluate(other_inputs, 0.2f, 0.2f));
+    }
+
+    TEST_CASE_F(Evaluate_GivenInputsLargerThanMaxDataSize_AlwaysEvaluatesInputs, Fixture)
+    {
+        // Spectral inputs are large enough for the input values not to fit in a cache line.
+        m_inputs.declare("r0", InputFormatSpectralReflectance);
+        m_inputs.declare("r1", InputFormatSpectralReflectance);
+        m_inputs.declare("r2", InputFormatSpectralReflectance);
+        EXPECT_GT(static_cast<size_t>(InputCache::MaxDataSize), m_inputs.compute_data_size());
+
+        evaluate(0.1f, 0.1f);
+
+        EXPECT_EQ(0.2f, evaluate(0.2f, 0.2f));
+    }
+
+    // Evaluates inputs at path vertices the way the path tracer does.
+    struct PathTracerFixture
+      : public Fixture
+    {
+        SamplingContext::RNGType    m_rng;
+        SamplingContext             m_sampling_context;
+        PathVertex                  m_vertex;
+
+        PathTracerFixture()
+          : m_sampling_context(m_rng, SamplingContext::QMCMode)
+          , m_vertex(m_sampling_context)
+        {
+        }
+
+        float evaluate_at_vertex(
+            const size_t                path_length,
+            const ScatteringMode::Mode  prev_mode,
+            const float                 u,
+            const float                 v)
+        {
+            m_vertex.m_path_length = path_length;
+            m_vertex.m_prev_mode = prev_mode;
+
+            InputEvaluator input_evaluator(
+                m_texture_cache,
+                m_vertex.may_approximate_inputs() ? &m_input_cache : 0);
+
+            return *input_evaluator.evaluate<float>(m_inputs, Vector2f(u, v));
+        }
+    };
+
+    TEST_CASE_F(PathTracer_GivenVerticesReachedThroughDiffuseBounces_ReusesValuesOfFirstVertexInCell, PathTracerFixture)
+    {
+        evaluate_at_vertex(2, ScatteringMode::Diffuse, 0.1f, 0.1f);
+
+        EXPECT_EQ(0.1f, evaluate_at_vertex(3, ScatteringMode::Diffuse, 0.2f, 0.2f));
+    }
+
+    TEST_CASE_F(PathTracer_GivenVertexReachedThroughGlossyBounce_ReusesValuesOfPreviousVertexInCell, PathTracerFixture)
+    {
+        evaluate_at_vertex(2, ScatteringMode::Diffuse, 0.1f, 0.1f);
+
+        EXPECT_EQ(0.1f, evaluate_at_vertex(2, ScatteringMode::Glossy, 0.2f, 0.2f));
+    }
+
+    TEST_CASE_F(PathTracer_GivenCameraVertex_EvaluatesInputsExactly, PathTracerFixture)
+    {
+        evaluate_at_vertex(2, ScatteringMode::Diffuse, 0.1f, 0.1f);
+
+        EXPECT_EQ(0.2f, evaluate_at_vertex(1, ScatteringMode::Specular, 0.2f, 0.2f));
+    }
+
+    TEST_CASE_F(PathTracer_GivenVertexReachedThroughSpecularBounce_EvaluatesInputsExactly, PathTracerFixture)
+    {
+        evaluate_at_vertex(2, ScatteringMode::Diffuse, 0.1f, 0.1f);
+
+        EXPECT_EQ(0.2f, evaluate_at_vertex(3, ScatteringMode::Specular, 0.2f, 0.2f));
+    }
+}
@@ -0,0 +1,127 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/kernel/rendering/shadingresultframebuffer.h"
+#include "renderer/kernel/shading/shadingresult.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/color.h"
+#include "foundation/math/filter.h"
+#include "foundation/platform/thread.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Kernel_Rendering_ShadingResultFrameBuffer)
+{
+    const size_t TileSize = 4;
+    const size_t SamplesPerPixel = 1000;
+
+    struct SampleAdder
+    {
+        ShadingResultFrameBuffer&   m_framebuffer;
+        const float                 m_value;
+
+        SampleAdder(
+            ShadingResultFrameBuffer&   framebuffer,
+            const float                 value)
+          : m_framebuffer(framebuffer)
+          , m_value(value)
+        {
+        }
+
+        void operator()()
+        {
+            ShadingResult result(1);
+            result.set_main_to_linear_rgba(Color4f(m_value, 2.0f * m_value, 3.0f * m_value, 1.0f));
+            result.m_aovs[0] = result.m_main;
+            result.m_aovs[0] *= 10.0f;
+
+            for (size_t i = 0; i < SamplesPerPixel; ++i)
+            {
+                for (size_t y = 0; y < TileSize; ++y)
+                {
+                    for (size_t x = 0; x < TileSize; ++x)
+                    {
+                        // Sample at the center of the pixel: the box filter only
+                        // gives weight to this pixel.
+                        m_framebuffer.add(x + 0.5f, y + 0.5f, result);
+                    }
+                }
+            }
+        }
+    };
+
+    TEST_CASE(Add_FromMultipleThreads_AccumulatesEverySample)
+    {
+        const size_t ThreadCount = 4;
+
+        const BoxFilter2<float> filter(0.5f, 0.5f);
+        ShadingResultFrameBuffer framebuffer(TileSize, TileSize, 1, filter);
+        framebuffer.clear();
+
+        boost::thread_group threads;
+        for (size_t i = 0; i < ThreadCount; ++i)
+            threads.create_thread(SampleAdder(framebuffer, static_cast<float>(i + 1)));
+        threads.join_all();
+
+        // Sum of the values added by all threads to each pixel; all sums are exact in single precision.
+        const float ExpectedWeight = static_cast<float>(ThreadCount * SamplesPerPixel);
+        const float ExpectedRed = static_cast<float>(ThreadCount * (ThreadCount + 1) / 2 * SamplesPerPixel);
+
+        size_t errors = 0;
+
+        for (size_t y = 0; y < TileSize; ++y)
+        {
+            for (size_t x = 0; x < TileSize; ++x)
+            {
+                // Weight, then main RGBA, then AOV RGBA.
+                const float* ptr = framebuffer.pixel(x, y);
+
+                if (ptr[0] != ExpectedWeight ||
+                    ptr[1] != ExpectedRed ||
+                    ptr[2] != 2.0f * ExpectedRed ||
+                    ptr[3] != 3.0f * ExpectedRed ||
+                    ptr[4] != ExpectedWeight ||
+                    ptr[5] != 10.0f * ExpectedRed ||
+                    ptr[6] != 20.0f * ExpectedRed ||
+                    ptr[7] != 30.0f * ExpectedRed ||
+                    ptr[8] != 10.0f * ExpectedWeight)
+                    ++errors;
+            }
+        }
+
+        EXPECT_EQ(0, errors);
+    }
+}
@@ -0,0 +1,119 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/modeling/environmentedf/skytable.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/qmc.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cmath>
+#include <cstddef>
+
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+
+TEST_SUITE(Renderer_Modeling_EnvironmentEDF_SkyTable)
+{
+    // A sky that is brighter toward the zenith.
+    struct SkyModel
+    {
+        void compute_radiance(const Vector3f& local_outgoing, Spectrum& value) const
+        {
+            value.set(1.0f + 4.0f * square(local_outgoing.y));
+        }
+    };
+
+    TEST_CASE(EvaluatePDF_IntegratedOverSphere_ReturnsOne)
+    {
+        SkyTable table(64, 32);
+        ASSERT_TRUE(table.bake(SkyModel(), 0.0f));
+
+        // Midpoint quadrature in spherical coordinates, on a grid finer than the table.
+        const size_t ThetaCount = 256;
+        const size_t PhiCount = 512;
+        const float dtheta = Pi<float>() / ThetaCount;
+        const float dphi = TwoPi<float>() / PhiCount;
+
+        double integral = 0.0;
+
+        for (size_t i = 0; i < ThetaCount; ++i)
+        {
+            const float theta = (i + 0.5f) * dtheta;
+            const float sin_theta = sin(theta);
+            const float cos_theta = cos(theta);
+
+            for (size_t j = 0; j < PhiCount; ++j)
+            {
+                const float phi = -Pi<float>() + (j + 0.5f) * dphi;
+                const Vector3f d = Vector3f::make_unit_vector(cos_theta, sin_theta, cos(phi), sin(phi));
+                integral += table.evaluate_pdf(d) * sin_theta * dtheta * dphi;
+            }
+        }
+
+        EXPECT_FEQ_EPS(1.0, integral, 1.0e-3);
+    }
+
+    TEST_CASE(Sample_ReturnsDirectionsAboveHorizonWithMatchingProbabilityDensity)
+    {
+        SkyTable table(64, 32);
+        ASSERT_TRUE(table.bake(SkyModel(), 0.0f));
+
+        const size_t SampleCount = 1000;
+
+        size_t below_horizon_count = 0;
+        size_t mismatch_count = 0;
+
+        for (size_t i = 0; i < SampleCount; ++i)
+        {
+            static const size_t Bases[] = { 2 };
+            const Vector2f s = hammersley_sequence<float, 2>(Bases, SampleCount, i);
+
+            Vector3f d;
+            float probability;
+            table.sample(s, d, probability);
+
+            // Texels entirely below the horizon must never be sampled.
+            if (d.y < 0.0f)
+                ++below_horizon_count;
+
+            if (!feq(probability, table.evaluate_pdf(d), 1.0e-3f))
+                ++mismatch_count;
+        }
+
+        EXPECT_EQ(0, below_horizon_count);
+        EXPECT_EQ(0, mismatch_count);
+    }
+}
@@ -0,0 +1,85 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/tessellation/statictessellation.h"
+#include "renderer/modeling/object/triangle.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/test.h"
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Kernel_Tessellation_StaticTessellation)
+{
+    struct Fixture
+    {
+        StaticTessellation<Triangle>    m_tess;
+
+        Fixture()
+        {
+            m_tess.push_tex_coords(GVector2(0.25f, 0.75f));
+            m_tess.push_vertex_tangent(GVector3(1.0f, 0.0f, 0.0f));
+            m_tess.push_vertex_tangent(GVector3(0.0f, 0.0f, 1.0f));
+        }
+    };
+
+    TEST_CASE_F(ClearTexCoords_KeepsVertexTangents, Fixture)
+    {
+        m_tess.clear_tex_coords();
+
+        EXPECT_EQ(0, m_tess.get_tex_coords_count());
+        ASSERT_EQ(2, m_tess.get_vertex_tangent_count());
+        EXPECT_EQ(GVector3(1.0f, 0.0f, 0.0f), m_tess.get_vertex_tangent(0));
+        EXPECT_EQ(GVector3(0.0f, 0.0f, 1.0f), m_tess.get_vertex_tangent(1));
+    }
+
+    TEST_CASE_F(ClearVertexTangents_KeepsTexCoords, Fixture)
+    {
+        m_tess.clear_vertex_tangents();
+
+        EXPECT_EQ(0, m_tess.get_vertex_tangent_count());
+        ASSERT_EQ(1, m_tess.get_tex_coords_count());
+        EXPECT_EQ(GVector2(0.25f, 0.75f), m_tess.get_tex_coords(0));
+    }
+
+    TEST_CASE_F(PushTexCoords_AfterClearTexCoords_KeepsVertexTangents, Fixture)
+    {
+        m_tess.clear_tex_coords();
+        m_tess.push_tex_coords(GVector2(0.5f, 0.5f));
+
+        ASSERT_EQ(1, m_tess.get_tex_coords_count());
+        EXPECT_EQ(GVector2(0.5f, 0.5f), m_tess.get_tex_coords(0));
+        ASSERT_EQ(2, m_tess.get_vertex_tangent_count());
+        EXPECT_EQ(GVector3(0.0f, 0.0f, 1.0f), m_tess.get_vertex_tangent(1));
+    }
+}
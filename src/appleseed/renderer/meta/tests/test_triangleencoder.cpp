@@ -0,0 +1,154 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/intersection/intersectionsettings.h"
+#include "renderer/kernel/intersection/triangleencoder.h"
+#include "renderer/kernel/intersection/trianglevertexinfo.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/aabb.h"
+#include "foundation/math/bvh.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/memory.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+
+TEST_SUITE(Renderer_Kernel_Intersection_TriangleEncoder)
+{
+    // One full group of triangles followed by a partially filled one.
+    const size_t TriangleCount = GTriangleGroupType::Size + 2;
+
+    struct Fixture
+    {
+        vector<TriangleVertexInfo>  m_vertex_infos;
+        vector<GVector3>            m_vertices;
+        vector<size_t>              m_indices;
+        vector<GAABB3>              m_bboxes;
+
+        Fixture()
+        {
+            // Static triangles side by side along the X axis.
+            for (size_t i = 0; i < TriangleCount; ++i)
+            {
+                const GScalar x = static_cast<GScalar>(i);
+
+                m_vertex_infos.push_back(TriangleVertexInfo(m_vertices.size(), 0, ~uint32(0)));
+                m_vertices.push_back(GVector3(x, 0.0f, 0.0f));
+                m_vertices.push_back(GVector3(x + 1.0f, 0.0f, 0.0f));
+                m_vertices.push_back(GVector3(x, 1.0f, 0.0f));
+                m_indices.push_back(i);
+
+                GAABB3 bbox;
+                bbox.invalidate();
+                bbox.insert(GVector3(x, 0.0f, 0.0f));
+                bbox.insert(GVector3(x + 1.0f, 1.0f, 0.0f));
+                m_bboxes.push_back(bbox);
+            }
+        }
+    };
+
+    TEST_CASE_F(SAHPartitioner_GivenMaxLeafSizeOfOneGroup_BuildsGroupedLeaf, Fixture)
+    {
+        const size_t LeafSize = GTriangleGroupType::Size;
+
+        ASSERT_TRUE(TriangleTreeMinGroupedLeafSize <= LeafSize);
+
+        bvh::SAHPartitioner<vector<GAABB3> > partitioner(
+            m_bboxes,
+            LeafSize,
+            TriangleTreeDefaultInteriorNodeTraversalCost,
+            TriangleTreeDefaultTriangleIntersectionCost);
+
+        GAABB3 bbox;
+        bbox.invalidate();
+        for (size_t i = 0; i < LeafSize; ++i)
+            bbox.insert(m_bboxes[i]);
+
+        EXPECT_EQ(LeafSize, partitioner.partition(0, LeafSize, bbox));
+        EXPECT_TRUE(TriangleEncoder::is_grouped_leaf(m_vertex_infos, m_indices, 0, LeafSize));
+    }
+
+    TEST_CASE_F(IsGroupedLeaf_GivenTooFewTriangles_ReturnsFalse, Fixture)
+    {
+        EXPECT_FALSE(
+            TriangleEncoder::is_grouped_leaf(
+                m_vertex_infos,
+                m_indices,
+                0,
+                TriangleTreeMinGroupedLeafSize - 1));
+    }
+
+    TEST_CASE_F(IsGroupedLeaf_GivenMovingTriangle_ReturnsFalse, Fixture)
+    {
+        m_vertex_infos[1].m_motion_segment_count = 1;
+
+        EXPECT_FALSE(TriangleEncoder::is_grouped_leaf(m_vertex_infos, m_indices, 0, m_indices.size()));
+    }
+
+    TEST_CASE_F(Encode_GivenGroupedLeaf_WritesMarkerAndGroups, Fixture)
+    {
+        const size_t size =
+            TriangleEncoder::compute_size(m_vertex_infos, m_indices, 0, m_indices.size());
+
+        vector<uint8> buffer(size + 16, 0xFF);
+        MemoryWriter writer(&buffer[0]);
+        TriangleEncoder::encode(m_vertex_infos, m_vertices, m_indices, 0, m_indices.size(), writer);
+
+        ASSERT_EQ(size, writer.offset());
+
+        uint32 marker;
+        memcpy(&marker, &buffer[sizeof(uint32)], sizeof(uint32));
+        EXPECT_EQ(static_cast<uint32>(TriangleEncoder::GroupedLeafMarker), marker);
+
+        // Each group is made of the visibility flags of its triangles followed by the triangles.
+        const size_t GroupSize = GTriangleGroupType::Size;
+        const size_t EncodedGroupSize = GroupSize * sizeof(uint32) + sizeof(GTriangleGroupType);
+        ASSERT_EQ(2 * sizeof(uint32) + 2 * EncodedGroupSize, size);
+
+        // Slots of the last group past the end of the leaf are invisible.
+        for (size_t g = 0; g < 2; ++g)
+        {
+            uint32 vis_flags[GroupSize];
+            memcpy(vis_flags, &buffer[2 * sizeof(uint32) + g * EncodedGroupSize], sizeof(vis_flags));
+
+            for (size_t i = 0; i < GroupSize; ++i)
+                EXPECT_EQ(g * GroupSize + i < m_indices.size() ? ~uint32(0) : 0, vis_flags[i]);
+        }
+    }
+}
@@ -43,7 +43,7 @@
 #include "foundation/math/basis.h"
 #include "foundation/math/fresnel.h"
 #include "foundation/math/microfacet.h"
-#include "foundation/math/qmc.h"
+#include "foundation/math/microfacetalbedo.h"
 #include "foundation/math/sampling/mappings.h"
 #include "foundation/math/scalar.h"
 #include "foundation/math/vector.h"
@@ -180,12 +180,14 @@ namespace
                 static_cast<const InputValues*>(input_evaluator.evaluate(m_inputs));
 
             // Construct the Microfacet Distribution Function.
-            m_mdf.reset(new MDFType(max(values->m_roughness, 1.0e-6f)));
+            const float roughness = max(values->m_roughness, 1.0e-6f);
+            m_mdf.reset(new MDFType(roughness));
 
-            // Precompute the specular albedo curve.
+            // Precompute the specular albedo curve. The underlying albedo table
+            // is shared by all BRDFs with the same roughness.
             Spectrum rs(values->m_rs);
             rs *= values->m_rs_multiplier;
-            compute_specular_albedo(*m_mdf.get(), rs, m_a_spec);
+            compute_specular_albedo(get_albedo_table(*m_mdf.get(), roughness), rs, m_a_spec);
 
             // Precompute the average specular albedo.
             Spectrum a_spec_avg;
@@ -516,79 +518,30 @@ namespace
             fr_spec *= mdf.evaluate(dot_HN) / (4.0f * dot_HL * dot_HL);
         }
 
-        // Compute the specular albedo function.
+        // Return the table of specular albedos of a given MDF, computing it if needed.
         template <typename MDF>
-        static void compute_specular_albedo(
+        static const MicrofacetAlbedoTableCache::TableType& get_albedo_table(
             const MDF&          mdf,
-            const Spectrum&     rs,
-            Spectrum            albedo[])
+            const float         roughness)
         {
-            for (size_t i = 0; i < AlbedoTableSize; ++i)
-            {
-                // Compute an outgoing direction V in the XY plane.
-                const float cos_theta = static_cast<float>(i) / (AlbedoTableSize - 1);
-                const float sin_theta = sqrt(1.0f - cos_theta * cos_theta);
-                const Vector3f V(sin_theta, cos_theta, 0.0f);
-
-                // Compute the albedo for this outgoing direction.
-                compute_specular_albedo(mdf, rs, V, albedo[i]);
-            }
+            return
+                MicrofacetAlbedoTableCache::get(
+                    mdf,
+                    roughness,
+                    AlbedoTableSize,
+                    AlbedoSampleCount);
         }
 
-        // Compute the albedo of the specular component for a given outgoing direction.
-        // See Physically Based Rendering, first edition, pp. 689-690.
-        template <typename MDF>
+        // Compute the specular albedo function.
         static void compute_specular_albedo(
-            const MDF&          mdf,
-            const Spectrum&     rs,
-            const Vector3f&     V,
-            Spectrum&           albedo)
+            const MicrofacetAlbedoTableCache::TableType&    albedo_table,
+            const Spectrum&                                 rs,
+            Spectrum                                        albedo[])
         {
-            // V must lie above or in the surface.
-            assert(V.y >= 0.0f);
-
-            albedo.set(0.0f);
-
-            for (size_t i = 0; i < AlbedoSampleCount; ++i)
-            {
-                // Generate a uniform sample in [0,1)^2.
-                static const size_t Bases[] = { 2 };
-                const Vector2f s = hammersley_sequence<float, 2>(Bases, AlbedoSampleCount, i);
+            assert(albedo_table.size() == AlbedoTableSize);
 
-                // Sample the microfacet distribution to get an halfway vector H.
-                const Vector3f H = mdf.sample(s);
-                const float dot_HV = dot(H, V);
-                if (dot_HV <= 0.0f)
-                    continue;
-
-                // L is the reflection of V around H.
-                const Vector3f L = (dot_HV + dot_HV) * H - V;
-
-                // Reject L if it lies in or below the surface.
-                if (L.y <= 0.0f)
-                    continue;
-
-                // Evaluate the PDF of L.
-                const float dot_HN = H.y;
-                const float pdf_H = mdf.evaluate_pdf(dot_HN);
-                const float pdf_L = pdf_H / (4.0f * dot_HV);
-                assert(pdf_L >= 0.0f);
-                if (pdf_L == 0.0f)
-                    continue;
-
-                // Sanity checks.
-                assert(is_normalized(V));
-                assert(is_normalized(H));
-                assert(is_normalized(L));
-
-                // Evaluate the specular component for this (L, V) pair.
-                Spectrum fr_spec;
-                fresnel_reflectance_dielectric_schlick(fr_spec, rs, dot_HV);
-                fr_spec *= (L.y * mdf.evaluate(dot_HN)) / (4.0f * pdf_L * dot_HV * dot_HV);
-                albedo += fr_spec;
-            }
-
-            albedo /= static_cast<float>(AlbedoSampleCount);
+            for (size_t i = 0; i < AlbedoTableSize; ++i)
+                albedo_table.get_albedo(i, rs, albedo[i]);
         }
 
         // Compute the average specular albedo.
@@ -668,7 +621,7 @@ namespace
             const Spectrum&     rs)
         {
             Spectrum a_spec[AlbedoTableSize];
-            compute_specular_albedo(mdf, rs, a_spec);
+            compute_specular_albedo(get_albedo_table(mdf, m), rs, a_spec);
 
             vector<Vector2f> tabulated_albedos(AlbedoTableSize);
 
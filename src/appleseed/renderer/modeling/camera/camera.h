@@ -112,7 +112,8 @@ class APPLESEED_DLLSYMBOL Camera
     // Generate a ray directed toward a given point on the film plane,
     // expressed in normalized device coordinates
     // (https://github.com/appleseedhq/appleseed/wiki/Terminology).
-    // The generated ray is expressed in world space.
+    // The generated ray is expressed in world space. Rays are generated one at a time
+    // since each ray draws its time and lens position from its own sampling context.
     virtual void spawn_ray(
         SamplingContext&                sampling_context,
         const foundation::Dual2d&       ndc,
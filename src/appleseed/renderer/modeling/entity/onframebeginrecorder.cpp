@@ -32,10 +32,23 @@
 // appleseed.renderer headers.
 #include "renderer/modeling/entity/entity.h"
 
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/platform/compiler.h"
+#include "foundation/platform/thread.h"
+#include "foundation/platform/timers.h"
+#include "foundation/utility/api/apistring.h"
+#include "foundation/utility/foreach.h"
+#include "foundation/utility/job.h"
+#include "foundation/utility/stopwatch.h"
+
 // Standard headers.
+#include <algorithm>
 #include <cassert>
 #include <stack>
+#include <string>
 
+using namespace foundation;
 using namespace std;
 
 namespace renderer
@@ -49,12 +62,95 @@ struct OnFrameBeginRecorder::Impl
         const BaseGroup*    m_parent;
     };
 
-    stack<Record> m_records;
+    struct Timing
+    {
+        string              m_path;
+        double              m_seconds;
+
+        bool operator<(const Timing& rhs) const
+        {
+            return m_seconds > rhs.m_seconds;
+        }
+    };
+
+    JobQueue*               m_job_queue;
+    boost::mutex            m_mutex;
+    stack<Record>           m_records;
+    vector<Timing>          m_timings;
+
+    bool invoke_on_frame_begin(
+        OnFrameBeginRecorder&   recorder,
+        const Project&          project,
+        const BaseGroup*        parent,
+        Entity&                 entity,
+        IAbortSwitch*           abort_switch)
+    {
+        Stopwatch<DefaultWallclockTimer> stopwatch;
+        stopwatch.start();
+
+        const bool success = entity.on_frame_begin(project, parent, recorder, abort_switch);
+
+        Timing timing;
+        timing.m_path = entity.get_path().c_str();
+        timing.m_seconds = stopwatch.measure().get_seconds();
+
+        boost::mutex::scoped_lock lock(m_mutex);
+        m_timings.push_back(timing);
+
+        return success;
+    }
+
+    class OnFrameBeginJob
+      : public IJob
+    {
+      public:
+        OnFrameBeginJob(
+            Impl&                       impl,
+            OnFrameBeginRecorder&       recorder,
+            const Project&              project,
+            const BaseGroup*            parent,
+            Entity&                     entity,
+            IAbortSwitch*               abort_switch,
+            unsigned char&              success)
+          : m_impl(impl)
+          , m_recorder(recorder)
+          , m_project(project)
+          , m_parent(parent)
+          , m_entity(entity)
+          , m_abort_switch(abort_switch)
+          , m_success(success)
+        {
+        }
+
+        virtual void execute(const size_t thread_index) APPLESEED_OVERRIDE
+        {
+            if (is_aborted(m_abort_switch))
+                return;
+
+            m_success =
+                m_impl.invoke_on_frame_begin(
+                    m_recorder,
+                    m_project,
+                    m_parent,
+                    m_entity,
+                    m_abort_switch) ? 1 : 0;
+        }
+
+      private:
+        Impl&                       m_impl;
+        OnFrameBeginRecorder&       m_recorder;
+        const Project&              m_project;
+        const BaseGroup*            m_parent;
+        Entity&                     m_entity;
+        IAbortSwitch*               m_abort_switch;
+        unsigned char&              m_success;
+    };
 };
 
-OnFrameBeginRecorder::OnFrameBeginRecorder()
+OnFrameBeginRecorder::OnFrameBeginRecorder(JobQueue* job_queue)
   : impl(new Impl())
 {
+    impl->m_job_queue = job_queue;
 }
 
 OnFrameBeginRecorder::~OnFrameBeginRecorder()
@@ -68,9 +164,56 @@ void OnFrameBeginRecorder::record(Entity* entity, const BaseGroup* parent)
     Impl::Record record;
     record.m_entity = entity;
     record.m_parent = parent;
+
+    boost::mutex::scoped_lock lock(impl->m_mutex);
     impl->m_records.push(record);
 }
 
+bool OnFrameBeginRecorder::invoke_on_frame_begin(
+    const Project&          project,
+    const BaseGroup*        parent,
+    const EntityVector&     entities,
+    IAbortSwitch*           abort_switch)
+{
+    // Prepare the entities one by one if there is nothing to gain from a parallel preparation.
+    if (impl->m_job_queue == 0 || entities.size() < 2)
+    {
+        bool success = true;
+
+        for (const_each<EntityVector> i = entities; i; ++i)
+        {
+            if (is_aborted(abort_switch))
+                break;
+
+            success = success && impl->invoke_on_frame_begin(*this, project, parent, **i, abort_switch);
+        }
+
+        return success;
+    }
+
+    // Schedule one job per entity. Entities are considered as failed until their job completes.
+    vector<unsigned char> success(entities.size(), 0);
+    for (size_t i = 0; i < entities.size(); ++i)
+    {
+        impl->m_job_queue->schedule(
+            new Impl::OnFrameBeginJob(
+                *impl,
+                *this,
+                project,
+                parent,
+                *entities[i],
+                abort_switch,
+                success[i]));
+    }
+
+    // Wait until all entities are prepared.
+    impl->m_job_queue->wait_until_completion();
+
+    return
+        !is_aborted(abort_switch) &&
+        find(success.begin(), success.end(), 0) == success.end();
+}
+
 void OnFrameBeginRecorder::on_frame_end(const Project& project)
 {
     while (!impl->m_records.empty())
@@ -79,6 +222,31 @@ void OnFrameBeginRecorder::on_frame_end(const Project& project)
         record.m_entity->on_frame_end(project, record.m_parent);
         impl->m_records.pop();
     }
+
+    impl->m_timings.clear();
+}
+
+StatisticsVector OnFrameBeginRecorder::get_statistics(const size_t max_entity_count) const
+{
+    vector<Impl::Timing> timings = impl->m_timings;
+    sort(timings.begin(), timings.end());
+
+    double total_seconds = 0.0;
+    for (const_each<vector<Impl::Timing> > i = timings; i; ++i)
+        total_seconds += i->m_seconds;
+
+    Statistics totals;
+    totals.insert("entities", timings.size());
+    totals.insert_time("total time", total_seconds);
+
+    Statistics slowest;
+    for (size_t i = 0, e = min(timings.size(), max_entity_count); i < e; ++i)
+        slowest.insert_time(timings[i].m_path, timings[i].m_seconds);
+
+    StatisticsVector stats;
+    stats.insert("scene preparation statistics", totals);
+    stats.insert("slowest entities to prepare", slowest);
+    return stats;
 }
 
 }   // namespace renderer
@@ -29,13 +29,22 @@
 #ifndef APPLESEED_RENDERER_MODELING_ENTITY_ONFRAMEBEGINRECORDER_H
 #define APPLESEED_RENDERER_MODELING_ENTITY_ONFRAMEBEGINRECORDER_H
 
+// appleseed.foundation headers.
+#include "foundation/utility/statistics.h"
+
 // appleseed.main headers.
 #include "main/dllsymbol.h"
 
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
 // Forward declarations.
-namespace renderer  { class BaseGroup; }
-namespace renderer  { class Entity; }
-namespace renderer  { class Project; }
+namespace foundation    { class IAbortSwitch; }
+namespace foundation    { class JobQueue; }
+namespace renderer      { class BaseGroup; }
+namespace renderer      { class Entity; }
+namespace renderer      { class Project; }
 
 namespace renderer
 {
@@ -44,16 +53,38 @@ namespace renderer
 // Keep tracks of which entity we have called on_frame_begin() on,
 // and allows to call on_frame_end() on all those entities, in reverse order.
 //
+// When constructed with a job queue, entities that don't depend on each other
+// (typically the entities of a same collection) are prepared in parallel.
+// The time spent in on_frame_begin() by each of these entities is recorded.
+//
 
 class APPLESEED_DLLSYMBOL OnFrameBeginRecorder
 {
   public:
-    OnFrameBeginRecorder();
+    typedef std::vector<Entity*> EntityVector;
+
+    // Constructor. The job queue is optional.
+    explicit OnFrameBeginRecorder(foundation::JobQueue* job_queue = 0);
+
+    // Destructor.
     ~OnFrameBeginRecorder();
 
+    // Thread-safe.
     void record(Entity* entity, const BaseGroup* parent);
+
+    // Call on_frame_begin() on a set of independent entities, in parallel
+    // if this recorder has a job queue. Returns true if all calls succeeded.
+    bool invoke_on_frame_begin(
+        const Project&              project,
+        const BaseGroup*            parent,
+        const EntityVector&         entities,
+        foundation::IAbortSwitch*   abort_switch);
+
     void on_frame_end(const Project& project);
 
+    // Return the total preparation time and the slowest entities to prepare.
+    foundation::StatisticsVector get_statistics(const size_t max_entity_count = 10) const;
+
   private:
     struct Impl;
     Impl* impl;
@@ -33,6 +33,7 @@
 // appleseed.renderer headers.
 #include "renderer/global/globaltypes.h"
 #include "renderer/modeling/environmentedf/environmentedf.h"
+#include "renderer/modeling/environmentedf/skytable.h"
 #include "renderer/modeling/environmentedf/sphericalcoordinates.h"
 #include "renderer/modeling/input/inputarray.h"
 #include "renderer/modeling/input/inputevaluator.h"
@@ -56,6 +57,8 @@
 // Standard headers.
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <memory>
 
 // Forward declarations.
 namespace foundation    { class IAbortSwitch; }
@@ -86,6 +89,10 @@ namespace
     // The smallest valid turbidity value.
     const float BaseTurbidity = 2.0f;
 
+    // Resolution of the table into which the sky is baked.
+    const size_t SkyTableWidth = 256;
+    const size_t SkyTableHeight = 128;
+
     class PreethamEnvironmentEDF
       : public EnvironmentEDF
     {
@@ -153,6 +160,15 @@ namespace
                 m_uniform_Y_zenith = compute_zenith_Y(static_cast<float>(m_uniform_values.m_turbidity), m_sun_theta);
             }
 
+            // Bake the sky into a table used to importance-sample it if it does not vary spatially.
+            m_sky_table.reset();
+            if (m_uniform_turbidity)
+            {
+                auto_ptr<SkyTable> sky_table(new SkyTable(SkyTableWidth, SkyTableHeight));
+                if (sky_table->bake(SkyModel(*this), static_cast<float>(m_uniform_values.m_horizon_shift), abort_switch))
+                    m_sky_table = sky_table;
+            }
+
             return true;
         }
 
@@ -164,17 +180,21 @@ namespace
             Spectrum&               value,
             float&                  probability) const APPLESEED_OVERRIDE
         {
-            const Vector3f local_outgoing = sample_hemisphere_cosine(s);
-            probability = local_outgoing.y * RcpPi<float>();
+            Vector3f local_outgoing;
+
+            if (m_sky_table.get())
+                m_sky_table->sample(s, local_outgoing, probability);
+            else
+            {
+                local_outgoing = sample_hemisphere_cosine(s);
+                probability = local_outgoing.y * RcpPi<float>();
+            }
+
+            lookup_sky_radiance(input_evaluator, local_outgoing, value);
 
             Transformd scratch;
             const Transformd& transform = m_transform_sequence.evaluate(0.0f, scratch);
             outgoing = transform.vector_to_parent(local_outgoing);
-
-            const Vector3f shifted_outgoing = shift(local_outgoing);
-            if (shifted_outgoing.y > 0.0f)
-                compute_sky_radiance(input_evaluator, shifted_outgoing, value);
-            else value.set(0.0f);
         }
 
         virtual void evaluate(
@@ -189,10 +209,7 @@ namespace
             const Transformd& transform = m_transform_sequence.evaluate(0.0f, scratch);
             const Vector3f local_outgoing = transform.vector_to_local(outgoing);
 
-            const Vector3f shifted_outgoing = shift(local_outgoing);
-            if (shifted_outgoing.y > 0.0f)
-                compute_sky_radiance(input_evaluator, shifted_outgoing, value);
-            else value.set(0.0f);
+            lookup_sky_radiance(input_evaluator, local_outgoing, value);
         }
 
         virtual void evaluate(
@@ -208,12 +225,11 @@ namespace
             const Transformd& transform = m_transform_sequence.evaluate(0.0f, scratch);
             const Vector3f local_outgoing = transform.vector_to_local(outgoing);
 
-            const Vector3f shifted_outgoing = shift(local_outgoing);
-            if (shifted_outgoing.y > 0.0f)
-                compute_sky_radiance(input_evaluator, shifted_outgoing, value);
-            else value.set(0.0f);
+            lookup_sky_radiance(input_evaluator, local_outgoing, value);
 
-            probability = local_outgoing.y > 0.0f ? local_outgoing.y * RcpPi<float>() : 0.0f;
+            probability =
+                m_sky_table.get() ? m_sky_table->evaluate_pdf(local_outgoing) :
+                local_outgoing.y > 0.0f ? local_outgoing.y * RcpPi<float>() : 0.0f;
         }
 
         virtual float evaluate_pdf(
@@ -224,6 +240,10 @@ namespace
 
             Transformd scratch;
             const Transformd& transform = m_transform_sequence.evaluate(0.0f, scratch);
+
+            if (m_sky_table.get())
+                return m_sky_table->evaluate_pdf(transform.vector_to_local(outgoing));
+
             const Transformd::MatrixType& parent_to_local = transform.get_parent_to_local();
             const float local_outgoing_y =
                 static_cast<float>(parent_to_local[ 4]) * outgoing.x +
@@ -263,6 +283,26 @@ namespace
         float                       m_uniform_y_zenith;
         float                       m_uniform_Y_zenith;
 
+        auto_ptr<SkyTable>          m_sky_table;
+
+        // Adapter between the sky table and this sky model.
+        class SkyModel
+        {
+          public:
+            explicit SkyModel(const PreethamEnvironmentEDF& edf)
+              : m_edf(edf)
+            {
+            }
+
+            void compute_radiance(const Vector3f& local_outgoing, Spectrum& value) const
+            {
+                m_edf.compute_sky_radiance(0, m_edf.shift(local_outgoing), value);
+            }
+
+          private:
+            const PreethamEnvironmentEDF& m_edf;
+        };
+
         // Compute the coefficients of the luminance distribution function.
         static void compute_Y_coefficients(
             const float             turbidity,
@@ -362,8 +402,9 @@ namespace
         }
 
         // Compute the sky radiance along a given direction.
+        // The input evaluator may only be null if turbidity is uniform.
         void compute_sky_radiance(
-            InputEvaluator&         input_evaluator,
+            InputEvaluator*         input_evaluator,
             const Vector3f&         outgoing,
             Spectrum&               value) const
         {
@@ -389,11 +430,12 @@ namespace
             else
             {
                 // Evaluate turbidity.
+                assert(input_evaluator);
                 float theta, phi;
                 float u, v;
                 unit_vector_to_angles(outgoing, theta, phi);
                 angles_to_unit_square(theta, phi, u, v);
-                float turbidity = static_cast<float>(input_evaluator.evaluate<InputValues>(m_inputs, Vector2f(u, v))->m_turbidity);
+                float turbidity = static_cast<float>(input_evaluator->evaluate<InputValues>(m_inputs, Vector2f(u, v))->m_turbidity);
 
                 // Apply turbidity multiplier and bias.
                 turbidity *= static_cast<float>(m_uniform_values.m_turbidity_multiplier);
@@ -452,6 +494,19 @@ namespace
                 * RcpPi<float>();                                   // convert irradiance to radiance
         }
 
+        // Compute the sky radiance along a given local direction, culling directions below the horizon.
+        void lookup_sky_radiance(
+            InputEvaluator&         input_evaluator,
+            const Vector3f&         local_outgoing,
+            Spectrum&               value) const
+        {
+            const Vector3f shifted_outgoing = shift(local_outgoing);
+
+            if (shifted_outgoing.y > 0.0f)
+                compute_sky_radiance(&input_evaluator, shifted_outgoing, value);
+            else value.set(0.0f);
+        }
+
         Vector3f shift(Vector3f v) const
         {
             v.y -= static_cast<float>(m_uniform_values.m_horizon_shift);
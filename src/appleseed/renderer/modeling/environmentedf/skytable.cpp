@@ -0,0 +1,189 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "skytable.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+using namespace foundation;
+using namespace std;
+
+namespace renderer
+{
+
+//
+// SkyTable class implementation.
+//
+
+class SkyTable::TexelSampler
+{
+  public:
+    TexelSampler(
+        const SkyTable&     table,
+        const float         horizon_y)
+      : m_table(table)
+      , m_horizon_y(horizon_y)
+      , m_total_importance(0.0f)
+    {
+    }
+
+    void sample(const size_t x, const size_t y, Payload& payload, float& importance)
+    {
+        // Skip texels that lie entirely below the horizon.
+        const float top_theta = Pi<float>() * y * m_table.m_rcp_height;
+        if (cos(top_theta) <= m_horizon_y)
+        {
+            importance = 0.0f;
+            return;
+        }
+
+        // Account for the solid angle of the texel so that the poles are not oversampled.
+        const float center_theta = Pi<float>() * (y + 0.5f) * m_table.m_rcp_height;
+        importance = m_table.m_texels[y * m_table.m_width + x] * sin(center_theta);
+
+        m_total_importance += importance;
+    }
+
+    float get_total_importance() const
+    {
+        return m_total_importance;
+    }
+
+  private:
+    const SkyTable&         m_table;
+    const float             m_horizon_y;
+    float                   m_total_importance;
+};
+
+SkyTable::SkyTable(
+    const size_t            width,
+    const size_t            height)
+  : m_width(width)
+  , m_height(height)
+  , m_rcp_width(1.0f / width)
+  , m_rcp_height(1.0f / height)
+  , m_probability_scale((width * height) / (2.0f * PiSquare<float>()))
+  , m_texels(width * height)
+  , m_importance_sampler(width, height)
+{
+    assert(width > 0);
+    assert(height > 0);
+}
+
+void SkyTable::sample(
+    const Vector2f&         s,
+    Vector3f&               local_outgoing,
+    float&                  probability) const
+{
+    // Sample the importance map. The position of the sample inside the chosen
+    // texel is what remains of s after the CDF inversions.
+    size_t x, y;
+    Vector2f offset;
+    float prob_xy;
+    m_importance_sampler.sample_with_offset(s, x, y, offset, prob_xy);
+
+    // Compute the emission direction.
+    float theta, phi;
+    unit_square_to_angles(
+        (x + offset[0]) * m_rcp_width,
+        (y + offset[1]) * m_rcp_height,
+        theta,
+        phi);
+    const float sin_theta = sin(theta);
+    local_outgoing = Vector3f::make_unit_vector(cos(theta), sin_theta, cos(phi), sin(phi));
+
+    // Compute the probability density of this direction.
+    probability = compute_probability(prob_xy, sin_theta);
+}
+
+float SkyTable::evaluate_pdf(const Vector3f& local_outgoing) const
+{
+    float theta, phi;
+    unit_vector_to_angles(local_outgoing, theta, phi);
+
+    float u, v;
+    angles_to_unit_square(theta, phi, u, v);
+
+    // Compute the probability density of this direction in the importance map.
+    const size_t x = min(truncate<size_t>(u * m_width), m_width - 1);
+    const size_t y = min(truncate<size_t>(v * m_height), m_height - 1);
+    const float prob_xy = m_importance_sampler.get_pdf(x, y);
+
+    // Compute the probability density of the emission direction.
+    return compute_probability(prob_xy, sin(theta));
+}
+
+Vector3f SkyTable::texel_center(
+    const size_t            x,
+    const size_t            y) const
+{
+    float theta, phi;
+    unit_square_to_angles(
+        (x + 0.5f) * m_rcp_width,
+        (y + 0.5f) * m_rcp_height,
+        theta,
+        phi);
+
+    return
+        Vector3f::make_unit_vector(
+            cos(theta),
+            sin(theta),
+            cos(phi),
+            sin(phi));
+}
+
+float SkyTable::compute_probability(
+    const float             prob_xy,
+    const float             sin_theta) const
+{
+    // Directions are uniformly distributed in latitude-longitude space inside a texel,
+    // so the density with respect to solid angle is inversely proportional to sin(theta).
+    return prob_xy > 0.0f && sin_theta > 0.0f
+        ? prob_xy * m_probability_scale / sin_theta
+        : 0.0f;
+}
+
+bool SkyTable::build_cdfs(
+    const float             horizon_y,
+    IAbortSwitch*           abort_switch)
+{
+    TexelSampler sampler(*this, horizon_y);
+    m_importance_sampler.rebuild(sampler, abort_switch);
+
+    return
+        !is_aborted(abort_switch) &&
+        sampler.get_total_importance() > 0.0f;
+}
+
+}       // namespace renderer
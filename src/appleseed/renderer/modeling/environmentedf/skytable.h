@@ -0,0 +1,182 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_RENDERER_MODELING_ENVIRONMENTEDF_SKYTABLE_H
+#define APPLESEED_RENDERER_MODELING_ENVIRONMENTEDF_SKYTABLE_H
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/modeling/environmentedf/sphericalcoordinates.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/math/sampling/imageimportancesampler.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/job/abortswitch.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace renderer
+{
+
+//
+// A latitude-longitude table of the radiance of an analytic sky model, used to sample
+// emission directions roughly proportionally to the radiance of the sky. The table is
+// only used for sampling and probability densities: the radiance along a direction
+// must still be computed with the sky model itself.
+//
+// The table is expressed in the local space of the environment EDF. Texels that lie
+// entirely below the horizon are never sampled, but directions sampled in texels
+// straddling the horizon may be below it.
+//
+
+class SkyTable
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    SkyTable(
+        const size_t                    width,
+        const size_t                    height);
+
+    // Evaluate the sky model at the center of every texel and build the CDFs.
+    // The sky model must provide the following method:
+    //
+    //   void compute_radiance(
+    //       const foundation::Vector3f&    local_outgoing,   // above the horizon
+    //       Spectrum&                      value) const;
+    //
+    // Return false if the operation was aborted or if the sky is black.
+    template <typename SkyModel>
+    bool bake(
+        const SkyModel&                 model,
+        const float                     horizon_y,          // y coordinate of the horizon in local space
+        foundation::IAbortSwitch*       abort_switch = 0);
+
+    // Sample the table and return a local emission direction and its probability density.
+    // The direction is distributed uniformly in latitude-longitude space inside the chosen
+    // texel; the probability density may be zero at the poles.
+    void sample(
+        const foundation::Vector2f&     s,
+        foundation::Vector3f&           local_outgoing,
+        float&                          probability) const;
+
+    // Return the probability density of a given local emission direction.
+    float evaluate_pdf(
+        const foundation::Vector3f&     local_outgoing) const;
+
+  private:
+    struct Payload {};
+
+    typedef foundation::ImageImportanceSampler<Payload, float> ImageImportanceSamplerType;
+
+    class TexelSampler;
+
+    const size_t                        m_width;
+    const size_t                        m_height;
+    const float                         m_rcp_width;
+    const float                         m_rcp_height;
+    const float                         m_probability_scale;
+    std::vector<float>                  m_texels;       // average radiance of the sky model at texel centers
+    ImageImportanceSamplerType          m_importance_sampler;
+
+    // Return the direction through the center of a given texel.
+    foundation::Vector3f texel_center(
+        const size_t                    x,
+        const size_t                    y) const;
+
+    // Return the probability density of a direction at a given polar angle in a texel
+    // whose probability in the importance map is prob_xy.
+    float compute_probability(
+        const float                     prob_xy,
+        const float                     sin_theta) const;
+
+    // Build the CDFs from the baked texels; return false if the sky is black.
+    bool build_cdfs(
+        const float                     horizon_y,
+        foundation::IAbortSwitch*       abort_switch);
+};
+
+
+//
+// SkyTable class implementation.
+//
+
+template <typename SkyModel>
+bool SkyTable::bake(
+    const SkyModel&                     model,
+    const float                         horizon_y,
+    foundation::IAbortSwitch*           abort_switch)
+{
+    // The center of texels straddling the horizon may lie below it. Evaluate the
+    // sky model just above the horizon for these texels so that they get sampled.
+    const float lifted_y = std::min(horizon_y + 1.0e-3f, 1.0f);
+    const float lifted_r = std::sqrt(1.0f - lifted_y * lifted_y);
+
+    for (size_t y = 0; y < m_height; ++y)
+    {
+        if (foundation::is_aborted(abort_switch))
+            return false;
+
+        for (size_t x = 0; x < m_width; ++x)
+        {
+            foundation::Vector3f d = texel_center(x, y);
+            float& texel = m_texels[y * m_width + x];
+
+            if (d.y <= horizon_y)
+            {
+                const float r = std::sqrt(d.x * d.x + d.z * d.z);
+                if (r == 0.0f || horizon_y >= 1.0f)
+                {
+                    texel = 0.0f;
+                    continue;
+                }
+
+                d.x *= lifted_r / r;
+                d.y = lifted_y;
+                d.z *= lifted_r / r;
+            }
+
+            Spectrum value;
+            model.compute_radiance(d, value);
+            texel = std::max(foundation::average_value(value), 0.0f);
+        }
+    }
+
+    return build_cdfs(horizon_y, abort_switch);
+}
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_MODELING_ENVIRONMENTEDF_SKYTABLE_H
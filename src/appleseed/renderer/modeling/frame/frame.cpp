@@ -40,6 +40,7 @@
 #include "foundation/core/exceptions/exceptionioerror.h"
 #include "foundation/core/exceptions/exceptionunsupportedfileformat.h"
 #include "foundation/image/color.h"
+#include "foundation/image/colorspace.h"
 #include "foundation/image/exceptionunsupportedimageformat.h"
 #include "foundation/image/exrimagefilewriter.h"
 #include "foundation/image/genericimagefilewriter.h"
@@ -64,6 +65,7 @@
 #include "boost/filesystem/path.hpp"
 
 // Standard headers.
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <string>
@@ -264,56 +266,75 @@ namespace
     {
         assert(tile.get_channel_count() == 4);
 
-        const size_t pixel_count = tile.get_pixel_count();
-
-        for (size_t i = 0; i < pixel_count; ++i)
-        {
-            // Load the pixel color.
+        // Pixels are converted to floating point, transformed and converted back in batches.
+        const size_t BatchSize = 256;
 #ifdef APPLESEED_USE_SSE
-            APPLESEED_SIMD4_ALIGN Color4f color;
+        APPLESEED_SIMD4_ALIGN Color4f batch[BatchSize];
 #else
-            Color4f color;
+        Color4f batch[BatchSize];
 #endif
-            tile.get_pixel(i, color);
+
+        const PixelFormat pixel_format = tile.get_pixel_format();
+        const size_t pixel_size = Pixel::size(pixel_format) * 4;
+        const size_t pixel_count = tile.get_pixel_count();
+
+        for (size_t begin = 0; begin < pixel_count; begin += BatchSize)
+        {
+            const size_t count = min(BatchSize, pixel_count - begin);
+            uint8* tile_pixels = tile.pixel(begin);
+            float* batch_values = &batch[0][0];
+
+            // Load the pixel colors.
+            Pixel::convert_from_format(
+                pixel_format,
+                tile_pixels,
+                tile_pixels + count * pixel_size,
+                1,
+                batch_values,
+                1);
 
             // Apply color space conversion.
             switch (ColorSpace)
             {
               case ColorSpaceSRGB:
-#ifdef APPLESEED_USE_SSE
-                {
-                    const float old_alpha = color[3];
-                    _mm_store_ps(&color[0], fast_linear_rgb_to_srgb(_mm_load_ps(&color[0])));
-                    color[3] = old_alpha;
-                }
-#else
-                color.rgb() = fast_linear_rgb_to_srgb(color.rgb());
-#endif
+                fast_linear_rgb_to_srgb(batch, count);
                 break;
 
               case ColorSpaceCIEXYZ:
-                color.rgb() = linear_rgb_to_ciexyz(color.rgb());
+                for (size_t i = 0; i < count; ++i)
+                    batch[i].rgb() = linear_rgb_to_ciexyz(batch[i].rgb());
                 break;
 
               default:
                 break;
             }
 
-            // Apply clamping.
-            // todo: mark clamped pixels in the diagnostic map.
-            if (Clamp)
-                color = saturate(color);
-
-            // Apply gamma correction.
-            if (GammaCorrect)
+            for (size_t i = 0; i < count; ++i)
             {
-                const float old_alpha = color[3];
-                fast_pow(&color[0], rcp_target_gamma);
-                color[3] = old_alpha;
+                Color4f& color = batch[i];
+
+                // Apply clamping.
+                // todo: mark clamped pixels in the diagnostic map.
+                if (Clamp)
+                    color = saturate(color);
+
+                // Apply gamma correction.
+                if (GammaCorrect)
+                {
+                    const float old_alpha = color[3];
+                    fast_pow(&color[0], rcp_target_gamma);
+                    color[3] = old_alpha;
+                }
             }
 
-            // Store the pixel color.
-            tile.set_pixel(i, color);
+            // Store the pixel colors.
+            Pixel::convert_to_format(
+                batch_values,
+                batch_values + count * 4,
+                1,
+                pixel_format,
+                tile_pixels,
+                1);
         }
     }
 
@@ -0,0 +1,234 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_RENDERER_MODELING_INPUT_INPUTCACHE_H
+#define APPLESEED_RENDERER_MODELING_INPUT_INPUTCACHE_H
+
+// appleseed.renderer headers.
+#include "renderer/modeling/input/inputarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/math/hash.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+#include "foundation/platform/compiler.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/cache.h"
+#include "foundation/utility/statistics.h"
+
+// Standard headers.
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+// Forward declarations.
+namespace renderer  { class TextureCache; }
+
+namespace renderer
+{
+
+//
+// A small, per-thread cache of evaluated input values.
+//
+// Input values are keyed by input array and by the cell of a regular grid in texture
+// space that the texture coordinates fall into. Values are evaluated at the first
+// texture coordinates that hit a given cell, then reused for all subsequent lookups
+// in that cell: the error is therefore bounded by the size of a grid cell.
+//
+
+class InputCache
+  : public foundation::NonCopyable
+{
+  public:
+    // Input arrays whose values are larger than this are never cached.
+    enum { MaxDataSize = 256 };     // bytes
+
+    // Constructor.
+    explicit InputCache(const size_t uv_resolution);
+
+    // Evaluate an input array at given texture coordinates, reusing cached values if possible.
+    void evaluate(
+        const InputArray&           inputs,
+        TextureCache&               texture_cache,
+        const foundation::Vector2f& uv,
+        void*                       values,
+        const size_t                offset = 0);
+
+    // Retrieve performance statistics.
+    foundation::Statistics get_statistics() const;
+
+  private:
+    struct Key
+    {
+        const InputArray*           m_inputs;
+        foundation::uint32          m_cell_u;
+        foundation::uint32          m_cell_v;
+
+        bool operator==(const Key& rhs) const;
+        bool operator!=(const Key& rhs) const;
+    };
+
+    struct KeyHasher
+      : public foundation::NonCopyable
+    {
+        // Hash a key into an integer.
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Values
+    {
+        APPLESEED_SIMD4_ALIGN foundation::uint8 m_data[MaxDataSize];
+        size_t                                  m_size;         // 0 if the values could not be cached
+    };
+
+    class ValuesSwapper
+      : public foundation::NonCopyable
+    {
+      public:
+        TextureCache*               m_texture_cache;
+        foundation::Vector2f        m_uv;
+
+        // Load a cache line.
+        void load(const Key& key, Values& values);
+
+        // Unload a cache line.
+        void unload(const Key& key, Values& values);
+    };
+
+    typedef foundation::SACache<
+        Key,
+        KeyHasher,
+        Values,
+        ValuesSwapper,
+        256,                // number of cache lines
+        2                   // number of ways
+    > ValuesCache;
+
+    const float                     m_uv_resolution;
+    KeyHasher                       m_key_hasher;
+    ValuesSwapper                   m_values_swapper;
+    ValuesCache                     m_values_cache;
+
+    static Key invalid_key();
+};
+
+
+//
+// InputCache class implementation.
+//
+
+inline InputCache::InputCache(const size_t uv_resolution)
+  : m_uv_resolution(static_cast<float>(uv_resolution))
+  , m_values_cache(m_key_hasher, m_values_swapper, invalid_key())
+{
+    assert(uv_resolution > 0);
+}
+
+inline void InputCache::evaluate(
+    const InputArray&               inputs,
+    TextureCache&                   texture_cache,
+    const foundation::Vector2f&     uv,
+    void*                           values,
+    const size_t                    offset)
+{
+    Key key;
+    key.m_inputs = &inputs;
+    key.m_cell_u = static_cast<foundation::uint32>(foundation::truncate<foundation::int32>(std::floor(uv[0] * m_uv_resolution)));
+    key.m_cell_v = static_cast<foundation::uint32>(foundation::truncate<foundation::int32>(std::floor(uv[1] * m_uv_resolution)));
+
+    m_values_swapper.m_texture_cache = &texture_cache;
+    m_values_swapper.m_uv = uv;
+
+    const Values& cached_values = m_values_cache.get(key);
+
+    if (cached_values.m_size > 0)
+    {
+        std::memcpy(
+            static_cast<foundation::uint8*>(values) + offset,
+            cached_values.m_data,
+            cached_values.m_size);
+    }
+    else inputs.evaluate(texture_cache, uv, values, offset);
+}
+
+inline foundation::Statistics InputCache::get_statistics() const
+{
+    return foundation::make_single_stage_cache_stats(m_values_cache);
+}
+
+inline InputCache::Key InputCache::invalid_key()
+{
+    Key key;
+    key.m_inputs = 0;
+    key.m_cell_u = 0;
+    key.m_cell_v = 0;
+    return key;
+}
+
+inline bool InputCache::Key::operator==(const Key& rhs) const
+{
+    return
+        m_inputs == rhs.m_inputs &&
+        m_cell_u == rhs.m_cell_u &&
+        m_cell_v == rhs.m_cell_v;
+}
+
+inline bool InputCache::Key::operator!=(const Key& rhs) const
+{
+    return !operator==(rhs);
+}
+
+inline size_t InputCache::KeyHasher::operator()(const Key& key) const
+{
+    return
+        static_cast<size_t>(
+            foundation::mix_uint64(
+                reinterpret_cast<uintptr_t>(key.m_inputs),
+                key.m_cell_u,
+                key.m_cell_v));
+}
+
+inline void InputCache::ValuesSwapper::load(const Key& key, Values& values)
+{
+    values.m_size = key.m_inputs->compute_data_size();
+
+    if (values.m_size <= MaxDataSize)
+        key.m_inputs->evaluate(*m_texture_cache, m_uv, values.m_data);
+    else values.m_size = 0;
+}
+
+inline void InputCache::ValuesSwapper::unload(const Key& key, Values& values)
+{
+}
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_MODELING_INPUT_INPUTCACHE_H
@@ -32,6 +32,7 @@
 
 // appleseed.renderer headers.
 #include "renderer/modeling/input/inputarray.h"
+#include "renderer/modeling/input/inputcache.h"
 
 // appleseed.foundation headers.
 #include "foundation/math/vector.h"
@@ -54,8 +55,10 @@ namespace renderer
 class InputEvaluator
 {
   public:
-    // Constructor.
-    explicit InputEvaluator(TextureCache& texture_cache);
+    // Constructor. If an input cache is provided, input values may be reused from nearby evaluations.
+    explicit InputEvaluator(
+        TextureCache&               texture_cache,
+        InputCache*                 input_cache = 0);
 
     // Evaluate a set of inputs, and return the values as an opaque block of memory.
     const void* evaluate(
@@ -75,8 +78,10 @@ class InputEvaluator
     enum { DataSize = 32 * 1024 };  // bytes
 
   private:
-    APPLESEED_SIMD4_ALIGN foundation::uint8 m_data[DataSize];
+    // Aligned on a cache line since composite OSL closures are stored there.
+    APPLESEED_ALIGN(64) foundation::uint8   m_data[DataSize];
     TextureCache&                           m_texture_cache;
+    InputCache*                             m_input_cache;
 };
 
 
@@ -84,8 +89,11 @@ class InputEvaluator
 // InputEvaluator class implementation.
 //
 
-inline InputEvaluator::InputEvaluator(TextureCache& texture_cache)
+inline InputEvaluator::InputEvaluator(
+    TextureCache&                   texture_cache,
+    InputCache*                     input_cache)
   : m_texture_cache(texture_cache)
+  , m_input_cache(input_cache)
 {
 }
 
@@ -94,7 +102,10 @@ inline const void* InputEvaluator::evaluate(
     const foundation::Vector2f&     uv,
     const size_t                    offset)
 {
-    inputs.evaluate(m_texture_cache, uv, m_data, offset);
+    if (m_input_cache)
+        m_input_cache->evaluate(inputs, m_texture_cache, uv, m_data, offset);
+    else inputs.evaluate(m_texture_cache, uv, m_data, offset);
+
     return m_data + offset;
 }
 
@@ -104,8 +115,7 @@ inline const T* InputEvaluator::evaluate(
     const foundation::Vector2f&     uv,
     const size_t                    offset)
 {
-    inputs.evaluate(m_texture_cache, uv, m_data, offset);
-    return reinterpret_cast<const T*>(m_data + offset);
+    return static_cast<const T*>(evaluate(inputs, uv, offset));
 }
 
 inline const foundation::uint8* InputEvaluator::data() const
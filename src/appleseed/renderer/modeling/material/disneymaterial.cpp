@@ -82,6 +82,8 @@ namespace
           , m_is_vector(is_vector)
           , m_is_constant(false)
           , m_texture_is_srgb(true)
+          , m_texture_handle(0)
+          , m_texture_perthread(0)
         {
         }
 
@@ -94,6 +96,8 @@ namespace
           , m_texture_filename(other.m_texture_filename)
           , m_texture_options(other.m_texture_options)
           , m_texture_is_srgb(other.m_texture_is_srgb)
+          , m_texture_handle(0)
+          , m_texture_perthread(0)
         {
         }
 
@@ -173,9 +177,18 @@ namespace
             {
                 const Vector2f& uv = shading_point.get_uv(0);
 
+                // Resolve the texture handle once instead of looking up the filename at every call.
+                // This is safe since layer parameters are only ever used by a single thread.
+                if (m_texture_handle == 0)
+                {
+                    m_texture_perthread = texture_system.get_perthread_info();
+                    m_texture_handle = texture_system.get_texture_handle(m_texture_filename, m_texture_perthread);
+                }
+
                 Color3f color;
                 if (!texture_system.texture(
-                        m_texture_filename,
+                        m_texture_handle,
+                        m_texture_perthread,
                         m_texture_options,
                         uv[0],
 #if OIIO_VERSION >= 10703
@@ -222,6 +235,8 @@ namespace
         OIIO::ustring               m_texture_filename;
         mutable OIIO::TextureOpt    m_texture_options;
         bool                        m_texture_is_srgb;
+        mutable OIIO::TextureSystem::TextureHandle* m_texture_handle;
+        mutable OIIO::TextureSystem::Perthread*     m_texture_perthread;
         mutable SeAppleseedExpr     m_expression;
     };
 }
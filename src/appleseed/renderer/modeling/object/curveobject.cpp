@@ -30,6 +30,7 @@
 #include "curveobject.h"
 
 // appleseed.foundation headers.
+#include "foundation/platform/types.h"
 #include "foundation/utility/api/specializedapiarrays.h"
 #include "foundation/utility/containers/dictionary.h"
 #include "foundation/utility/string.h"
@@ -54,12 +55,26 @@ struct CurveObject::Impl
     RegionKit           m_region_kit;
     Lazy<RegionKit>     m_lazy_region_kit;
     vector<Curve1Type>  m_curves1;
-    vector<Curve3Type>  m_curves3;
+    vector<GVector3>    m_curve3_points;            // control points of all degree-3 strands
+    vector<GScalar>     m_curve3_widths;            // per-control point widths
+    vector<uint32>      m_curve3_first_points;      // index of the first control point of each degree-3 curve
+    vector<uint32>      m_strand_first_points;      // index of the first control point of each strand, plus a sentinel
     vector<string>      m_material_slots;
 
     Impl()
       : m_lazy_region_kit(&m_region_kit)
     {
+        m_strand_first_points.push_back(0);
+    }
+
+    Curve3Type get_curve3(const size_t index) const
+    {
+        assert(index < m_curve3_first_points.size());
+
+        const size_t first = m_curve3_first_points[index];
+        assert(first + 3 < m_curve3_points.size());
+
+        return Curve3Type(&m_curve3_points[first], &m_curve3_widths[first]);
     }
 
     GAABB3 compute_bounds() const
@@ -68,13 +83,13 @@ struct CurveObject::Impl
         bbox.invalidate();
 
         const size_t curve1_count = m_curves1.size();
-        const size_t curve3_count = m_curves3.size();
+        const size_t curve3_count = m_curve3_first_points.size();
 
         for (size_t i = 0; i < curve1_count; ++i)
             bbox.insert(m_curves1[i].compute_bbox());
 
         for (size_t i = 0; i < curve3_count; ++i)
-            bbox.insert(m_curves3[i].compute_bbox());
+            bbox.insert(get_curve3(i).compute_bbox());
 
         return bbox;
     }
@@ -120,7 +135,7 @@ void CurveObject::reserve_curves1(const size_t count)
 
 void CurveObject::reserve_curves3(const size_t count)
 {
-    impl->m_curves3.reserve(count);
+    impl->m_curve3_first_points.reserve(count);
 }
 
 size_t CurveObject::push_curve1(const Curve1Type& curve)
@@ -132,9 +147,16 @@ size_t CurveObject::push_curve1(const Curve1Type& curve)
 
 size_t CurveObject::push_curve3(const Curve3Type& curve)
 {
-    const size_t index = impl->m_curves3.size();
-    impl->m_curves3.push_back(curve);
-    return index;
+    GVector3 points[4];
+    GScalar widths[4];
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        points[i] = curve.get_control_point(i);
+        widths[i] = curve.get_width(i);
+    }
+
+    return push_curve3_strand(points, widths, 4);
 }
 
 size_t CurveObject::get_curve1_count() const
@@ -144,7 +166,7 @@ size_t CurveObject::get_curve1_count() const
 
 size_t CurveObject::get_curve3_count() const
 {
-    return impl->m_curves3.size();
+    return impl->m_curve3_first_points.size();
 }
 
 const Curve1Type& CurveObject::get_curve1(const size_t index) const
@@ -153,10 +175,54 @@ const Curve1Type& CurveObject::get_curve1(const size_t index) const
     return impl->m_curves1[index];
 }
 
-const Curve3Type& CurveObject::get_curve3(const size_t index) const
+Curve3Type CurveObject::get_curve3(const size_t index) const
+{
+    return impl->get_curve3(index);
+}
+
+size_t CurveObject::push_curve3_strand(
+    const GVector3*     points,
+    const GScalar*      widths,
+    const size_t        point_count)
+{
+    assert(point_count >= 4);
+    assert((point_count - 1) % 3 == 0);
+
+    const size_t index = impl->m_curve3_first_points.size();
+    const size_t first_point = impl->m_curve3_points.size();
+
+    impl->m_curve3_points.insert(impl->m_curve3_points.end(), points, points + point_count);
+    impl->m_curve3_widths.insert(impl->m_curve3_widths.end(), widths, widths + point_count);
+
+    for (size_t i = 0; i + 1 < point_count; i += 3)
+        impl->m_curve3_first_points.push_back(static_cast<uint32>(first_point + i));
+
+    impl->m_strand_first_points.push_back(static_cast<uint32>(impl->m_curve3_points.size()));
+
+    return index;
+}
+
+size_t CurveObject::get_curve3_strand_count() const
+{
+    return impl->m_strand_first_points.size() - 1;
+}
+
+size_t CurveObject::get_curve3_strand_point_count(const size_t strand_index) const
+{
+    assert(strand_index + 1 < impl->m_strand_first_points.size());
+    return impl->m_strand_first_points[strand_index + 1] - impl->m_strand_first_points[strand_index];
+}
+
+const GVector3* CurveObject::get_curve3_strand_points(const size_t strand_index) const
+{
+    assert(strand_index + 1 < impl->m_strand_first_points.size());
+    return &impl->m_curve3_points[impl->m_strand_first_points[strand_index]];
+}
+
+const GScalar* CurveObject::get_curve3_strand_widths(const size_t strand_index) const
 {
-    assert(index < impl->m_curves3.size());
-    return impl->m_curves3[index];
+    assert(strand_index + 1 < impl->m_strand_first_points.size());
+    return &impl->m_curve3_widths[impl->m_strand_first_points[strand_index]];
 }
 
 size_t CurveObject::get_material_slot_count() const
@@ -75,6 +75,7 @@ class APPLESEED_DLLSYMBOL CurveObject
     virtual foundation::Lazy<RegionKit>& get_region_kit() APPLESEED_OVERRIDE;
 
     // Insert and access curves.
+    // Degree-3 curves are stored as strands and expanded on the fly by get_curve3().
     void reserve_curves1(const size_t count);
     void reserve_curves3(const size_t count);
     size_t push_curve1(const Curve1Type& curve);
@@ -82,7 +83,19 @@ class APPLESEED_DLLSYMBOL CurveObject
     size_t get_curve1_count() const;
     size_t get_curve3_count() const;
     const Curve1Type& get_curve1(const size_t index) const;
-    const Curve3Type& get_curve3(const size_t index) const;
+    Curve3Type get_curve3(const size_t index) const;
+
+    // Insert and access strands of degree-3 curves.
+    // A strand made of n curves has 3n+1 control points: consecutive curves share an end point.
+    // Return the index of the first curve of the strand.
+    size_t push_curve3_strand(
+        const GVector3*     points,
+        const GScalar*      widths,
+        const size_t        point_count);
+    size_t get_curve3_strand_count() const;
+    size_t get_curve3_strand_point_count(const size_t strand_index) const;
+    const GVector3* get_curve3_strand_points(const size_t strand_index) const;
+    const GScalar* get_curve3_strand_widths(const size_t strand_index) const;
 
     // Insert and access material slots.
     virtual size_t get_material_slot_count() const APPLESEED_OVERRIDE;
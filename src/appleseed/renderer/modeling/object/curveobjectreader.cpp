@@ -36,6 +36,7 @@
 #include "renderer/utility/paramarray.h"
 
 // appleseed.foundation headers.
+#include "foundation/core/exceptions/exceptionioerror.h"
 #include "foundation/math/aabb.h"
 #include "foundation/math/qmc.h"
 #include "foundation/math/rng/distribution.h"
@@ -44,6 +45,8 @@
 #include "foundation/math/scalar.h"
 #include "foundation/math/vector.h"
 #include "foundation/platform/defaulttimers.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/bufferedfile.h"
 #include "foundation/utility/searchpaths.h"
 #include "foundation/utility/stopwatch.h"
 #include "foundation/utility/string.h"
@@ -52,8 +55,10 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <cstring>
 #include <fstream>
 #include <string>
+#include <vector>
 
 using namespace foundation;
 using namespace std;
@@ -181,10 +186,22 @@ auto_release_ptr<CurveObject> CurveObjectReader::load_curve_file(
     const SearchPaths&      search_paths,
     const char*             name,
     const ParamArray&       params)
+{
+    const string filepath = search_paths.qualify(params.get<string>("filepath"));
+
+    return
+        ends_with(lower_case(filepath), ".binarycurves")
+            ? load_binary_curve_file(name, params, filepath)
+            : load_text_curve_file(name, params, filepath);
+}
+
+auto_release_ptr<CurveObject> CurveObjectReader::load_text_curve_file(
+    const char*             name,
+    const ParamArray&       params,
+    const string&           filepath)
 {
     auto_release_ptr<CurveObject> object = CurveObjectFactory::create(name, params);
 
-    const string filepath = search_paths.qualify(params.get<string>("filepath"));
     const size_t split_count = params.get_optional<size_t>("presplits", 0);
 
     ifstream input;
@@ -272,4 +289,147 @@ auto_release_ptr<CurveObject> CurveObjectReader::load_curve_file(
     return object;
 }
 
+namespace
+{
+    template <typename File>
+    inline void checked_read(File& file, void* outbuf, const size_t size)
+    {
+        if (size == 0)
+            return;
+
+        const size_t bytes_read = file.read(outbuf, size);
+
+        if (bytes_read < size)
+            throw ExceptionIOError();
+    }
+
+    template <typename File, typename T>
+    inline void checked_read(File& file, T& object)
+    {
+        checked_read(file, &object, sizeof(T));
+    }
+
+    void read_binary_curves(
+        ReaderAdapter&      reader,
+        CurveObject&        object,
+        const size_t        split_count,
+        size_t&             curve_count)
+    {
+        // Degree-1 curves.
+        uint32 curve1_count;
+        checked_read(reader, curve1_count);
+        object.reserve_curves1(curve1_count);
+
+        for (uint32 c = 0; c < curve1_count; ++c)
+        {
+            GVector3 points[2];
+            GScalar widths[2];
+            checked_read(reader, points, sizeof(points));
+            checked_read(reader, widths, sizeof(widths));
+
+            // We never presplit degree-1 curves.
+            object.push_curve1(Curve1Type(points, widths));
+        }
+
+        curve_count += curve1_count;
+
+        // Strands of degree-3 curves.
+        uint32 strand_count;
+        checked_read(reader, strand_count);
+
+        vector<GVector3> points;
+        vector<GScalar> widths;
+
+        for (uint32 s = 0; s < strand_count; ++s)
+        {
+            uint32 point_count;
+            checked_read(reader, point_count);
+
+            if (point_count < 4 || (point_count - 1) % 3 != 0)
+                throw ExceptionIOError("invalid number of control points in curve strand");
+
+            points.resize(point_count);
+            widths.resize(point_count);
+            checked_read(reader, &points[0], point_count * sizeof(GVector3));
+            checked_read(reader, &widths[0], point_count * sizeof(GScalar));
+
+            if (split_count > 0)
+            {
+                for (uint32 p = 0; p + 1 < point_count; p += 3)
+                {
+                    const Curve3Type curve(&points[p], &widths[p]);
+                    split_and_store(object, curve, split_count);
+                }
+            }
+            else object.push_curve3_strand(&points[0], &widths[0], point_count);
+
+            curve_count += (point_count - 1) / 3;
+        }
+    }
+}
+
+auto_release_ptr<CurveObject> CurveObjectReader::load_binary_curve_file(
+    const char*             name,
+    const ParamArray&       params,
+    const string&           filepath)
+{
+    auto_release_ptr<CurveObject> object = CurveObjectFactory::create(name, params);
+
+    const size_t split_count = params.get_optional<size_t>("presplits", 0);
+
+    BufferedFile file(
+        filepath.c_str(),
+        BufferedFile::BinaryType,
+        BufferedFile::ReadMode);
+
+    if (!file.is_open())
+    {
+        RENDERER_LOG_ERROR("failed to open curve file %s.", filepath.c_str());
+        return object;
+    }
+
+    Stopwatch<DefaultWallclockTimer> stopwatch;
+    stopwatch.start();
+
+    size_t curve_count = 0;
+
+    try
+    {
+        static const char ExpectedSig[12] = { 'B', 'I', 'N', 'A', 'R', 'Y', 'C', 'U', 'R', 'V', 'E', 'S' };
+
+        char signature[sizeof(ExpectedSig)];
+        checked_read(file, signature, sizeof(signature));
+
+        if (memcmp(signature, ExpectedSig, sizeof(ExpectedSig)))
+            throw ExceptionIOError("invalid binarycurves format signature");
+
+        uint16 version;
+        checked_read(file, version);
+
+        if (version != 1)
+            throw ExceptionIOError("unknown binarycurves format version");
+
+        LZ4CompressedReaderAdapter reader(file);
+        read_binary_curves(reader, object.ref(), split_count, curve_count);
+    }
+    catch (const ExceptionIOError& e)
+    {
+        RENDERER_LOG_ERROR(
+            "failed to load curve file %s: %s.",
+            filepath.c_str(),
+            e.what());
+        return object;
+    }
+
+    stopwatch.measure();
+
+    RENDERER_LOG_INFO(
+        "loaded curve file %s (%s curves) in %s.",
+        filepath.c_str(),
+        pretty_uint(curve_count).c_str(),
+        pretty_time(stopwatch.get_seconds()).c_str());
+
+    return object;
+}
+
 }   // namespace renderer
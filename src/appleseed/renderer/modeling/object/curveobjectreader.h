@@ -38,6 +38,9 @@
 // appleseed.main headers.
 #include "main/dllsymbol.h"
 
+// Standard headers.
+#include <string>
+
 // Forward declarations.
 namespace foundation    { class SearchPaths; }
 namespace renderer      { class ParamArray; }
@@ -53,6 +56,7 @@ class APPLESEED_DLLSYMBOL CurveObjectReader
 {
   public:
     // Read a curve object from disk. The filepath is defined in params.
+    // Files with the .binarycurves extension are read as binary curve files.
     static foundation::auto_release_ptr<CurveObject> read(
         const foundation::SearchPaths&  search_paths,
         const char*                     name,
@@ -71,6 +75,16 @@ class APPLESEED_DLLSYMBOL CurveObjectReader
         const foundation::SearchPaths&  search_paths,
         const char*                     name,
         const ParamArray&               params);
+
+    static foundation::auto_release_ptr<CurveObject> load_text_curve_file(
+        const char*                     name,
+        const ParamArray&               params,
+        const std::string&              filepath);
+
+    static foundation::auto_release_ptr<CurveObject> load_binary_curve_file(
+        const char*                     name,
+        const ParamArray&               params,
+        const std::string&              filepath);
 };
 
 }       // namespace renderer
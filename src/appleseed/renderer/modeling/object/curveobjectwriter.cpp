@@ -38,6 +38,8 @@
 #include "foundation/core/exceptions/exception.h"
 #include "foundation/core/exceptions/exceptionioerror.h"
 #include "foundation/platform/defaulttimers.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/bufferedfile.h"
 #include "foundation/utility/stopwatch.h"
 #include "foundation/utility/string.h"
 
@@ -59,7 +61,7 @@ namespace renderer
 namespace
 {
     template <typename CurveType>
-    void write_curve(ostream& output, CurveType& curve)
+    void write_curve(ostream& output, const CurveType& curve)
     {
         const size_t control_point_count = curve.get_control_point_count();
 
@@ -75,45 +77,149 @@ namespace
 
         output << endl;
     }
-}
 
-bool CurveObjectWriter::write(
-    const CurveObject&  object,
-    const char*         filepath)
-{
-    assert(filepath);
+    bool write_text_curve_file(
+        const CurveObject&  object,
+        const char*         filepath)
+    {
+        ofstream output;
+        output.open(filepath);
 
-    Stopwatch<DefaultWallclockTimer> stopwatch;
-    stopwatch.start();
+        if (!output.is_open())
+        {
+            RENDERER_LOG_ERROR("failed to create curve file %s.", filepath);
+            return false;
+        }
+
+        const size_t curve1_count = object.get_curve1_count();
+        const size_t curve3_count = object.get_curve3_count();
+
+        output << curve1_count << endl;
+        output << curve3_count << endl;
+
+        for (size_t i = 0; i < curve1_count; ++i)
+            write_curve(output, object.get_curve1(i));
+
+        for (size_t i = 0; i < curve3_count; ++i)
+            write_curve(output, object.get_curve3(i));
 
-    ofstream output;
-    output.open(filepath);
+        output.close();
 
-    if (!output.is_open())
+        if (output.bad())
+        {
+            RENDERER_LOG_ERROR("failed to write curve file %s: i/o error.", filepath);
+            return false;
+        }
+
+        return true;
+    }
+
+    template <typename File>
+    inline void checked_write(File& file, const void* inbuf, const size_t size)
     {
-        RENDERER_LOG_ERROR("failed to create curve file %s.", filepath);
-        return false;
+        const size_t bytes_written = file.write(inbuf, size);
+
+        if (bytes_written < size)
+            throw ExceptionIOError();
     }
 
-    const size_t curve1_count = object.get_curve1_count();
-    const size_t curve3_count = object.get_curve3_count();
+    template <typename File, typename T>
+    inline void checked_write(File& file, const T& object)
+    {
+        checked_write(file, &object, sizeof(T));
+    }
 
-    output << curve1_count << endl;
-    output << curve3_count << endl;
+    void write_binary_curves(
+        WriterAdapter&      writer,
+        const CurveObject&  object)
+    {
+        // Degree-1 curves.
+        const uint32 curve1_count = static_cast<uint32>(object.get_curve1_count());
+        checked_write(writer, curve1_count);
 
-    for (size_t i = 0; i < curve1_count; ++i)
-        write_curve(output, object.get_curve1(i));
+        for (uint32 i = 0; i < curve1_count; ++i)
+        {
+            const Curve1Type& curve = object.get_curve1(i);
 
-    for (size_t i = 0; i < curve3_count; ++i)
-        write_curve(output, object.get_curve3(i));
+            for (size_t p = 0; p < 2; ++p)
+                checked_write(writer, curve.get_control_point(p));
 
-    output.close();
+            for (size_t p = 0; p < 2; ++p)
+                checked_write(writer, curve.get_width(p));
+        }
+
+        // Strands of degree-3 curves.
+        const uint32 strand_count = static_cast<uint32>(object.get_curve3_strand_count());
+        checked_write(writer, strand_count);
+
+        for (uint32 i = 0; i < strand_count; ++i)
+        {
+            const uint32 point_count = static_cast<uint32>(object.get_curve3_strand_point_count(i));
+            checked_write(writer, point_count);
+            checked_write(writer, object.get_curve3_strand_points(i), point_count * sizeof(GVector3));
+            checked_write(writer, object.get_curve3_strand_widths(i), point_count * sizeof(GScalar));
+        }
+    }
 
-    if (output.bad())
+    bool write_binary_curve_file(
+        const CurveObject&  object,
+        const char*         filepath)
     {
-        RENDERER_LOG_ERROR("failed to write curve file %s: i/o error.", filepath);
-        return false;
+        BufferedFile file(
+            filepath,
+            BufferedFile::BinaryType,
+            BufferedFile::WriteMode);
+
+        if (!file.is_open())
+        {
+            RENDERER_LOG_ERROR("failed to create curve file %s.", filepath);
+            return false;
+        }
+
+        try
+        {
+            static const char Signature[12] = { 'B', 'I', 'N', 'A', 'R', 'Y', 'C', 'U', 'R', 'V', 'E', 'S' };
+            checked_write(file, Signature, sizeof(Signature));
+
+            const uint16 Version = 1;
+            checked_write(file, Version);
+
+            // The adapter flushes its last compressed block when it goes out of scope.
+            LZ4CompressedWriterAdapter writer(file, 256 * 1024);
+            write_binary_curves(writer, object);
+        }
+        catch (const ExceptionIOError&)
+        {
+            RENDERER_LOG_ERROR("failed to write curve file %s: i/o error.", filepath);
+            return false;
+        }
+
+        if (!file.close())
+        {
+            RENDERER_LOG_ERROR("failed to write curve file %s: i/o error.", filepath);
+            return false;
+        }
+
+        return true;
     }
+}
+
+bool CurveObjectWriter::write(
+    const CurveObject&  object,
+    const char*         filepath)
+{
+    assert(filepath);
+
+    Stopwatch<DefaultWallclockTimer> stopwatch;
+    stopwatch.start();
+
+    const bool success =
+        ends_with(lower_case(filepath), ".binarycurves")
+            ? write_binary_curve_file(object, filepath)
+            : write_text_curve_file(object, filepath);
+
+    if (!success)
+        return false;
 
     stopwatch.measure();
 
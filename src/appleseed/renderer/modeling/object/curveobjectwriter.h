@@ -53,6 +53,7 @@ class APPLESEED_DLLSYMBOL CurveObjectWriter
 {
   public:
     // Write a curve object to disk.
+    // Files with the .binarycurves extension are written as binary curve files.
     // Return true on success, false otherwise.
     static bool write(
         const CurveObject&  object,
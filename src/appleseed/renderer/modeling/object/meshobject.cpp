@@ -197,33 +197,36 @@ const GVector3& MeshObject::get_vertex(const size_t index) const
     return impl->m_tess.m_vertices[index];
 }
 
+void MeshObject::clear_vertices()
+{
+    impl->m_tess.m_vertices.clear();
+}
+
 void MeshObject::reserve_vertex_normals(const size_t count)
 {
-    impl->m_tess.m_vertex_normals.reserve(count);
+    impl->m_tess.reserve_vertex_normals(count);
 }
 
 size_t MeshObject::push_vertex_normal(const GVector3& normal)
 {
     assert(is_normalized(normal));
 
-    const size_t index = impl->m_tess.m_vertex_normals.size();
-    impl->m_tess.m_vertex_normals.push_back(normal);
-    return index;
+    return impl->m_tess.push_vertex_normal(normal);
 }
 
 size_t MeshObject::get_vertex_normal_count() const
 {
-    return impl->m_tess.m_vertex_normals.size();
+    return impl->m_tess.get_vertex_normal_count();
 }
 
-const GVector3& MeshObject::get_vertex_normal(const size_t index) const
+GVector3 MeshObject::get_vertex_normal(const size_t index) const
 {
-    return impl->m_tess.m_vertex_normals[index];
+    return impl->m_tess.get_vertex_normal(index);
 }
 
 void MeshObject::clear_vertex_normals()
 {
-    impl->m_tess.m_vertex_normals.clear();
+    impl->m_tess.clear_vertex_normals();
 }
 
 void MeshObject::reserve_vertex_tangents(const size_t count)
@@ -246,6 +249,11 @@ GVector3 MeshObject::get_vertex_tangent(const size_t index) const
     return impl->m_tess.get_vertex_tangent(index);
 }
 
+void MeshObject::clear_vertex_tangents()
+{
+    impl->m_tess.clear_vertex_tangents();
+}
+
 void MeshObject::reserve_tex_coords(const size_t count)
 {
     impl->m_tess.reserve_tex_coords(count);
@@ -266,6 +274,11 @@ GVector2 MeshObject::get_tex_coords(const size_t index) const
     return impl->m_tess.get_tex_coords(index);
 }
 
+void MeshObject::clear_tex_coords()
+{
+    impl->m_tess.clear_tex_coords();
+}
+
 void MeshObject::reserve_triangles(const size_t count)
 {
     impl->m_tess.m_primitives.reserve(count);
@@ -368,6 +381,11 @@ void MeshObject::clear_vertex_tangent_poses()
     impl->m_tess.clear_vertex_tangent_poses();
 }
 
+void MeshObject::compress_vertex_attributes()
+{
+    impl->m_tess.compress_vertex_attributes();
+}
+
 void MeshObject::reserve_material_slots(const size_t count)
 {
     impl->m_material_slots.reserve(count);
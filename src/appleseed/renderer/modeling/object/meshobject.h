@@ -106,12 +106,13 @@ class APPLESEED_DLLSYMBOL MeshObject
     size_t push_vertex(const GVector3& vertex);
     size_t get_vertex_count() const;
     const GVector3& get_vertex(const size_t index) const;
+    void clear_vertices();
 
     // Insert and access vertex normals.
     void reserve_vertex_normals(const size_t count);
     size_t push_vertex_normal(const GVector3& normal);      // the normal must be unit-length
     size_t get_vertex_normal_count() const;
-    const GVector3& get_vertex_normal(const size_t index) const;
+    GVector3 get_vertex_normal(const size_t index) const;
     void clear_vertex_normals();
 
     // Insert and access vertex tangents.
@@ -119,12 +120,14 @@ class APPLESEED_DLLSYMBOL MeshObject
     size_t push_vertex_tangent(const GVector3& tangent);    // the tangent must be unit-length
     size_t get_vertex_tangent_count() const;
     GVector3 get_vertex_tangent(const size_t index) const;
+    void clear_vertex_tangents();
 
     // Insert and access texture coordinates.
     void reserve_tex_coords(const size_t count);
     size_t push_tex_coords(const GVector2& tex_coords);
     size_t get_tex_coords_count() const;
     GVector2 get_tex_coords(const size_t index) const;
+    void clear_tex_coords();
 
     // Insert and access triangles.
     void reserve_triangles(const size_t count);
@@ -180,6 +183,9 @@ class APPLESEED_DLLSYMBOL MeshObject
     // Remove all vertex tangent poses.
     void clear_vertex_tangent_poses();
 
+    // Store vertex normals, vertex tangents and texture coordinates in compressed form.
+    void compress_vertex_attributes();
+
     // Insert and access material slots.
     void reserve_material_slots(const size_t count);
     size_t push_material_slot(const char* name);
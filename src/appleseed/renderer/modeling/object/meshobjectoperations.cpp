@@ -35,7 +35,13 @@
 #include "renderer/modeling/object/triangle.h"
 
 // appleseed.foundation headers.
+#include "foundation/math/hash.h"
 #include "foundation/math/vector.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/casts.h"
+
+// Boost headers.
+#include "boost/unordered/unordered_map.hpp"
 
 // Standard headers.
 #include <cassert>
@@ -222,4 +228,209 @@ void compute_smooth_vertex_tangents(MeshObject& object)
         compute_smooth_vertex_tangents_pose(object, i);
 }
 
+namespace
+{
+    //
+    // Attributes are compared using their binary representation such that
+    // two attributes are only merged if they are strictly interchangeable.
+    //
+
+    template <size_t N>
+    struct AttributeKey
+    {
+        uint32 m_bits[N];
+
+        bool operator==(const AttributeKey& rhs) const
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                if (m_bits[i] != rhs.m_bits[i])
+                    return false;
+            }
+
+            return true;
+        }
+    };
+
+    template <size_t N>
+    size_t hash_value(const AttributeKey<N>& key)
+    {
+        uint32 h = hash_uint32(key.m_bits[0]);
+
+        for (size_t i = 1; i < N; ++i)
+            h = mix_uint32(h, key.m_bits[i]);
+
+        return h;
+    }
+
+    template <size_t N, typename Vector>
+    void set_key_bits(AttributeKey<N>& key, const size_t offset, const Vector& v)
+    {
+        assert(offset + Vector::Dimension <= N);
+
+        for (size_t i = 0; i < Vector::Dimension; ++i)
+            key.m_bits[offset + i] = binary_cast<uint32>(v[i]);
+    }
+
+    // Assign to each key the index of its first occurrence among the unique keys.
+    // Return the number of unique keys; 'unique' receives the index of the first occurrence of each of them.
+    template <size_t N>
+    size_t find_unique_keys(
+        const vector<AttributeKey<N> >& keys,
+        vector<uint32>&                 remap,
+        vector<size_t>&                 unique)
+    {
+        typedef boost::unordered_map<AttributeKey<N>, uint32> KeyMap;
+
+        KeyMap key_map(keys.size());
+
+        remap.resize(keys.size());
+        unique.clear();
+
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            const typename KeyMap::value_type entry(keys[i], static_cast<uint32>(unique.size()));
+            const pair<typename KeyMap::iterator, bool> result = key_map.insert(entry);
+
+            if (result.second)
+                unique.push_back(i);
+
+            remap[i] = result.first->second;
+        }
+
+        return unique.size();
+    }
+
+    void remap_indices(uint32& i0, uint32& i1, uint32& i2, const vector<uint32>& remap)
+    {
+        if (i0 != Triangle::None) i0 = remap[i0];
+        if (i1 != Triangle::None) i1 = remap[i1];
+        if (i2 != Triangle::None) i2 = remap[i2];
+    }
+
+    void deduplicate_vertices(MeshObject& object)
+    {
+        // Vertex poses are indexed by vertex, leave animated meshes alone.
+        if (object.get_motion_segment_count() > 0)
+            return;
+
+        const size_t vertex_count = object.get_vertex_count();
+        const size_t tangent_count = object.get_vertex_tangent_count();
+        assert(tangent_count == 0 || tangent_count == vertex_count);
+
+        // Tangents are indexed by vertex, so they are part of the vertex key.
+        vector<AttributeKey<6> > keys(vertex_count);
+        for (size_t i = 0; i < vertex_count; ++i)
+        {
+            set_key_bits(keys[i], 0, object.get_vertex(i));
+            set_key_bits(keys[i], 3, tangent_count > 0 ? object.get_vertex_tangent(i) : GVector3(0.0));
+        }
+
+        vector<uint32> remap;
+        vector<size_t> unique;
+        if (find_unique_keys(keys, remap, unique) == vertex_count)
+            return;
+
+        vector<GVector3> vertices(unique.size());
+        vector<GVector3> tangents(tangent_count > 0 ? unique.size() : 0);
+        for (size_t i = 0; i < unique.size(); ++i)
+        {
+            vertices[i] = object.get_vertex(unique[i]);
+            if (tangent_count > 0)
+                tangents[i] = object.get_vertex_tangent(unique[i]);
+        }
+
+        object.clear_vertices();
+        object.reserve_vertices(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i)
+            object.push_vertex(vertices[i]);
+
+        if (tangent_count > 0)
+        {
+            object.clear_vertex_tangents();
+            object.reserve_vertex_tangents(tangents.size());
+            for (size_t i = 0; i < tangents.size(); ++i)
+                object.push_vertex_tangent(tangents[i]);
+        }
+
+        const size_t triangle_count = object.get_triangle_count();
+        for (size_t i = 0; i < triangle_count; ++i)
+        {
+            Triangle& triangle = object.get_triangle(i);
+            remap_indices(triangle.m_v0, triangle.m_v1, triangle.m_v2, remap);
+        }
+    }
+
+    void deduplicate_vertex_normals(MeshObject& object)
+    {
+        // Vertex normal poses are indexed by vertex normal, leave animated meshes alone.
+        if (object.get_motion_segment_count() > 0)
+            return;
+
+        const size_t normal_count = object.get_vertex_normal_count();
+
+        vector<AttributeKey<3> > keys(normal_count);
+        for (size_t i = 0; i < normal_count; ++i)
+            set_key_bits(keys[i], 0, object.get_vertex_normal(i));
+
+        vector<uint32> remap;
+        vector<size_t> unique;
+        if (find_unique_keys(keys, remap, unique) == normal_count)
+            return;
+
+        vector<GVector3> normals(unique.size());
+        for (size_t i = 0; i < unique.size(); ++i)
+            normals[i] = object.get_vertex_normal(unique[i]);
+
+        object.clear_vertex_normals();
+        object.reserve_vertex_normals(normals.size());
+        for (size_t i = 0; i < normals.size(); ++i)
+            object.push_vertex_normal(normals[i]);
+
+        const size_t triangle_count = object.get_triangle_count();
+        for (size_t i = 0; i < triangle_count; ++i)
+        {
+            Triangle& triangle = object.get_triangle(i);
+            remap_indices(triangle.m_n0, triangle.m_n1, triangle.m_n2, remap);
+        }
+    }
+
+    void deduplicate_tex_coords(MeshObject& object)
+    {
+        const size_t tex_coords_count = object.get_tex_coords_count();
+
+        vector<AttributeKey<2> > keys(tex_coords_count);
+        for (size_t i = 0; i < tex_coords_count; ++i)
+            set_key_bits(keys[i], 0, object.get_tex_coords(i));
+
+        vector<uint32> remap;
+        vector<size_t> unique;
+        if (find_unique_keys(keys, remap, unique) == tex_coords_count)
+            return;
+
+        vector<GVector2> tex_coords(unique.size());
+        for (size_t i = 0; i < unique.size(); ++i)
+            tex_coords[i] = object.get_tex_coords(unique[i]);
+
+        object.clear_tex_coords();
+        object.reserve_tex_coords(tex_coords.size());
+        for (size_t i = 0; i < tex_coords.size(); ++i)
+            object.push_tex_coords(tex_coords[i]);
+
+        const size_t triangle_count = object.get_triangle_count();
+        for (size_t i = 0; i < triangle_count; ++i)
+        {
+            Triangle& triangle = object.get_triangle(i);
+            remap_indices(triangle.m_a0, triangle.m_a1, triangle.m_a2, remap);
+        }
+    }
+}
+
+void deduplicate_vertex_attributes(MeshObject& object)
+{
+    deduplicate_vertices(object);
+    deduplicate_vertex_normals(object);
+    deduplicate_tex_coords(object);
+}
+
 }   // namespace renderer
@@ -47,6 +47,11 @@ APPLESEED_DLLSYMBOL void compute_smooth_vertex_normals(MeshObject& object);
 // The mesh object must have texture coordinates.
 APPLESEED_DLLSYMBOL void compute_smooth_vertex_tangents(MeshObject& object);
 
+// Merge bit-identical vertices, vertex normals and texture coordinates of a mesh object
+// and remap the triangles accordingly. Vertices and vertex normals are left untouched
+// if the mesh object has motion segments.
+APPLESEED_DLLSYMBOL void deduplicate_vertex_attributes(MeshObject& object);
+
 }       // namespace renderer
 
 #endif  // !APPLESEED_RENDERER_MODELING_OBJECT_MESHOBJECTOPERATIONS_H
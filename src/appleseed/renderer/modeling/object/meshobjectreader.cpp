@@ -66,6 +66,7 @@
 #include <cstddef>
 #include <exception>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -400,13 +401,12 @@ namespace
     };
 
     bool read_mesh_object(
+        GenericMeshFileReader&  reader,
         const char*             filename,
         const char*             base_object_name,
         const ParamArray&       params,
         MeshObjectArray&        objects)
     {
-        GenericMeshFileReader reader(filename);
-
         const string obj_parsing_mode = params.get_optional<string>("obj_parsing_mode", "fast");
 
         if (obj_parsing_mode == "fast")
@@ -495,6 +495,17 @@ namespace
         return true;
     }
 
+    bool read_mesh_object(
+        const char*             filename,
+        const char*             base_object_name,
+        const ParamArray&       params,
+        MeshObjectArray&        objects)
+    {
+        GenericMeshFileReader reader(filename);
+
+        return read_mesh_object(reader, filename, base_object_name, params, objects);
+    }
+
     void emit_mismatching_feature_count_error_message(
         const char*             object_path,
         const char*             filename,
@@ -594,12 +605,17 @@ namespace
     {
         double  m_key;
         string  m_filename;
+        bool    m_sample_at_key;    // sample the (animated) mesh file at time m_key
 
         MeshObjectKeyFrame() {}
 
-        MeshObjectKeyFrame(const double key, const string& filename)
+        MeshObjectKeyFrame(
+            const double    key,
+            const string&   filename,
+            const bool      sample_at_key = false)
           : m_key(key)
           , m_filename(filename)
+          , m_sample_at_key(sample_at_key)
         {
         }
 
@@ -709,29 +725,44 @@ namespace
         }
     }
 
-    bool read_key_framed_mesh_object(
-        const SearchPaths&      search_paths,
-        const StringDictionary& filenames,
-        const char*             base_object_name,
-        const ParamArray&       params,
-        MeshObjectArray&        objects)
+    bool read_key_frame(
+        const SearchPaths&                  search_paths,
+        const MeshObjectKeyFrame&           key_frame,
+        auto_ptr<GenericMeshFileReader>&    sampled_reader,
+        const char*                         base_object_name,
+        const ParamArray&                   params,
+        MeshObjectArray&                    objects)
     {
-        assert(filenames.size() >= 2);
+        const string filepath = search_paths.qualify(key_frame.m_filename);
 
-        vector<MeshObjectKeyFrame> key_frames;
-        key_frames.reserve(filenames.size());
+        if (!key_frame.m_sample_at_key)
+            return read_mesh_object(filepath.c_str(), base_object_name, params, objects);
 
-        for (const_each<StringDictionary> i = filenames; i; ++i)
-        {
-            const double key = from_string<double>(i->key());
-            const string filename = i->value<string>();
-            key_frames.push_back(MeshObjectKeyFrame(key, filename));
-        }
+        // All sampled key frames come from the same animated mesh file:
+        // share a single reader between them so that the file is only opened once.
+        if (sampled_reader.get() == 0)
+            sampled_reader.reset(new GenericMeshFileReader(filepath.c_str()));
 
-        sort(key_frames.begin(), key_frames.end());
+        sampled_reader->set_sample_time(key_frame.m_key);
+
+        return read_mesh_object(*sampled_reader, filepath.c_str(), base_object_name, params, objects);
+    }
+
+    bool read_key_frames(
+        const SearchPaths&                  search_paths,
+        const vector<MeshObjectKeyFrame>&   key_frames,
+        const char*                         base_object_name,
+        const ParamArray&                   params,
+        MeshObjectArray&                    objects)
+    {
+        assert(key_frames.size() >= 2);
+
+        auto_ptr<GenericMeshFileReader> sampled_reader;
 
-        if (!read_mesh_object(
-                search_paths.qualify(key_frames[0].m_filename).c_str(),
+        if (!read_key_frame(
+                search_paths,
+                key_frames[0],
+                sampled_reader,
                 base_object_name,
                 params,
                 objects))
@@ -752,8 +783,10 @@ namespace
 
             MeshObjectArray poses;
 
-            if (!read_mesh_object(
-                    search_paths.qualify(filename).c_str(),
+            if (!read_key_frame(
+                    search_paths,
+                    key_frames[i],
+                    sampled_reader,
                     base_object_name,
                     params,
                     poses))
@@ -780,6 +813,85 @@ namespace
         return true;
     }
 
+    bool read_key_framed_mesh_object(
+        const SearchPaths&      search_paths,
+        const StringDictionary& filenames,
+        const char*             base_object_name,
+        const ParamArray&       params,
+        MeshObjectArray&        objects)
+    {
+        assert(filenames.size() >= 2);
+
+        vector<MeshObjectKeyFrame> key_frames;
+        key_frames.reserve(filenames.size());
+
+        for (const_each<StringDictionary> i = filenames; i; ++i)
+        {
+            const double key = from_string<double>(i->key());
+            const string filename = i->value<string>();
+            key_frames.push_back(MeshObjectKeyFrame(key, filename));
+        }
+
+        sort(key_frames.begin(), key_frames.end());
+
+        return
+            read_key_frames(
+                search_paths,
+                key_frames,
+                base_object_name,
+                params,
+                objects);
+    }
+
+    bool is_animated_mesh_file(const string& filename)
+    {
+        return ends_with(lower_case(filename), ".abc");
+    }
+
+    bool read_sampled_mesh_object(
+        const SearchPaths&      search_paths,
+        const string&           filename,
+        const char*             base_object_name,
+        const ParamArray&       params,
+        MeshObjectArray&        objects)
+    {
+        const double shutter_open_time = params.get_optional<double>("shutter_open_time", 0.0);
+        const double shutter_close_time = params.get_optional<double>("shutter_close_time", shutter_open_time);
+        const size_t motion_segment_count = params.get_optional<size_t>("motion_segment_count", 1);
+
+        if (motion_segment_count == 0 || !is_pow2(motion_segment_count))
+        {
+            RENDERER_LOG_ERROR(
+                "while reading geometry for object \"%s\": the number of motion segments must be a power of two, "
+                "but " FMT_SIZE_T " motion segments were requested.",
+                base_object_name,
+                motion_segment_count);
+            return false;
+        }
+
+        // Sample the mesh file at regular intervals over the shutter interval.
+        vector<MeshObjectKeyFrame> key_frames;
+        key_frames.reserve(motion_segment_count + 1);
+
+        for (size_t i = 0; i <= motion_segment_count; ++i)
+        {
+            const double key =
+                lerp(
+                    shutter_open_time,
+                    shutter_close_time,
+                    static_cast<double>(i) / motion_segment_count);
+            key_frames.push_back(MeshObjectKeyFrame(key, filename, true));
+        }
+
+        return
+            read_key_frames(
+                search_paths,
+                key_frames,
+                base_object_name,
+                params,
+                objects);
+    }
+
     void compute_smooth_normals(MeshObject& object)
     {
         if (object.get_vertex_normal_count() > 0)
@@ -817,6 +929,25 @@ namespace
 
         compute_smooth_vertex_tangents(object);
     }
+
+    void deduplicate_attributes(MeshObject& object)
+    {
+        const size_t vertex_count = object.get_vertex_count();
+        const size_t normal_count = object.get_vertex_normal_count();
+        const size_t tex_coords_count = object.get_tex_coords_count();
+
+        deduplicate_vertex_attributes(object);
+
+        RENDERER_LOG_INFO(
+            "deduplicated vertex attributes of mesh object \"%s\": "
+            FMT_SIZE_T " -> " FMT_SIZE_T " vertices, "
+            FMT_SIZE_T " -> " FMT_SIZE_T " vertex normals, "
+            FMT_SIZE_T " -> " FMT_SIZE_T " texture coordinates.",
+            object.get_path().c_str(),
+            vertex_count, object.get_vertex_count(),
+            normal_count, object.get_vertex_normal_count(),
+            tex_coords_count, object.get_tex_coords_count());
+    }
 }
 
 bool MeshObjectReader::read(
@@ -854,13 +985,29 @@ bool MeshObjectReader::read(
             return false;
         }
 
-        // Single-pose object.
-        if (!read_mesh_object(
-                search_paths.qualify(params.strings().get<string>("filename")).c_str(),
-                base_object_name,
-                completed_params,
-                objects))
-            return false;
+        const string filename = params.strings().get<string>("filename");
+
+        if (is_animated_mesh_file(filename) && params.strings().exist("shutter_open_time"))
+        {
+            // Multi-pose (motion-blurred) object sampled from an animated mesh file.
+            if (!read_sampled_mesh_object(
+                    search_paths,
+                    filename,
+                    base_object_name,
+                    completed_params,
+                    objects))
+                return false;
+        }
+        else
+        {
+            // Single-pose object.
+            if (!read_mesh_object(
+                    search_paths.qualify(filename).c_str(),
+                    base_object_name,
+                    completed_params,
+                    objects))
+                return false;
+        }
     }
     else if (params.dictionaries().exist("filename"))
     {
@@ -946,6 +1093,33 @@ bool MeshObjectReader::read(
         }
     }
 
+    // Merge duplicate vertex attributes.
+    // This must happen after smooth normals and tangents have been computed
+    // since they are accumulated per vertex.
+    if (params.strings().exist("deduplicate_vertex_attributes"))
+    {
+        const RegExFilter filter(params.get("deduplicate_vertex_attributes"));
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            MeshObject& object = *objects[i];
+            if (filter.accepts(object.get_name()))
+                deduplicate_attributes(object);
+        }
+    }
+
+    // Compress vertex normals, vertex tangents and texture coordinates.
+    // This must happen last since the compression is lossy.
+    if (params.strings().exist("compress_vertex_attributes"))
+    {
+        const RegExFilter filter(params.get("compress_vertex_attributes"));
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            MeshObject& object = *objects[i];
+            if (filter.accepts(object.get_name()))
+                object.compress_vertex_attributes();
+        }
+    }
+
     return true;
 }
 
@@ -34,6 +34,7 @@
 #include "renderer/kernel/lighting/drt/drtlightingengine.h"
 #include "renderer/kernel/lighting/pt/ptlightingengine.h"
 #include "renderer/kernel/lighting/sppm/sppmlightingengine.h"
+#include "renderer/kernel/rendering/baserenderer.h"
 #include "renderer/kernel/rendering/final/uniformpixelrenderer.h"
 #include "renderer/kernel/rendering/generic/genericframerenderer.h"
 #include "renderer/kernel/rendering/progressive/progressiveframerenderer.h"
@@ -167,6 +168,10 @@ Dictionary Configuration::get_metadata()
         "texture_store",
         TextureStore::get_params_metadata());
 
+    metadata.dictionaries().insert(
+        "texture_system",
+        BaseRenderer::get_texture_system_params_metadata());
+
     metadata.dictionaries().insert(
         "uniform_pixel_renderer",
         UniformPixelRendererFactory::get_params_metadata());
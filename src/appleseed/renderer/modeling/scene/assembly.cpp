@@ -35,6 +35,7 @@
 #include "renderer/modeling/bssrdf/bssrdf.h"
 #include "renderer/modeling/color/colorentity.h"
 #include "renderer/modeling/edf/edf.h"
+#include "renderer/modeling/entity/onframebeginrecorder.h"
 #include "renderer/modeling/light/light.h"
 #include "renderer/modeling/material/material.h"
 #include "renderer/modeling/scene/assemblyinstance.h"
@@ -256,6 +257,24 @@ namespace
 
         return success;
     }
+
+    // Invoke on_frame_begin() on entities that don't depend on each other, possibly in parallel.
+    template <typename EntityCollection>
+    bool invoke_parallel_on_frame_begin(
+        const Project&          project,
+        const BaseGroup*        parent,
+        EntityCollection&       entities,
+        OnFrameBeginRecorder&   recorder,
+        IAbortSwitch*           abort_switch)
+    {
+        OnFrameBeginRecorder::EntityVector entity_vector;
+        entity_vector.reserve(entities.size());
+
+        for (each<EntityCollection> i = entities; i; ++i)
+            entity_vector.push_back(&*i);
+
+        return recorder.invoke_on_frame_begin(project, parent, entity_vector, abort_switch);
+    }
 }
 
 bool Assembly::on_frame_begin(
@@ -268,20 +287,20 @@ bool Assembly::on_frame_begin(
         return false;
 
     bool success = true;
-    success = success && invoke_on_frame_begin(project, this, colors(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, textures(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, texture_instances(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, shader_groups(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, bsdfs(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, bssrdfs(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, edfs(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, surface_shaders(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, materials(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, lights(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, objects(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, object_instances(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, colors(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, textures(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, texture_instances(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, shader_groups(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, bsdfs(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, bssrdfs(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, edfs(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, surface_shaders(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, materials(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, lights(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, objects(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, object_instances(), recorder, abort_switch);
     success = success && invoke_on_frame_begin(project, this, assemblies(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, assembly_instances(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, assembly_instances(), recorder, abort_switch);
     return success;
 }
 
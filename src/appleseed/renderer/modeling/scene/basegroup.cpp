@@ -39,10 +39,16 @@
 #include "renderer/modeling/texture/texture.h"
 
 // appleseed.foundation headers.
+#include "foundation/platform/compiler.h"
 #include "foundation/utility/foreach.h"
-#include "foundation/utility/job/abortswitch.h"
+#include "foundation/utility/job.h"
+
+// Standard headers.
+#include <cstddef>
+#include <vector>
 
 using namespace foundation;
+using namespace std;
 
 namespace renderer
 {
@@ -97,33 +103,113 @@ ShaderGroupContainer& BaseGroup::shader_groups() const
     return impl->m_shader_groups;
 }
 
+namespace
+{
+    // Create the OSL shader groups of a group and of its child assemblies, and collect them.
+    // OSL shader groups can't be created concurrently, so this is done serially.
+    bool create_osl_shader_groups(
+        BaseGroup&              group,
+        OSL::ShadingSystem&     shading_system,
+        IAbortSwitch*           abort_switch,
+        ShaderGroupCache*       cache,
+        vector<ShaderGroup*>&   shader_groups)
+    {
+        bool success = true;
+
+        for (each<AssemblyContainer> i = group.assemblies(); i; ++i)
+        {
+            if (is_aborted(abort_switch))
+                return true;
+
+            success = success && create_osl_shader_groups(
+                *i,
+                shading_system,
+                abort_switch,
+                cache,
+                shader_groups);
+        }
+
+        for (each<ShaderGroupContainer> i = group.shader_groups(); i; ++i)
+        {
+            if (is_aborted(abort_switch))
+                return true;
+
+            success = success && i->create_osl_shader_group(
+                shading_system,
+                abort_switch,
+                cache);
+
+            shader_groups.push_back(&*i);
+        }
+
+        return success;
+    }
+
+    class OptimizeShaderGroupJob
+      : public IJob
+    {
+      public:
+        OptimizeShaderGroupJob(
+            ShaderGroup&            shader_group,
+            OSL::ShadingSystem&     shading_system,
+            IAbortSwitch*           abort_switch)
+          : m_shader_group(shader_group)
+          , m_shading_system(shading_system)
+          , m_abort_switch(abort_switch)
+        {
+        }
+
+        virtual void execute(const size_t thread_index) APPLESEED_OVERRIDE
+        {
+            if (!is_aborted(m_abort_switch))
+                m_shader_group.optimize_osl_shader_group(m_shading_system);
+        }
+
+      private:
+        ShaderGroup&                m_shader_group;
+        OSL::ShadingSystem&         m_shading_system;
+        IAbortSwitch*               m_abort_switch;
+    };
+}
+
 bool BaseGroup::create_optimized_osl_shader_groups(
     OSL::ShadingSystem& shading_system,
-    IAbortSwitch*       abort_switch)
+    IAbortSwitch*       abort_switch,
+    ShaderGroupCache*   cache,
+    JobQueue*           job_queue)
 {
-    bool success = true;
+    vector<ShaderGroup*> shader_groups;
+    const bool success =
+        create_osl_shader_groups(
+            *this,
+            shading_system,
+            abort_switch,
+            cache,
+            shader_groups);
 
-    for (each<AssemblyContainer> i = assemblies(); i; ++i)
+    if (!success)
+        return false;
+
+    if (job_queue && shader_groups.size() > 1)
     {
-        if (is_aborted(abort_switch))
-            return true;
+        // Optimization and compilation are the expensive part, and can proceed in parallel.
+        for (const_each<vector<ShaderGroup*> > i = shader_groups; i; ++i)
+            job_queue->schedule(new OptimizeShaderGroupJob(**i, shading_system, abort_switch));
 
-        success = success && i->create_optimized_osl_shader_groups(
-            shading_system,
-            abort_switch);
+        job_queue->wait_until_completion();
     }
-
-    for (each<ShaderGroupContainer> i = shader_groups(); i; ++i)
+    else
     {
-        if (is_aborted(abort_switch))
-            return true;
+        for (const_each<vector<ShaderGroup*> > i = shader_groups; i; ++i)
+        {
+            if (is_aborted(abort_switch))
+                break;
 
-        success = success && i->create_optimized_osl_shader_group(
-            shading_system,
-            abort_switch);
+            (*i)->optimize_osl_shader_group(shading_system);
+        }
     }
 
-    return success;
+    return true;
 }
 
 void BaseGroup::release_optimized_osl_shader_groups()
@@ -44,9 +44,11 @@ END_OSL_INCLUDES
 
 // Forward declarations.
 namespace foundation    { class IAbortSwitch; }
+namespace foundation    { class JobQueue; }
 namespace foundation    { class StringArray; }
 namespace foundation    { class StringDictionary; }
 namespace renderer      { class Entity; }
+namespace renderer      { class ShaderGroupCache; }
 
 namespace renderer
 {
@@ -76,10 +78,14 @@ class APPLESEED_DLLSYMBOL BaseGroup
     // Access the OSL shader groups.
     ShaderGroupContainer& shader_groups() const;
 
-    // Create OSL shader groups and optimize them.
+    // Create OSL shader groups and optimize them. If a cache is provided, identical
+    // shader groups share the same OSL shader group. If a job queue is provided,
+    // shader groups are optimized and compiled in parallel.
     bool create_optimized_osl_shader_groups(
         OSL::ShadingSystem&         shading_system,
-        foundation::IAbortSwitch*   abort_switch = 0);
+        foundation::IAbortSwitch*   abort_switch = 0,
+        ShaderGroupCache*           cache = 0,
+        foundation::JobQueue*       job_queue = 0);
 
     // Release internal OSL shader groups.
     void release_optimized_osl_shader_groups();
@@ -32,6 +32,7 @@
 
 // appleseed.renderer headers.
 #include "renderer/modeling/color/colorentity.h"
+#include "renderer/modeling/entity/onframebeginrecorder.h"
 #include "renderer/modeling/environmentedf/environmentedf.h"
 #include "renderer/modeling/environmentshader/environmentshader.h"
 #include "renderer/modeling/frame/frame.h"
@@ -347,6 +348,24 @@ namespace
 
         return success;
     }
+
+    // Invoke on_frame_begin() on entities that don't depend on each other, possibly in parallel.
+    template <typename EntityCollection>
+    bool invoke_parallel_on_frame_begin(
+        const Project&          project,
+        const BaseGroup*        parent,
+        EntityCollection&       entities,
+        OnFrameBeginRecorder&   recorder,
+        IAbortSwitch*           abort_switch)
+    {
+        OnFrameBeginRecorder::EntityVector entity_vector;
+        entity_vector.reserve(entities.size());
+
+        for (each<EntityCollection> i = entities; i; ++i)
+            entity_vector.push_back(&*i);
+
+        return recorder.invoke_on_frame_begin(project, parent, entity_vector, abort_switch);
+    }
 }
 
 bool Scene::on_frame_begin(
@@ -369,20 +388,20 @@ bool Scene::on_frame_begin(
 
     bool success = true;
 
-    success = success && invoke_on_frame_begin(project, this, colors(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, textures(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, texture_instances(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, shader_groups(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, colors(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, textures(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, texture_instances(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, shader_groups(), recorder, abort_switch);
 
-    success = success && invoke_on_frame_begin(project, this, cameras(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, environment_edfs(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, environment_shaders(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, cameras(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, environment_edfs(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, environment_shaders(), recorder, abort_switch);
 
     if (!is_aborted(abort_switch) && impl->m_environment.get())
         success = success && impl->m_environment->on_frame_begin(project, this, recorder, abort_switch);
 
     success = success && invoke_on_frame_begin(project, this, assemblies(), recorder, abort_switch);
-    success = success && invoke_on_frame_begin(project, this, assembly_instances(), recorder, abort_switch);
+    success = success && invoke_parallel_on_frame_begin(project, this, assembly_instances(), recorder, abort_switch);
 
     return success;
 }
@@ -34,12 +34,14 @@
 #include "renderer/modeling/project/project.h"
 #include "renderer/modeling/shadergroup/shader.h"
 #include "renderer/modeling/shadergroup/shaderconnection.h"
+#include "renderer/modeling/shadergroup/shadergroupcache.h"
 #include "renderer/utility/paramarray.h"
 
 // appleseed.foundation headers.
 #include "foundation/utility/api/apistring.h"
 #include "foundation/utility/foreach.h"
 #include "foundation/utility/job/abortswitch.h"
+#include "foundation/utility/string.h"
 #include "foundation/utility/uid.h"
 
 // Boost headers
@@ -47,6 +49,7 @@
 
 // Standard headers.
 #include <exception>
+#include <string>
 #include <utility>
 
 using namespace foundation;
@@ -69,6 +72,48 @@ namespace
     const OIIO::ustring g_holdout_str("holdout");
     const OIIO::ustring g_debug_str("debug");
     const OIIO::ustring g_dPdtime_str("dPdtime");
+
+    // Return a string that identifies the shaders, parameter values and connections of a shader group.
+    // Instance values are locked (the lockgeom attribute of the shading system is set), so OSL
+    // optimizes two shader groups with the same signature into the same code.
+    string compute_signature(const ShaderGroup& shader_group)
+    {
+        string signature;
+
+        for (const_each<ShaderContainer> i = shader_group.shaders(); i; ++i)
+        {
+            signature += i->get_type();
+            signature += '\0';
+            signature += i->get_shader();
+            signature += '\0';
+            signature += i->get_layer();
+            signature += '\0';
+
+            for (const_each<ShaderParamContainer> j = i->shader_params(); j; ++j)
+            {
+                const string param_signature = j->get_signature();
+                signature += to_string(param_signature.size());
+                signature += ':';
+                signature += param_signature;
+            }
+
+            signature += '\n';
+        }
+
+        for (const_each<ShaderConnectionContainer> i = shader_group.shader_connections(); i; ++i)
+        {
+            signature += i->get_src_layer();
+            signature += '\0';
+            signature += i->get_src_param();
+            signature += '\0';
+            signature += i->get_dst_layer();
+            signature += '\0';
+            signature += i->get_dst_param();
+            signature += '\n';
+        }
+
+        return signature;
+    }
 }
 
 struct ShaderGroup::Impl
@@ -80,6 +125,7 @@ struct ShaderGroup::Impl
     ShaderConnectionContainer   m_connections;
     mutable OSL::ShaderGroupRef m_shader_group_ref;
     mutable SurfaceAreaMap      m_surface_areas;
+    bool                        m_needs_optimization;
 };
 
 ShaderGroup::ShaderGroup(const char* name)
@@ -110,6 +156,7 @@ void ShaderGroup::clear()
     impl->m_shaders.clear();
     impl->m_connections.clear();
     impl->m_shader_group_ref.reset();
+    impl->m_needs_optimization = false;
     m_flags = 0;
 }
 
@@ -156,10 +203,48 @@ void ShaderGroup::add_connection(
 
 bool ShaderGroup::create_optimized_osl_shader_group(
     OSL::ShadingSystem& shading_system,
-    IAbortSwitch*       abort_switch)
+    IAbortSwitch*       abort_switch,
+    ShaderGroupCache*   cache)
+{
+    if (!create_osl_shader_group(shading_system, abort_switch, cache))
+        return false;
+
+    optimize_osl_shader_group(shading_system);
+
+    return true;
+}
+
+bool ShaderGroup::create_osl_shader_group(
+    OSL::ShadingSystem& shading_system,
+    IAbortSwitch*       abort_switch,
+    ShaderGroupCache*   cache)
 {
+    const string signature = cache ? compute_signature(*this) : string();
+
     if (is_valid())
+    {
+        // Make the existing OSL shader group available to identical shader groups.
+        if (cache)
+            cache->insert(signature, impl->m_shader_group_ref);
+
         return true;
+    }
+
+    if (cache)
+    {
+        const OSL::ShaderGroupRef shader_group_ref = cache->get(signature);
+
+        if (shader_group_ref.get() != 0)
+        {
+            RENDERER_LOG_DEBUG(
+                "shader group \"%s\" is identical to a shader group already set up, sharing it.",
+                get_path().c_str());
+
+            impl->m_shader_group_ref = shader_group_ref;
+            impl->m_needs_optimization = true;
+            return true;
+        }
+    }
 
     RENDERER_LOG_DEBUG("setting up shader group \"%s\"...", get_path().c_str());
 
@@ -204,17 +289,10 @@ bool ShaderGroup::create_optimized_osl_shader_group(
         }
 
         impl->m_shader_group_ref = shader_group_ref;
+        impl->m_needs_optimization = true;
 
-        get_shadergroup_closures_info(shading_system);
-        report_has_closure("bsdf", HasBSDFs);
-        report_has_closure("emission", HasEmission);
-        report_has_closure("transparent", HasTransparency);
-        report_has_closure("subsurface", HasSubsurface);
-        report_has_closure("holdout", HasHoldout);
-        report_has_closure("debug", HasDebug);
-
-        get_shadergroup_globals_info(shading_system);
-        report_uses_global("dPdtime", UsesdPdTime);
+        if (cache)
+            cache->insert(signature, shader_group_ref);
 
         return true;
     }
@@ -225,9 +303,22 @@ bool ShaderGroup::create_optimized_osl_shader_group(
     }
 }
 
+void ShaderGroup::optimize_osl_shader_group(OSL::ShadingSystem& shading_system)
+{
+    if (!is_valid() || !impl->m_needs_optimization)
+        return;
+
+    // Shader groups shared with other shader groups are only optimized once by OSL.
+    shading_system.optimize_group(impl->m_shader_group_ref.get());
+    get_shadergroup_info(shading_system);
+
+    impl->m_needs_optimization = false;
+}
+
 void ShaderGroup::release_optimized_osl_shader_group()
 {
     impl->m_shader_group_ref.reset();
+    impl->m_needs_optimization = false;
 }
 
 const ShaderContainer& ShaderGroup::shaders() const
@@ -256,6 +347,20 @@ OSL::ShaderGroupRef& ShaderGroup::shader_group_ref() const
     return impl->m_shader_group_ref;
 }
 
+void ShaderGroup::get_shadergroup_info(OSL::ShadingSystem& shading_system)
+{
+    get_shadergroup_closures_info(shading_system);
+    report_has_closure("bsdf", HasBSDFs);
+    report_has_closure("emission", HasEmission);
+    report_has_closure("transparent", HasTransparency);
+    report_has_closure("subsurface", HasSubsurface);
+    report_has_closure("holdout", HasHoldout);
+    report_has_closure("debug", HasDebug);
+
+    get_shadergroup_globals_info(shading_system);
+    report_uses_global("dPdtime", UsesdPdTime);
+}
+
 void ShaderGroup::get_shadergroup_closures_info(OSL::ShadingSystem& shading_system)
 {
     // Assume the shader group has all closure types.
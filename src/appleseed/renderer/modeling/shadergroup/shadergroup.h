@@ -54,6 +54,7 @@ namespace renderer      { class LightSamper; }
 namespace renderer      { class ParamArray; }
 namespace renderer      { class ObjectInstance; }
 namespace renderer      { class Project; }
+namespace renderer      { class ShaderGroupCache; }
 
 namespace renderer
 {
@@ -89,10 +90,22 @@ class APPLESEED_DLLSYMBOL ShaderGroup
         const char*                 dst_layer,
         const char*                 dst_param);
 
-    // Create OSL shader group.
+    // Create OSL shader group. If a cache is provided, shader groups with identical
+    // shaders, parameter values and connections share the same OSL shader group.
     bool create_optimized_osl_shader_group(
         OSL::ShadingSystem&         shading_system,
-        foundation::IAbortSwitch*   abort_switch = 0);
+        foundation::IAbortSwitch*   abort_switch = 0,
+        ShaderGroupCache*           cache = 0);
+
+    // Create OSL shader group but defer its optimization to optimize_osl_shader_group().
+    bool create_osl_shader_group(
+        OSL::ShadingSystem&         shading_system,
+        foundation::IAbortSwitch*   abort_switch = 0,
+        ShaderGroupCache*           cache = 0);
+
+    // Optimize and compile the OSL shader group if it was not already done.
+    // Can be called concurrently on distinct shader groups.
+    void optimize_osl_shader_group(OSL::ShadingSystem& shading_system);
 
     // Release internal OSL shader group.
     void release_optimized_osl_shader_group();
@@ -170,6 +183,8 @@ class APPLESEED_DLLSYMBOL ShaderGroup
     // Destructor.
     ~ShaderGroup();
 
+    void get_shadergroup_info(OSL::ShadingSystem& shading_system);
+
     void get_shadergroup_closures_info(OSL::ShadingSystem& shading_system);
     void report_has_closure(const char* closure_name, const Flags flag) const;
 
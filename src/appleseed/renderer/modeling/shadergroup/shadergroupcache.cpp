@@ -0,0 +1,99 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "shadergroupcache.h"
+
+// Boost headers.
+#include "boost/unordered/unordered_map.hpp"
+
+using namespace std;
+
+namespace renderer
+{
+
+//
+// ShaderGroupCache class implementation.
+//
+
+struct ShaderGroupCache::Impl
+{
+    typedef boost::unordered_map<string, OSL::ShaderGroupRef> ShaderGroupMap;
+
+    ShaderGroupMap  m_shader_groups;
+    size_t          m_hit_count;
+};
+
+ShaderGroupCache::ShaderGroupCache()
+  : impl(new Impl())
+{
+    impl->m_hit_count = 0;
+}
+
+ShaderGroupCache::~ShaderGroupCache()
+{
+    delete impl;
+}
+
+void ShaderGroupCache::clear()
+{
+    impl->m_shader_groups.clear();
+    impl->m_hit_count = 0;
+}
+
+size_t ShaderGroupCache::size() const
+{
+    return impl->m_shader_groups.size();
+}
+
+size_t ShaderGroupCache::get_hit_count() const
+{
+    return impl->m_hit_count;
+}
+
+OSL::ShaderGroupRef ShaderGroupCache::get(const string& signature)
+{
+    const Impl::ShaderGroupMap::const_iterator i = impl->m_shader_groups.find(signature);
+
+    if (i == impl->m_shader_groups.end())
+        return OSL::ShaderGroupRef();
+
+    ++impl->m_hit_count;
+
+    return i->second;
+}
+
+void ShaderGroupCache::insert(
+    const string&               signature,
+    const OSL::ShaderGroupRef&  shader_group_ref)
+{
+    impl->m_shader_groups[signature] = shader_group_ref;
+}
+
+}   // namespace renderer
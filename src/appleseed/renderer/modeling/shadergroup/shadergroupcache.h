@@ -0,0 +1,91 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2010-2013 Francois Beaune, Jupiter Jazz Limited
+// Copyright (c) 2014-2016 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef APPLESEED_RENDERER_MODELING_SHADERGROUP_SHADERGROUPCACHE_H
+#define APPLESEED_RENDERER_MODELING_SHADERGROUP_SHADERGROUPCACHE_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+
+// OSL headers.
+#include "foundation/platform/oslheaderguards.h"
+BEGIN_OSL_INCLUDES
+#include "OSL/oslexec.h"
+END_OSL_INCLUDES
+
+// Standard headers.
+#include <cstddef>
+#include <string>
+
+namespace renderer
+{
+
+//
+// A cache of OSL shader groups keyed by the signature of the shader groups they were
+// built from, i.e. their shaders, parameter values and connections.
+//
+// Shader groups with identical signatures share a single OSL shader group, which is
+// then optimized and compiled only once for all of them.
+//
+
+class ShaderGroupCache
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    ShaderGroupCache();
+
+    // Destructor.
+    ~ShaderGroupCache();
+
+    // Remove all OSL shader groups from the cache.
+    void clear();
+
+    // Return the number of OSL shader groups in the cache.
+    size_t size() const;
+
+    // Return the number of successful lookups since the cache was last cleared.
+    size_t get_hit_count() const;
+
+    // Return the OSL shader group with a given signature, or an empty reference.
+    OSL::ShaderGroupRef get(const std::string& signature);
+
+    // Insert an OSL shader group into the cache.
+    void insert(
+        const std::string&          signature,
+        const OSL::ShaderGroupRef&  shader_group_ref);
+
+  private:
+    struct Impl;
+    Impl* impl;
+};
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_MODELING_SHADERGROUP_SHADERGROUPCACHE_H
@@ -155,6 +155,22 @@ string ShaderParam::get_value_as_string() const
     return ss.str();
 }
 
+string ShaderParam::get_signature() const
+{
+    string signature(get_name());
+    signature += '\0';
+    signature += impl->m_type_desc.c_str();
+    signature += '\0';
+
+    // Use the binary representation of the value: unlike get_value_as_string(),
+    // it distinguishes values that only differ beyond the printed precision.
+    if (impl->m_type_desc == OSL::TypeDesc::TypeString)
+        signature += impl->m_string_value;
+    else signature.append(static_cast<const char*>(get_value()), impl->m_type_desc.size());
+
+    return signature;
+}
+
 auto_release_ptr<ShaderParam> ShaderParam::create_int_param(
     const char*         name,
     const int           value)
@@ -94,6 +94,9 @@ class APPLESEED_DLLSYMBOL ShaderParam
     // TODO: STL classes cannot be used in DLL-exported classes.
     std::string get_value_as_string() const;
 
+    // Return a string that identifies the name, the type and the exact value of this param.
+    std::string get_signature() const;
+
   private:
     friend class Shader;
 
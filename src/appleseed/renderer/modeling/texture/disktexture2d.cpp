@@ -110,6 +110,11 @@ namespace
             return m_color_space;
         }
 
+        virtual const char* get_filepath() const APPLESEED_OVERRIDE
+        {
+            return m_filepath.c_str();
+        }
+
         virtual void collect_asset_paths(StringArray& paths) const APPLESEED_OVERRIDE
         {
             if (m_params.strings().exist("filename"))
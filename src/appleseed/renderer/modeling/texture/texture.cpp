@@ -57,4 +57,9 @@ Texture::Texture(
     set_name(name);
 }
 
+const char* Texture::get_filepath() const
+{
+    return 0;
+}
+
 }   // namespace renderer
@@ -73,6 +73,9 @@ class APPLESEED_DLLSYMBOL Texture
     // Return the color space of the texture.
     virtual foundation::ColorSpace get_color_space() const = 0;
 
+    // Return the path to the file backing this texture, or 0 if the texture is not backed by a file.
+    virtual const char* get_filepath() const;
+
     // Access canvas properties.
     virtual const foundation::CanvasProperties& properties() = 0;
 